@@ -171,6 +171,23 @@ AC_DEFUN([QL_CHECK_BOOST_TEST_STREAM],
     ])
 ])
 
+# QL_CHECK_BOOST_THREAD
+# ---------------------
+# Check whether the Boost.Thread headers are available
+AC_DEFUN([QL_CHECK_BOOST_THREAD],
+[AC_MSG_CHECKING([for Boost.Thread support])
+ AC_TRY_COMPILE(
+    [@%:@include <boost/thread/mutex.hpp>
+     @%:@include <boost/thread/recursive_mutex.hpp>
+     @%:@include <boost/thread/locks.hpp>],
+    [boost::recursive_mutex m;
+     boost::lock_guard<boost::recursive_mutex> lock(m);],
+    [AC_MSG_RESULT([yes])],
+    [AC_MSG_RESULT([no])
+     AC_MSG_ERROR([Boost.Thread is required by the requested features])
+    ])
+])
+
 # QL_CHECK_BOOST
 # ------------------------
 # Boost-related tests
@@ -84,6 +84,9 @@ namespace QuantLib {
 
         bool isCapped() const {return isCapped_;}
         bool isFloored() const {return isFloored_;}
+        boost::shared_ptr<FloatingRateCoupon> underlying() const {
+            return underlying_;
+        }
 
         void setPricer(
                    const boost::shared_ptr<FloatingRateCouponPricer>& pricer);
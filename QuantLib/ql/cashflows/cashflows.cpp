@@ -417,25 +417,54 @@ namespace QuantLib {
                               public Visitor<CashFlow>,
                               public Visitor<Coupon> {
           public:
-            BPSCalculator(const YieldTermStructure& discountCurve)
-            : discountCurve_(discountCurve), bps_(0.0), nonSensNPV_(0.0) {}
+            BPSCalculator()
+            : discount_(1.0), bps_(0.0), nonSensNPV_(0.0) {}
+            void add(CashFlow& cf, DiscountFactor discount) {
+                discount_ = discount;
+                cf.accept(*this);
+            }
             void visit(Coupon& c) {
                 Real bps = c.nominal() *
                            c.accrualPeriod() *
-                           discountCurve_.discount(c.date());
+                           discount_;
                 bps_ += bps;
             }
             void visit(CashFlow& cf) {
-                nonSensNPV_ += cf.amount() * 
-                               discountCurve_.discount(cf.date());
+                nonSensNPV_ += cf.amount() * discount_;
             }
             Real bps() const { return bps_; }
             Real nonSensNPV() const { return nonSensNPV_; }
           private:
-            const YieldTermStructure& discountCurve_;
+            DiscountFactor discount_;
             Real bps_, nonSensNPV_;
         };
 
+        // Collects the flows that have not occurred yet and retrieves
+        // their discount factors from the curve in a single call.
+        void aliveFlows(const Leg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        std::vector<CashFlow*>& flows,
+                        std::vector<DiscountFactor>& discounts) {
+            std::vector<Time> times;
+            times.reserve(leg.size());
+            flows.clear();
+            flows.reserve(leg.size());
+            for (Size i=0; i<leg.size(); ++i) {
+                if (!leg[i]->hasOccurred(settlementDate,
+                                         includeSettlementDateFlows)) {
+                    flows.push_back(leg[i].get());
+                    times.push_back(
+                             discountCurve.timeFromReference(leg[i]->date()));
+                }
+            }
+            discounts.resize(times.size());
+            if (!times.empty())
+                discountCurve.discounts(&times[0], &discounts[0],
+                                        times.size());
+        }
+
         const Spread basisPoint_ = 1.0e-4;
     } // anonymous namespace ends here
 
@@ -454,13 +483,14 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
+        std::vector<CashFlow*> flows;
+        std::vector<DiscountFactor> discounts;
+        aliveFlows(leg, discountCurve, includeSettlementDateFlows,
+                   settlementDate, flows, discounts);
+
         Real totalNPV = 0.0;
-        for (Size i=0; i<leg.size(); ++i) {
-            if (!leg[i]->hasOccurred(settlementDate,
-                                     includeSettlementDateFlows))
-                totalNPV += leg[i]->amount() *
-                            discountCurve.discount(leg[i]->date());
-        }
+        for (Size i=0; i<flows.size(); ++i)
+            totalNPV += flows[i]->amount() * discounts[i];
 
         return totalNPV/discountCurve.discount(npvDate);
     }
@@ -479,12 +509,14 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        BPSCalculator calc(discountCurve);
-        for (Size i=0; i<leg.size(); ++i) {
-            if (!leg[i]->hasOccurred(settlementDate,
-                                     includeSettlementDateFlows))
-                leg[i]->accept(calc);
-        }
+        std::vector<CashFlow*> flows;
+        std::vector<DiscountFactor> discounts;
+        aliveFlows(leg, discountCurve, includeSettlementDateFlows,
+                   settlementDate, flows, discounts);
+
+        BPSCalculator calc;
+        for (Size i=0; i<flows.size(); ++i)
+            calc.add(*flows[i], discounts[i]);
         return basisPoint_*calc.bps()/discountCurve.discount(npvDate);
     }
 
@@ -502,15 +534,15 @@ namespace QuantLib {
             return;
         }
 
-        BPSCalculator calc(discountCurve);
-        for (Size i=0; i<leg.size(); ++i) {
-            CashFlow& cf = *leg[i];
-            if (!cf.hasOccurred(settlementDate,
-                                includeSettlementDateFlows)) {
-                npv += cf.amount() *
-                       discountCurve.discount(cf.date());
-                cf.accept(calc);
-            }
+        std::vector<CashFlow*> flows;
+        std::vector<DiscountFactor> discounts;
+        aliveFlows(leg, discountCurve, includeSettlementDateFlows,
+                   settlementDate, flows, discounts);
+
+        BPSCalculator calc;
+        for (Size i=0; i<flows.size(); ++i) {
+            npv += flows[i]->amount() * discounts[i];
+            calc.add(*flows[i], discounts[i]);
         }
         DiscountFactor d = discountCurve.discount(npvDate);
         npv /= d;
@@ -530,16 +562,16 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
+        std::vector<CashFlow*> flows;
+        std::vector<DiscountFactor> discounts;
+        aliveFlows(leg, discountCurve, includeSettlementDateFlows,
+                   settlementDate, flows, discounts);
+
         Real npv = 0.0;
-        BPSCalculator calc(discountCurve);
-        for (Size i=0; i<leg.size(); ++i) {
-            CashFlow& cf = *leg[i];
-            if (!cf.hasOccurred(settlementDate,
-                                includeSettlementDateFlows)) {
-                npv += cf.amount() *
-                       discountCurve.discount(cf.date());
-                cf.accept(calc);
-            }
+        BPSCalculator calc;
+        for (Size i=0; i<flows.size(); ++i) {
+            npv += flows[i]->amount() * discounts[i];
+            calc.add(*flows[i], discounts[i]);
         }
 
         if (targetNpv==Null<Real>())
@@ -28,14 +28,18 @@
 #include <ql/math/solvers1d/newton.hpp>
 #include <ql/termstructures/volatility/smilesection.hpp>
 #include <ql/cashflows/cmscoupon.hpp>
+#include <ql/cashflows/capflooredcoupon.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/instruments/vanillaswap.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionvolcube1.hpp>
+#include <ql/utilities/parallel.hpp>
 
 #include <boost/bind.hpp>
+#include <set>
 
 namespace QuantLib {
 
@@ -251,10 +255,194 @@ namespace QuantLib {
        lowerLimit_(lowerLimit),
        requiredStdDeviations_(8),
        precision_(precision),
-       refiningIntegrationTolerance_(.0001){
+       refiningIntegrationTolerance_(.0001),
+       caching_(false), threads_(Null<Size>()), notifications_(0),
+       cacheHits_(0), cacheMisses_(0) {
 
     }
 
+    void NumericHaganPricer::enableCaching() {
+        if (!caching_) {
+            caching_ = true;
+            cacheHits_ = cacheMisses_ = 0;
+        }
+    }
+
+    void NumericHaganPricer::disableCaching() {
+        caching_ = false;
+        threads_ = Null<Size>();
+        cache_.clear();
+    }
+
+    void NumericHaganPricer::clearCache() {
+        cache_.clear();
+    }
+
+    Size NumericHaganPricer::cacheHits() const {
+        return cacheHits_;
+    }
+
+    Size NumericHaganPricer::cacheMisses() const {
+        return cacheMisses_;
+    }
+
+    void NumericHaganPricer::enableParallelPricing(Size threads) {
+        enableCaching();
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+    }
+
+    void NumericHaganPricer::disableParallelPricing() {
+        threads_ = Null<Size>();
+    }
+
+    void NumericHaganPricer::update() {
+        // the stored values are checked against the smile version
+        // and the mean reversion when they're retrieved
+        ++notifications_;
+        HaganPricer::update();
+    }
+
+    bool NumericHaganPricer::CacheKey::operator<(const CacheKey& o) const {
+        if (fixingDate != o.fixingDate)
+            return fixingDate < o.fixingDate;
+        if (paymentDate != o.paymentDate)
+            return paymentDate < o.paymentDate;
+        if (swapRateValue != o.swapRateValue)
+            return swapRateValue < o.swapRateValue;
+        if (annuity != o.annuity)
+            return annuity < o.annuity;
+        if (meanReversion != o.meanReversion)
+            return meanReversion < o.meanReversion;
+        if (optionType != o.optionType)
+            return optionType < o.optionType;
+        return strike < o.strike;
+    }
+
+    NumericHaganPricer::CacheKey NumericHaganPricer::cacheKey(
+                                Option::Type optionType, Rate strike) const {
+        CacheKey key;
+        key.fixingDate = fixingDate_;
+        key.paymentDate = paymentDate_;
+        key.swapRateValue = swapRateValue_;
+        key.annuity = annuity_;
+        key.meanReversion = meanReversion_->value();
+        key.optionType = optionType;
+        key.strike = strike;
+        return key;
+    }
+
+    Size NumericHaganPricer::smileVersion() const {
+        boost::shared_ptr<SwaptionVolCube1> cube =
+            boost::dynamic_pointer_cast<SwaptionVolCube1>(
+                                    swaptionVolatility().currentLink());
+        if (cube)
+            return cube->smileVersion(swapTenor_);
+        // other structures can only tell that something changed
+        return notifications_;
+    }
+
+    std::map<NumericHaganPricer::CacheKey, Real>&
+    NumericHaganPricer::cachedValues() const {
+        SmileCache& cache = cache_[coupon_->swapIndex()->name()];
+        const boost::shared_ptr<SwaptionVolatilityStructure>& volatility =
+            swaptionVolatility().currentLink();
+        Size version = smileVersion();
+        if (cache.volatility != volatility || cache.version != version) {
+            cache.values.clear();
+            cache.volatility = volatility;
+            cache.version = version;
+        }
+        return cache.values;
+    }
+
+    NumericHaganPricer::Replication NumericHaganPricer::replication() const {
+        Replication r;
+        r.vanillaOptionPricer = vanillaOptionPricer_;
+        r.rateCurve = rateCurve_;
+        r.gFunction = gFunction_;
+        r.fixingDate = fixingDate_;
+        r.paymentDate = paymentDate_;
+        r.annuity = annuity_;
+        r.swapRateValue = swapRateValue_;
+        return r;
+    }
+
+    void NumericHaganPricer::precalculate(const Leg& leg) {
+        if (threads_ == Null<Size>())
+            return;
+
+        // initializing the pricer builds swaps and registers with
+        // term structures; therefore, the coupon data are collected
+        // serially and only the integrations run in parallel.
+        Date today = Settings::instance().evaluationDate();
+        std::vector<Replication> replications;
+        std::vector<CacheKey> calls, puts;
+        std::vector<std::map<CacheKey, Real>*> targets;
+        std::vector<Real> upperLimits;
+        std::set<std::pair<std::string, CacheKey> > pending;
+        for (Size i=0; i<leg.size(); ++i) {
+            boost::shared_ptr<CmsCoupon> coupon =
+                boost::dynamic_pointer_cast<CmsCoupon>(leg[i]);
+            boost::shared_ptr<CappedFlooredCmsCoupon> cappedFloored =
+                boost::dynamic_pointer_cast<CappedFlooredCmsCoupon>(leg[i]);
+            if (cappedFloored)
+                coupon = boost::dynamic_pointer_cast<CmsCoupon>(
+                                                 cappedFloored->underlying());
+            if (!coupon || coupon->pricer().get() != this)
+                continue;
+            initialize(*coupon);
+            if (fixingDate_ <= today)
+                continue;
+            std::map<CacheKey, Real>& values = cachedValues();
+            CacheKey call = cacheKey(Option::Call, swapRateValue_);
+            CacheKey put = cacheKey(Option::Put, swapRateValue_);
+            if (values.count(call) != 0 && values.count(put) != 0)
+                continue;
+            if (!pending.insert(std::make_pair(coupon->swapIndex()->name(),
+                                               call)).second)
+                continue;
+            replications.push_back(replication());
+            calls.push_back(call);
+            puts.push_back(put);
+            targets.push_back(&values);
+            upperLimits.push_back(resetUpperLimit(requiredStdDeviations_));
+        }
+
+        // both optionlets of a coupon share its g-function, which
+        // is not thread-safe; thus, each coupon is a single task.
+        const long n = replications.size();
+        std::vector<Real> callValues(n), putValues(n);
+        std::vector<std::string> failures(n);
+        std::vector<char> failed(n, false);
+        #if defined(_OPENMP)
+        const Size threads = parallelThreads(threads_);
+        #pragma omp parallel for num_threads(threads) schedule(dynamic)
+        #endif
+        for (long i=0; i<n; ++i) {
+            try {
+                callValues[i] = replicatedValue(replications[i], Option::Call,
+                                                calls[i].strike,
+                                                upperLimits[i]);
+                putValues[i] = replicatedValue(replications[i], Option::Put,
+                                               puts[i].strike,
+                                               upperLimits[i]);
+            } catch (std::exception& e) {
+                failed[i] = true;
+                failures[i] = e.what();
+            } catch (...) {
+                failed[i] = true;
+                failures[i] = "unknown error";
+            }
+        }
+
+        for (long i=0; i<n; ++i) {
+            QL_REQUIRE(!failed[i], failures[i]);
+            (*targets[i])[calls[i]] = callValues[i];
+            (*targets[i])[puts[i]] = putValues[i];
+            cacheMisses_ += 2;
+        }
+    }
+
     Real NumericHaganPricer::integrate(Real a,
         Real b, const ConundrumIntegrand& integrand) const {
             double result =.0;
@@ -310,19 +498,51 @@ namespace QuantLib {
     Real NumericHaganPricer::optionletPrice(
                                 Option::Type optionType, Real strike) const {
 
-        boost::shared_ptr<ConundrumIntegrand> integrand(new
-            ConundrumIntegrand(vanillaOptionPricer_, rateCurve_, gFunction_,
-                               fixingDate_, paymentDate_, annuity_,
-                               swapRateValue_, strike, optionType));
+        CacheKey key;
+        std::map<CacheKey, Real>* values = 0;
+        if (caching_) {
+            values = &cachedValues();
+            key = cacheKey(optionType, strike);
+            std::map<CacheKey, Real>::const_iterator i = values->find(key);
+            if (i != values->end()) {
+                ++cacheHits_;
+                return coupon_->accrualPeriod() * (discount_/annuity_) *
+                    i->second;
+            }
+        }
+
         stdDeviationsForUpperLimit_= requiredStdDeviations_;
-        Real a, b, integralValue;
         if (optionType==Option::Call) {
             upperLimit_ = resetUpperLimit(stdDeviationsForUpperLimit_);
         //    while(upperLimit_ <= strike){
         //        stdDeviationsForUpperLimit_ += 1.;
         //        upperLimit_ = resetUpperLimit(stdDeviationsForUpperLimit_);
         //    }
-            integralValue = integrate(strike, upperLimit_, *integrand);
+        }
+        Real value = replicatedValue(replication(), optionType, strike,
+                                     upperLimit_);
+        if (caching_) {
+            ++cacheMisses_;
+            (*values)[key] = value;
+        }
+
+        // v. HAGAN, Conundrums..., formule 2.17a, 2.18a
+        return coupon_->accrualPeriod() * (discount_/annuity_) * value;
+    }
+
+    Real NumericHaganPricer::replicatedValue(const Replication& r,
+                                             Option::Type optionType,
+                                             Rate strike,
+                                             Real upperLimit) const {
+
+        boost::shared_ptr<ConundrumIntegrand> integrand(new
+            ConundrumIntegrand(r.vanillaOptionPricer, r.rateCurve,
+                               r.gFunction, r.fixingDate, r.paymentDate,
+                               r.annuity, r.swapRateValue, strike,
+                               optionType));
+        Real a, b, integralValue;
+        if (optionType==Option::Call) {
+            integralValue = integrate(strike, upperLimit, *integrand);
             //refineIntegration(integralValue, *integrand);
         } else {
             a = std::min(strike, lowerLimit_);
@@ -332,11 +552,9 @@ namespace QuantLib {
 
         Real dFdK = integrand->firstDerivativeOfF(strike);
         Real swaptionPrice =
-            (*vanillaOptionPricer_)(strike, optionType, annuity_);
+            (*r.vanillaOptionPricer)(strike, optionType, r.annuity);
 
-        // v. HAGAN, Conundrums..., formule 2.17a, 2.18a
-        return coupon_->accrualPeriod() * (discount_/annuity_) *
-            ((1 + dFdK) * swaptionPrice + optionType*integralValue);
+        return (1 + dFdK) * swaptionPrice + optionType*integralValue;
     }
 
     Real NumericHaganPricer::swapletPrice() const {
@@ -25,6 +25,7 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -245,6 +246,17 @@ namespace QuantLib {
     /*! Prices a cms coupon via static replication as in Hagan's
         "Conundrums..." article via numerical integration based on
         prices of vanilla swaptions
+
+        The replication integrals can be stored and reused by coupons
+        with the same swap index, fixing and payment dates, forward
+        swap rate, annuity, mean reversion and strike. When the
+        swaption volatility is a SwaptionVolCube1, the values stored
+        for a swap index are kept as long as the smiles of the cube
+        for its tenor don't change (see
+        SwaptionVolCube1::smileVersion()); thus, during a CMS-market
+        calibration, the integrals of the tenors whose smiles were not
+        moved are reused. With other volatility structures, they are
+        discarded whenever the pricer is notified of a change.
     */
     class NumericHaganPricer : public HaganPricer {
       public:
@@ -259,6 +271,37 @@ namespace QuantLib {
        Real upperLimit() { return upperLimit_; }
        Real stdDeviations() { return stdDeviationsForUpperLimit_; }
 
+        /*! \name Caching and parallel pricing */
+        //@{
+        //! stores the replication integrals for later reuse
+        void enableCaching();
+        //! discards the stored integrals and stops storing them
+        void disableCaching();
+        void clearCache();
+        //! number of integrals retrieved since caching was enabled
+        Size cacheHits() const;
+        //! number of integrals calculated since caching was enabled
+        Size cacheMisses() const;
+        /*! Makes precalculate() evaluate the coupons of a leg
+            concurrently; caching is enabled as well.  A null or zero
+            number of threads selects all the available ones; see
+            parallelThreads().
+        */
+        void enableParallelPricing(Size threads = 0);
+        void disableParallelPricing();
+        /*! Calculates concurrently and stores the integrals needed by
+            the swaplets of the CMS coupons in the leg (plain or
+            capped/floored) which use this pricer, so that pricing
+            them afterwards only requires lookups.  It does nothing
+            unless parallel pricing is enabled.
+        */
+        void precalculate(const Leg& leg);
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+
       //private:
         class Function : public std::unary_function<Real, Real> {
           public:
@@ -309,6 +352,48 @@ namespace QuantLib {
 
         mutable Real upperLimit_, stdDeviationsForUpperLimit_;
         const Real lowerLimit_, requiredStdDeviations_, precision_, refiningIntegrationTolerance_;
+      private:
+        // market data of a coupon used by the replication
+        struct Replication {
+            boost::shared_ptr<VanillaOptionPricer> vanillaOptionPricer;
+            boost::shared_ptr<YieldTermStructure> rateCurve;
+            boost::shared_ptr<GFunction> gFunction;
+            Date fixingDate, paymentDate;
+            Real annuity;
+            Rate swapRateValue;
+        };
+        struct CacheKey {
+            Date fixingDate, paymentDate;
+            Rate swapRateValue;
+            Real annuity, meanReversion;
+            Option::Type optionType;
+            Rate strike;
+            bool operator<(const CacheKey& other) const;
+        };
+        // values stored for a swap index and the smile they used
+        struct SmileCache {
+            SmileCache() : version(0) {}
+            boost::shared_ptr<SwaptionVolatilityStructure> volatility;
+            Size version;
+            std::map<CacheKey, Real> values;
+        };
+        Replication replication() const;
+        CacheKey cacheKey(Option::Type optionType, Rate strike) const;
+        Size smileVersion() const;
+        // the values stored for the swap index of the current coupon;
+        // they are discarded if its smile changed
+        std::map<CacheKey, Real>& cachedValues() const;
+        // optionlet price before scaling by the accrual period and by
+        // the ratio of discount and annuity
+        Real replicatedValue(const Replication& replication,
+                             Option::Type optionType,
+                             Rate strike,
+                             Real upperLimit) const;
+        bool caching_;
+        Size threads_;
+        Size notifications_;
+        mutable std::map<std::string, SmileCache> cache_;
+        mutable Size cacheHits_, cacheMisses_;
     };
 
     //! CMS-coupon pricer
@@ -31,6 +31,15 @@ namespace QuantLib {
             registerWith(process_);
     }
 
+    FFTEngine::FFTEngine(Real logStrikeSpacing)
+        : lambda_(logStrikeSpacing) {}
+
+    Real FFTEngine::underlyingValue() const
+    {
+        QL_REQUIRE(process_, "no one-dimensional process given");
+        return process_->x0();
+    }
+
     void FFTEngine::calculate() const
     {
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
@@ -103,6 +112,7 @@ namespace QuantLib {
 
         std::complex<Real> i1(0, 1);
         Real alpha = 1.25;
+        Real spot = underlyingValue();
 
         for (PayoffMap::const_iterator payIt = payoffMap.begin(); payIt != payoffMap.end(); payIt++)
         {
@@ -178,7 +188,7 @@ namespace QuantLib {
                     resultMap_[expiryDate][payoff] = callPrice;
                     break;
                 case Option::Put:
-                    resultMap_[expiryDate][payoff] = callPrice - process_->x0() * div + payoff->strike() * df;
+                    resultMap_[expiryDate][payoff] = callPrice - spot * div + payoff->strike() * df;
                     break;
                 default:
                     QL_FAIL("Invalid option type");
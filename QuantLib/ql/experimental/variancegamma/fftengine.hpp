@@ -56,6 +56,11 @@ namespace QuantLib {
         virtual std::auto_ptr<FFTEngine> clone() const = 0;
 
     protected:
+        /*! For engines whose process is not one-dimensional; they
+            must override underlyingValue(). */
+        explicit FFTEngine(Real logStrikeSpacing);
+        //! the current underlying price; by default, the process' x0()
+        virtual Real underlyingValue() const;
         virtual void precalculateExpiry(Date d) = 0;
         virtual std::complex<Real> complexFourierTransform(std::complex<Real> u) const = 0;
         virtual Real discountFactor(Date d) const = 0;
@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
+
+namespace QuantLib {
+
+    FFTHestonEngine::FFTHestonEngine(
+                                 const boost::shared_ptr<HestonModel>& model,
+                                 Real logStrikeSpacing)
+    : FFTEngine(logStrikeSpacing), model_(model) {
+        registerWith(model_);
+        registerWith(model_->process());
+    }
+
+    std::auto_ptr<FFTEngine> FFTHestonEngine::clone() const {
+        return std::auto_ptr<FFTEngine>(new FFTHestonEngine(model_, lambda_));
+    }
+
+    Real FFTHestonEngine::underlyingValue() const {
+        return model_->process()->s0()->value();
+    }
+
+    void FFTHestonEngine::precalculateExpiry(Date d) {
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        dividendDiscount_ = process->dividendYield()->discount(d);
+        riskFreeDiscount_ = process->riskFreeRate()->discount(d);
+        t_ = process->time(d);
+
+        kappa_ = model_->kappa();
+        theta_ = model_->theta();
+        sigma_ = model_->sigma();
+        rho_ = model_->rho();
+        v0_ = model_->v0();
+    }
+
+    std::complex<Real> FFTHestonEngine::complexFourierTransform(
+                                                std::complex<Real> u) const {
+        const std::complex<Real> i1(0, 1);
+        const Real sigma2 = sigma_*sigma_;
+        const Real s = underlyingValue();
+
+        const std::complex<Real> t1 = kappa_ - rho_*sigma_*i1*u;
+        const std::complex<Real> d = std::sqrt(t1*t1 + sigma2*(i1*u + u*u));
+        const std::complex<Real> g = (t1 - d)/(t1 + d);
+        const std::complex<Real> ex = std::exp(-d*t_);
+
+        const std::complex<Real> c = kappa_*theta_/sigma2
+            * ((t1 - d)*t_ - 2.0*std::log((1.0 - g*ex)/(1.0 - g)));
+        const std::complex<Real> dv = (t1 - d)/sigma2
+            * (1.0 - ex)/(1.0 - g*ex);
+
+        return std::exp(i1*u*std::log(s*dividendDiscount_/riskFreeDiscount_)
+                        + c + dv*v0_);
+    }
+
+    Real FFTHestonEngine::discountFactor(Date d) const {
+        return model_->process()->riskFreeRate()->discount(d);
+    }
+
+    Real FFTHestonEngine::dividendYield(Date d) const {
+        return model_->process()->dividendYield()->discount(d);
+    }
+
+}
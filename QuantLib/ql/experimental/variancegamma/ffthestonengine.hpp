@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ffthestonengine.hpp
+    \brief FFT engine for vanilla options under the Heston model
+*/
+
+#ifndef quantlib_fft_heston_engine_hpp
+#define quantlib_fft_heston_engine_hpp
+
+#include <ql/experimental/variancegamma/fftengine.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+
+namespace QuantLib {
+
+    //! FFT engine for vanilla options under the Heston model
+    /*! The characteristic function is written in the form given by
+        Albrecher et al., which doesn't need a branch correction of
+        the complex logarithm.  The model parameters are used, so
+        that the engine can be used during a calibration.
+
+        References:
+
+        H. Albrecher, P. Mayer, W.Schoutens and J. Tistaert,
+        The Little Heston Trap, http://www.schoutens.be/HestonTrap.pdf
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston engine.
+    */
+    class FFTHestonEngine : public FFTEngine {
+      public:
+        FFTHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Real logStrikeSpacing = 0.001);
+        virtual std::auto_ptr<FFTEngine> clone() const;
+
+      protected:
+        virtual Real underlyingValue() const;
+        virtual void precalculateExpiry(Date d);
+        virtual std::complex<Real> complexFourierTransform(
+                                                  std::complex<Real> u) const;
+        virtual Real discountFactor(Date d) const;
+        virtual Real dividendYield(Date d) const;
+
+      private:
+        boost::shared_ptr<HestonModel> model_;
+        DiscountFactor dividendDiscount_;
+        DiscountFactor riskFreeDiscount_;
+        Time t_;
+        Real kappa_, theta_, sigma_, rho_, v0_;
+    };
+
+}
+
+
+#endif
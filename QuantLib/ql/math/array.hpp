@@ -33,6 +33,7 @@
 #include <boost/iterator/reverse_iterator.hpp>
 #include <boost/scoped_array.hpp>
 #include <boost/type_traits.hpp>
+#include <cmath>
 #include <functional>
 #include <numeric>
 #include <vector>
@@ -40,6 +41,38 @@
 
 namespace QuantLib {
 
+    //! base class for array expressions
+    /*! Arithmetic operators and functions on arrays don't return new
+        arrays; they return lightweight expression objects which hold
+        references to their operands and are evaluated element by
+        element when assigned to an array. Thus, an expression such as
+        <tt>a + b*c - d</tt> allocates no temporary arrays; only the
+        final result is allocated when the expression is stored into
+        a new array (or none at all, if it is assigned to an existing
+        array of the correct size.)
+
+        Expressions can be indexed and know their size; they convert
+        implicitly to Array and can therefore be passed where a
+        <tt>const Array&</tt> is expected.
+
+        \note This removes the temporaries created inside an
+              expression, not the ones returned by functions. Methods
+              returning a <tt>Disposable\<Array\></tt>, such as
+              TripleBandLinearOp::apply or StochasticProcess::evolve,
+              still allocate their result at each call; thus, a time
+              step calling them is not allocation-free.
+
+        \warning Expressions hold references to the arrays they were
+                 built from, and must be evaluated before the latter
+                 go out of scope. In practice, this means that they
+                 should never be stored.
+    */
+    template <class E>
+    class ArrayExpression {
+      public:
+        const E& derived() const { return static_cast<const E&>(*this); }
+    };
+
     //! 1-D array used in linear algebra.
     /*! This class implements the concept of vector as used in linear
         algebra.
@@ -47,8 +80,12 @@ namespace QuantLib {
         <tt>std::vector</tt> should be used instead.
 
         \test construction of arrays is checked in a number of cases
+
+        \test the results of array expressions are checked against
+              element-wise calculations, including the case in which
+              the array being assigned appears in the expression.
     */
-    class Array {
+    class Array : public ArrayExpression<Array> {
       public:
         //! \name Constructors, destructor, and assignment
         //@{
@@ -62,12 +99,29 @@ namespace QuantLib {
         Array(Size size, Real value, Real increment);
         Array(const Array&);
         Array(const Disposable<Array>&);
+        #if !defined(BOOST_NO_RVALUE_REFERENCES) && \
+            !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        Array(Array&&);
+        #endif
+        //! evaluates the given expression
+        template <class E>
+        Array(const ArrayExpression<E>&);
         //! creates the array from an iterable sequence
         template <class ForwardIterator>
         Array(ForwardIterator begin, ForwardIterator end);
 
         Array& operator=(const Array&);
         Array& operator=(const Disposable<Array>&);
+        #if !defined(BOOST_NO_RVALUE_REFERENCES) && \
+            !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        Array& operator=(Array&&);
+        #endif
+        /*! The expression is evaluated in place if the array has the
+            correct size; this is safe even if the array appears in
+            the expression, since operations are element-wise.
+        */
+        template <class E>
+        Array& operator=(const ArrayExpression<E>&);
         bool operator==(const Array&) const;
         bool operator!=(const Array&) const;
         //@}
@@ -91,6 +145,10 @@ namespace QuantLib {
         const Array& operator*=(Real);
         const Array& operator/=(const Array&);
         const Array& operator/=(Real);
+        template <class E> const Array& operator+=(const ArrayExpression<E>&);
+        template <class E> const Array& operator-=(const ArrayExpression<E>&);
+        template <class E> const Array& operator*=(const ArrayExpression<E>&);
+        template <class E> const Array& operator/=(const ArrayExpression<E>&);
         //@}
         //! \name Element access
         //@{
@@ -135,10 +193,35 @@ namespace QuantLib {
         //@}
 
       private:
+        template <class E, class Op>
+        void update(const ArrayExpression<E>&, Op);
         boost::scoped_array<Real> data_;
         Size n_;
     };
 
+    //! specialization of Disposable for arrays
+    /*! Besides the behavior of the generic class, it allows array
+        expressions to be returned by functions returning a
+        <tt>Disposable\<Array\></tt>; they are evaluated into the
+        returned array.
+    */
+    template <>
+    class Disposable<Array> : public Array {
+      public:
+        Disposable(Array& t) {
+            this->swap(t);
+        }
+        Disposable(const Disposable<Array>& t) : Array() {
+            this->swap(const_cast<Disposable<Array>&>(t));
+        }
+        template <class E>
+        Disposable(const ArrayExpression<E>& e) : Array(e) {}
+        Disposable<Array>& operator=(const Disposable<Array>& t) {
+            this->swap(const_cast<Disposable<Array>&>(t));
+            return *this;
+        }
+    };
+
     //! specialization of null template for this class
     template <>
     class Null<Array> {
@@ -152,48 +235,6 @@ namespace QuantLib {
     /*! \relates Array */
     Real DotProduct(const Array&, const Array&);
 
-    // unary operators
-    /*! \relates Array */
-    const Disposable<Array> operator+(const Array& v);
-    /*! \relates Array */
-    const Disposable<Array> operator-(const Array& v);
-
-    // binary operators
-    /*! \relates Array */
-    const Disposable<Array> operator+(const Array&, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator+(const Array&, Real);
-    /*! \relates Array */
-    const Disposable<Array> operator+(Real, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator-(const Array&, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator-(const Array&, Real);
-    /*! \relates Array */
-    const Disposable<Array> operator-(Real, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator*(const Array&, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator*(const Array&, Real);
-    /*! \relates Array */
-    const Disposable<Array> operator*(Real, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator/(const Array&, const Array&);
-    /*! \relates Array */
-    const Disposable<Array> operator/(const Array&, Real);
-    /*! \relates Array */
-    const Disposable<Array> operator/(Real, const Array&);
-
-    // math functions
-    /*! \relates Array */
-    const Disposable<Array> Abs(const Array&);
-    /*! \relates Array */
-    const Disposable<Array> Sqrt(const Array&);
-    /*! \relates Array */
-    const Disposable<Array> Log(const Array&);
-    /*! \relates Array */
-    const Disposable<Array> Exp(const Array&);
-
     // utilities
     /*! \relates Array */
     void swap(Array&, Array&);
@@ -232,6 +273,14 @@ namespace QuantLib {
         swap(const_cast<Disposable<Array>&>(from));
     }
 
+    #if !defined(BOOST_NO_RVALUE_REFERENCES) && \
+        !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    inline Array::Array(Array&& from)
+    : data_((Real*)(0)), n_(0) {
+        swap(from);
+    }
+    #endif
+
     namespace detail {
 
         template <class I>
@@ -297,6 +346,14 @@ namespace QuantLib {
         return *this;
     }
 
+    #if !defined(BOOST_NO_RVALUE_REFERENCES) && \
+        !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    inline Array& Array::operator=(Array&& from) {
+        swap(from);
+        return *this;
+    }
+    #endif
+
     inline const Array& Array::operator+=(const Array& v) {
         QL_REQUIRE(n_ == v.n_,
                    "arrays with different sizes (" << n_ << ", "
@@ -473,153 +530,322 @@ namespace QuantLib {
         return std::inner_product(v1.begin(),v1.end(),v2.begin(),0.0);
     }
 
+    // expressions
+
+    namespace detail {
+
+        // arrays are stored by reference, other expressions by value
+        template <class E>
+        struct array_operand {
+            typedef const E type;
+        };
+
+        template <>
+        struct array_operand<Array> {
+            typedef const Array& type;
+        };
+
+        struct ArrayAdd {
+            static const char* description() { return "added"; }
+            Real operator()(Real x, Real y) const { return x + y; }
+        };
+
+        struct ArraySubtract {
+            static const char* description() { return "subtracted"; }
+            Real operator()(Real x, Real y) const { return x - y; }
+        };
+
+        struct ArrayMultiply {
+            static const char* description() { return "multiplied"; }
+            Real operator()(Real x, Real y) const { return x * y; }
+        };
+
+        struct ArrayDivide {
+            static const char* description() { return "divided"; }
+            Real operator()(Real x, Real y) const { return x / y; }
+        };
+
+        struct ArrayPlus {
+            Real operator()(Real x) const { return x; }
+        };
+
+        struct ArrayNegate {
+            Real operator()(Real x) const { return -x; }
+        };
+
+        struct ArrayAbs {
+            Real operator()(Real x) const { return std::fabs(x); }
+        };
+
+        struct ArraySqrt {
+            Real operator()(Real x) const { return std::sqrt(x); }
+        };
+
+        struct ArrayLog {
+            Real operator()(Real x) const { return std::log(x); }
+        };
+
+        struct ArrayExp {
+            Real operator()(Real x) const { return std::exp(x); }
+        };
+
+        template <class E1, class E2, class Op>
+        class ArrayBinaryExpression
+            : public ArrayExpression<ArrayBinaryExpression<E1,E2,Op> > {
+          public:
+            ArrayBinaryExpression(const E1& e1, const E2& e2)
+            : e1_(e1), e2_(e2) {
+                QL_REQUIRE(e1.size() == e2.size(),
+                           "arrays with different sizes (" << e1.size()
+                           << ", " << e2.size() << ") cannot be "
+                           << Op::description());
+            }
+            Size size() const { return e1_.size(); }
+            Real operator[](Size i) const { return Op()(e1_[i], e2_[i]); }
+          private:
+            typename array_operand<E1>::type e1_;
+            typename array_operand<E2>::type e2_;
+        };
+
+        template <class E, class Op>
+        class ArrayScalarExpression
+            : public ArrayExpression<ArrayScalarExpression<E,Op> > {
+          public:
+            ArrayScalarExpression(const E& e, Real x) : e_(e), x_(x) {}
+            Size size() const { return e_.size(); }
+            Real operator[](Size i) const { return Op()(e_[i], x_); }
+          private:
+            typename array_operand<E>::type e_;
+            Real x_;
+        };
+
+        template <class E, class Op>
+        class ScalarArrayExpression
+            : public ArrayExpression<ScalarArrayExpression<E,Op> > {
+          public:
+            ScalarArrayExpression(Real x, const E& e) : x_(x), e_(e) {}
+            Size size() const { return e_.size(); }
+            Real operator[](Size i) const { return Op()(x_, e_[i]); }
+          private:
+            Real x_;
+            typename array_operand<E>::type e_;
+        };
+
+        template <class E, class F>
+        class ArrayUnaryExpression
+            : public ArrayExpression<ArrayUnaryExpression<E,F> > {
+          public:
+            explicit ArrayUnaryExpression(const E& e) : e_(e) {}
+            Size size() const { return e_.size(); }
+            Real operator[](Size i) const { return F()(e_[i]); }
+          private:
+            typename array_operand<E>::type e_;
+        };
+
+    }
+
+    template <class E>
+    inline Array::Array(const ArrayExpression<E>& e)
+    : data_(e.derived().size() ? new Real[e.derived().size()] : (Real*)(0)),
+      n_(e.derived().size()) {
+        const E& x = e.derived();
+        for (Size i=0; i<n_; ++i)
+            data_[i] = x[i];
+    }
+
+    template <class E>
+    inline Array& Array::operator=(const ArrayExpression<E>& e) {
+        const E& x = e.derived();
+        if (x.size() != n_) {
+            Array temp(e);
+            swap(temp);
+        } else {
+            for (Size i=0; i<n_; ++i)
+                data_[i] = x[i];
+        }
+        return *this;
+    }
+
+    template <class E, class Op>
+    inline void Array::update(const ArrayExpression<E>& e, Op op) {
+        const E& x = e.derived();
+        QL_REQUIRE(n_ == x.size(),
+                   "arrays with different sizes (" << n_ << ", "
+                   << x.size() << ") cannot be " << Op::description());
+        for (Size i=0; i<n_; ++i)
+            data_[i] = op(data_[i], x[i]);
+    }
+
+    template <class E>
+    inline const Array& Array::operator+=(const ArrayExpression<E>& e) {
+        update(e, detail::ArrayAdd());
+        return *this;
+    }
+
+    template <class E>
+    inline const Array& Array::operator-=(const ArrayExpression<E>& e) {
+        update(e, detail::ArraySubtract());
+        return *this;
+    }
+
+    template <class E>
+    inline const Array& Array::operator*=(const ArrayExpression<E>& e) {
+        update(e, detail::ArrayMultiply());
+        return *this;
+    }
+
+    template <class E>
+    inline const Array& Array::operator/=(const ArrayExpression<E>& e) {
+        update(e, detail::ArrayDivide());
+        return *this;
+    }
+
     // overloaded operators
 
     // unary
 
-    inline const Disposable<Array> operator+(const Array& v) {
-        Array result = v;
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::ArrayPlus>
+    operator+(const ArrayExpression<E>& v) {
+        return detail::ArrayUnaryExpression<E,detail::ArrayPlus>(
+                                                                v.derived());
     }
 
-    inline const Disposable<Array> operator-(const Array& v) {
-        Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::negate<Real>());
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::ArrayNegate>
+    operator-(const ArrayExpression<E>& v) {
+        return detail::ArrayUnaryExpression<E,detail::ArrayNegate>(
+                                                                v.derived());
     }
 
-
     // binary operators
 
-    inline const Disposable<Array> operator+(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be added");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::plus<Real>());
-        return result;
+    /*! \relates Array */
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,detail::ArrayAdd>
+    operator+(const ArrayExpression<E1>& v1, const ArrayExpression<E2>& v2) {
+        return detail::ArrayBinaryExpression<E1,E2,detail::ArrayAdd>(
+                                                  v1.derived(), v2.derived());
     }
 
-    inline const Disposable<Array> operator+(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::plus<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayScalarExpression<E,detail::ArrayAdd>
+    operator+(const ArrayExpression<E>& v1, Real a) {
+        return detail::ArrayScalarExpression<E,detail::ArrayAdd>(
+                                                              v1.derived(), a);
     }
 
-    inline const Disposable<Array> operator+(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::plus<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ScalarArrayExpression<E,detail::ArrayAdd>
+    operator+(Real a, const ArrayExpression<E>& v2) {
+        return detail::ScalarArrayExpression<E,detail::ArrayAdd>(
+                                                              a, v2.derived());
     }
 
-    inline const Disposable<Array> operator-(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be subtracted");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::minus<Real>());
-        return result;
+    /*! \relates Array */
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,detail::ArraySubtract>
+    operator-(const ArrayExpression<E1>& v1, const ArrayExpression<E2>& v2) {
+        return detail::ArrayBinaryExpression<E1,E2,detail::ArraySubtract>(
+                                                  v1.derived(), v2.derived());
     }
 
-    inline const Disposable<Array> operator-(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::minus<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayScalarExpression<E,detail::ArraySubtract>
+    operator-(const ArrayExpression<E>& v1, Real a) {
+        return detail::ArrayScalarExpression<E,detail::ArraySubtract>(
+                                                              v1.derived(), a);
     }
 
-    inline const Disposable<Array> operator-(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::minus<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ScalarArrayExpression<E,detail::ArraySubtract>
+    operator-(Real a, const ArrayExpression<E>& v2) {
+        return detail::ScalarArrayExpression<E,detail::ArraySubtract>(
+                                                              a, v2.derived());
     }
 
-    inline const Disposable<Array> operator*(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be multiplied");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::multiplies<Real>());
-        return result;
+    /*! \relates Array */
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,detail::ArrayMultiply>
+    operator*(const ArrayExpression<E1>& v1, const ArrayExpression<E2>& v2) {
+        return detail::ArrayBinaryExpression<E1,E2,detail::ArrayMultiply>(
+                                                  v1.derived(), v2.derived());
     }
 
-    inline const Disposable<Array> operator*(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::multiplies<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayScalarExpression<E,detail::ArrayMultiply>
+    operator*(const ArrayExpression<E>& v1, Real a) {
+        return detail::ArrayScalarExpression<E,detail::ArrayMultiply>(
+                                                              v1.derived(), a);
     }
 
-    inline const Disposable<Array> operator*(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::multiplies<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ScalarArrayExpression<E,detail::ArrayMultiply>
+    operator*(Real a, const ArrayExpression<E>& v2) {
+        return detail::ScalarArrayExpression<E,detail::ArrayMultiply>(
+                                                              a, v2.derived());
     }
 
-    inline const Disposable<Array> operator/(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be divided");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::divides<Real>());
-        return result;
+    /*! \relates Array */
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,detail::ArrayDivide>
+    operator/(const ArrayExpression<E1>& v1, const ArrayExpression<E2>& v2) {
+        return detail::ArrayBinaryExpression<E1,E2,detail::ArrayDivide>(
+                                                  v1.derived(), v2.derived());
     }
 
-    inline const Disposable<Array> operator/(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::divides<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayScalarExpression<E,detail::ArrayDivide>
+    operator/(const ArrayExpression<E>& v1, Real a) {
+        return detail::ArrayScalarExpression<E,detail::ArrayDivide>(
+                                                              v1.derived(), a);
     }
 
-    inline const Disposable<Array> operator/(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::divides<Real>(),a));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ScalarArrayExpression<E,detail::ArrayDivide>
+    operator/(Real a, const ArrayExpression<E>& v2) {
+        return detail::ScalarArrayExpression<E,detail::ArrayDivide>(
+                                                              a, v2.derived());
     }
 
     // functions
 
-    inline const Disposable<Array> Abs(const Array& v) {
-        Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::ptr_fun<Real,Real>(std::fabs));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::ArrayAbs>
+    Abs(const ArrayExpression<E>& v) {
+        return detail::ArrayUnaryExpression<E,detail::ArrayAbs>(v.derived());
     }
 
-    inline const Disposable<Array> Sqrt(const Array& v) {
-        Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::ptr_fun<Real,Real>(std::sqrt));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::ArraySqrt>
+    Sqrt(const ArrayExpression<E>& v) {
+        return detail::ArrayUnaryExpression<E,detail::ArraySqrt>(v.derived());
     }
 
-    inline const Disposable<Array> Log(const Array& v) {
-        Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::ptr_fun<Real,Real>(std::log));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::ArrayLog>
+    Log(const ArrayExpression<E>& v) {
+        return detail::ArrayUnaryExpression<E,detail::ArrayLog>(v.derived());
     }
 
-    inline const Disposable<Array> Exp(const Array& v) {
-        Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::ptr_fun<Real,Real>(std::exp));
-        return result;
+    /*! \relates Array */
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::ArrayExp>
+    Exp(const ArrayExpression<E>& v) {
+        return detail::ArrayUnaryExpression<E,detail::ArrayExp>(v.derived());
     }
 
     inline void swap(Array& v, Array& w) {
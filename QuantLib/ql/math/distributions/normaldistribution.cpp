@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -52,6 +53,29 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::operator()(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) const {
+        // the arguments of the error function are stored in chunks
+        const Size chunk = 64;
+        Real buffer[chunk];
+        while (begin < end) {
+            const Size n = std::min<Size>(chunk, end-begin);
+            for (Size i=0; i<n; ++i)
+                buffer[i] = ((begin[i] - average_) / sigma_) * M_SQRT_2;
+            errorFunction_(buffer, buffer+n, out);
+            for (Size i=0; i<n; ++i)
+                out[i] = 0.5 * (1.0 + out[i]);
+            for (Size i=0; i<n; ++i) {
+                // asymptotic expansion, as in the scalar version
+                if (out[i] <= 1e-8)
+                    out[i] = (*this)(begin[i]);
+            }
+            begin += n;
+            out += n;
+        }
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -115,6 +139,40 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        const Size n = end-begin;
+        for (Size i=0; i<n; ++i) {
+            Real z = begin[i] - 0.5;
+            Real r = z*z;
+            out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+        }
+        for (Size i=0; i<n; ++i) {
+            Real x = begin[i];
+            if (x < x_low_ || x_high_ < x)
+                out[i] = tail_value(x);
+        }
+
+        #ifdef  REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (Size i=0; i<n; ++i) {
+            Real z = out[i];
+            Real r = (f_(z) - begin[i]) * M_SQRT2 * M_SQRTPI * exp(0.5 * z*z);
+            out[i] = z - r/(1+0.5*z*r);
+        }
+        #endif
+    }
+
+    void InverseCumulativeNormal::operator()(const Real* begin,
+                                             const Real* end,
+                                             Real* out) const {
+        standard_values(begin, end, out);
+        const Size n = end-begin;
+        for (Size i=0; i<n; ++i)
+            out[i] = average_ + sigma_*out[i];
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
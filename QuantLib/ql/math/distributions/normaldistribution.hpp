@@ -73,6 +73,13 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        //! applies the function to a range of values
+        /*! The results are the same as those of the scalar version.
+
+            \pre the input and output ranges must not overlap.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
       private:
         Real average_, sigma_;
         NormalDistribution gaussian_;
@@ -97,6 +104,8 @@ namespace QuantLib {
       in this case the traditional Box-Muller approach and its
       variants would not preserve the sequence's low-discrepancy.
 
+      \test the values returned on ranges are checked against the
+            scalar version.
     */
     class InverseCumulativeNormal
         : public std::unary_function<Real,Real> {
@@ -107,6 +116,13 @@ namespace QuantLib {
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        //! applies the function to a range of values
+        /*! The results are the same as those of the scalar version.
+
+            \pre the input and output ranges must not overlap.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -136,6 +152,16 @@ namespace QuantLib {
 
             return z;
         }
+        //! values for average=0, sigma=1 on a range of values
+        /*! The central region, where most values fall, is calculated
+            for the whole range in a single loop free of branches
+            which the compiler can vectorize; the values in the tails
+            are corrected afterwards.
+
+            \pre the input and output ranges must not overlap.
+        */
+        static void standard_values(const Real* begin, const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
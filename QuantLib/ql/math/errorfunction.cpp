@@ -252,4 +252,20 @@ namespace QuantLib {
 
     }
 
+    void ErrorFunction::operator()(const Real* begin, const Real* end,
+                                   Real* out) const {
+        const Size n = end-begin;
+        for (Size i=0; i<n; ++i) {
+            Real x = begin[i], z = x*x;
+            Real r = pp0+z*(pp1+z*(pp2+z*(pp3+z*pp4)));
+            Real s = one+z*(qq1+z*(qq2+z*(qq3+z*(qq4+z*qq5))));
+            out[i] = x + x*(r/s);
+        }
+        for (Size i=0; i<n; ++i) {
+            Real ax = std::fabs(begin[i]);
+            if (ax >= 0.84375 || ax < 3.7252902984e-09)
+                out[i] = (*this)(begin[i]);
+        }
+    }
+
 }
@@ -38,6 +38,17 @@ namespace QuantLib {
         ErrorFunction() {}
         // function
         Real operator()(Real x) const;
+        //! applies the function to a range of values
+        /*! The results are the same as those of the scalar version.
+            The most common case, i.e., \f$ |x| < 0.84375 \f$, is
+            calculated for all values in a single loop free of
+            branches which the compiler can vectorize; the remaining
+            values are corrected afterwards.
+
+            \pre the input and output ranges must not overlap.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
       private:
         static const Real tiny, one, erx, efx, efx8;
         static const Real pp0, pp1,pp2,pp3,pp4;
@@ -27,6 +27,7 @@
 #define quantlib_interpolation_hpp
 
 #include <ql/math/interpolations/extrapolation.hpp>
+#include <ql/math/interpolations/gridlocator.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/errors.hpp>
 #include <vector>
@@ -52,6 +53,10 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            virtual void values(const Real* x, Real* y, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -69,6 +74,7 @@ namespace QuantLib {
                 QL_REQUIRE(static_cast<int>(xEnd_-xBegin_) >= 2,
                            "not enough points to interpolate: at least 2 "
                            "required, " << static_cast<int>(xEnd_-xBegin_)<< " provided");
+                locator_.reset(xBegin_, xEnd_);
             }
             Real xMin() const {
                 return *xBegin_;
@@ -91,20 +97,29 @@ namespace QuantLib {
                 return (x >= x1 && x <= x2) || close(x,x1) || close(x,x2);
             }
           protected:
+            /*! Returns the index of the segment containing x. The
+                search is performed in constant time on uniform grids
+                and, if a hint is passed, for sequences of increasing
+                x; see GridLocator.
+            */
             Size locate(Real x) const {
                 #if defined(QL_EXTRA_SAFETY_CHECKS)
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return locator_(xBegin_, xEnd_, x);
+            }
+            Size locate(Real x, Size& hint) const {
+                #if defined(QL_EXTRA_SAFETY_CHECKS)
+                for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
+                    QL_REQUIRE(*j > *i, "unsorted x values");
+                #endif
+                return locator_(xBegin_, xEnd_, x, hint);
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
+          private:
+            detail::GridLocator<I1> locator_;
         };
       public:
         Interpolation() {}
@@ -114,6 +129,16 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! Interpolates at the n points x[0], ..., x[n-1] and writes
+            the results to y, which must be allocated by the caller.
+            Increasing sequences of points are located faster.
+        */
+        void operator()(const Real* x, Real* y, Size n,
+                        bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            impl_->values(x, y, n);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -10,6 +10,7 @@
 #include <ql/math/interpolations/extrapolation.hpp>
 #include <ql/math/interpolations/flatextrapolation2d.hpp>
 #include <ql/math/interpolations/forwardflatinterpolation.hpp>
+#include <ql/math/interpolations/gridlocator.hpp>
 #include <ql/math/interpolations/interpolation2d.hpp>
 #include <ql/math/interpolations/kernelinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
@@ -45,8 +45,16 @@ namespace QuantLib {
             }
             void calculate() {}
             Real value(Real x, Real y) const {
-                Size i = this->locateX(x), j = this->locateY(y);
-
+                return value(x, y, this->locateX(x), this->locateY(y));
+            }
+            void values(const Real* x, const Real* y, Real* z, Size n) const {
+                Size hx = 0, hy = 0;
+                for (Size k=0; k<n; ++k)
+                    z[k] = value(x[k], y[k], this->locateX(x[k], hx),
+                                 this->locateY(y[k], hy));
+            }
+          private:
+            Real value(Real x, Real y, Size i, Size j) const {
                 Real z1 = this->zData_[j][i];
                 Real z2 = this->zData_[j][i+1];
                 Real z3 = this->zData_[j+1][i];
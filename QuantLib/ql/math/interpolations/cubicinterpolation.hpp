@@ -673,6 +673,15 @@ namespace QuantLib {
                 Real dx_ = x-this->xBegin_[j];
                 return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
             }
+            void values(const Real* x, Real* y, Size n) const {
+                Size hint = 0;
+                for (Size i=0; i<n; ++i) {
+                    Size j = this->locate(x[i], hint);
+                    Real dx_ = x[i]-this->xBegin_[j];
+                    y[i] = this->yBegin_[j]
+                         + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
+                }
+            }
             Real primitive(Real x) const {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
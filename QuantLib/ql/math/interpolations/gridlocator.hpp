@@ -0,0 +1,143 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gridlocator.hpp
+    \brief location of a point in a sorted grid
+*/
+
+#ifndef quantlib_grid_locator_hpp
+#define quantlib_grid_locator_hpp
+
+#include <ql/types.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! location of a point in a sorted grid
+        /*! Given a sorted grid \f$ x_0 < x_1 < \dots < x_{n-1} \f$, it
+            returns the largest index \f$ i \leq n-2 \f$ such that
+            \f$ x_i \leq x \f$, or 0 if \f$ x < x_0 \f$; i.e., the
+            index of the segment to be used for interpolating at
+            \f$ x \f$. The result is the same as that of a binary
+            search, but it is usually found in constant time:
+
+            - if the grid is (approximately) uniform, which is checked
+              by reset(), the index is computed from the grid spacing
+              and adjusted by at most one position;
+            - otherwise, if the caller passes a hint, the segment it
+              holds (i.e., the one returned by the previous call using
+              the same hint) and the one following it are tried first,
+              which is the common case when a sequence of increasing
+              values is queried (e.g., when discounting the cash flows
+              of a leg).
+
+            Binary search is used as a fallback; thus, the result is
+            correct even if the grid is modified after reset() is
+            called, although the uniform-grid shortcut might be lost.
+
+            The locator is not modified by queries, so it can be used
+            concurrently by different threads as long as each of them
+            owns its hints.
+
+            \test the returned indices are checked against those
+                  obtained by binary search on uniform, nearly uniform,
+                  non-uniform and modified grids.
+        */
+        template <class I>
+        class GridLocator {
+          public:
+            GridLocator() : inverseSpacing_(0.0) {}
+            //! checks whether the grid is uniform
+            void reset(const I& begin, const I& end) {
+                inverseSpacing_ = 0.0;
+                Size n = end-begin;
+                if (n < 3)
+                    return;
+                Real dx = (begin[n-1]-begin[0])/(n-1);
+                if (!(dx > 0.0))
+                    return;
+                // within half a spacing, the estimated index is off by
+                // at most one position and is fixed by operator()
+                Real tolerance = 0.45*dx;
+                for (Size i=1; i<n-1; ++i) {
+                    if (std::fabs(begin[i]-(begin[0]+i*dx)) > tolerance)
+                        return;
+                }
+                inverseSpacing_ = 1.0/dx;
+            }
+            //! returns the index of the segment containing x
+            Size operator()(const I& begin, const I& end, Real x) const {
+                Size n = end-begin, i;
+                if (estimate(begin, n, x, i))
+                    return i;
+                return std::upper_bound(begin, end-1, x) - begin - 1;
+            }
+            /*! returns the index of the segment containing x, trying
+                first the segment held by the hint and the following
+                one; the hint is then set to the returned index.
+            */
+            Size operator()(const I& begin, const I& end, Real x,
+                            Size& hint) const {
+                Size n = end-begin, i;
+                if (estimate(begin, n, x, i))
+                    return hint = i;
+                if (hint <= n-2) {
+                    if (contains(begin, n, hint, x))
+                        return hint;
+                    if (hint < n-2 && contains(begin, n, hint+1, x))
+                        return ++hint;
+                }
+                return hint = std::upper_bound(begin, end-1, x) - begin - 1;
+            }
+          private:
+            // locates x outside the grid or on a uniform grid
+            bool estimate(const I& begin, Size n, Real x, Size& i) const {
+                if (x < *begin) {
+                    i = 0;
+                    return true;
+                } else if (x > begin[n-1]) {
+                    i = n-2;
+                    return true;
+                }
+                if (inverseSpacing_ > 0.0) {
+                    Real k = (x-*begin)*inverseSpacing_;
+                    i = (k < Real(n-2)) ? Size(k) : n-2;
+                    if (i > 0 && x < begin[i])
+                        --i;
+                    else if (i < n-2 && x >= begin[i+1])
+                        ++i;
+                    return contains(begin, n, i, x);
+                }
+                return false;
+            }
+            static bool contains(const I& begin, Size n, Size i, Real x) {
+                return begin[i] <= x && (i == n-2 || x < begin[i+1]);
+            }
+            Real inverseSpacing_;
+        };
+
+    }
+
+}
+
+
+#endif
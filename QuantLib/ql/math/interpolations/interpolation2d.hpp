@@ -26,6 +26,7 @@
 #define quantlib_interpolation2D_hpp
 
 #include <ql/math/interpolations/extrapolation.hpp>
+#include <ql/math/interpolations/gridlocator.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/errors.hpp>
@@ -59,6 +60,11 @@ namespace QuantLib {
             virtual const Matrix& zData() const = 0;
             virtual bool isInRange(Real x, Real y) const = 0;
             virtual Real value(Real x, Real y) const = 0;
+            virtual void values(const Real* x, const Real* y,
+                                Real* z, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    z[i] = value(x[i], y[i]);
+            }
         };
         boost::shared_ptr<Impl> impl_;
       public:
@@ -80,6 +86,8 @@ namespace QuantLib {
                 QL_REQUIRE(yEnd_-yBegin_ >= 2,
                            "not enough y points to interpolate: at least 2 "
                            "required, " << yEnd_-yBegin_ << " provided");
+                xLocator_.reset(xBegin_, xEnd_);
+                yLocator_.reset(yBegin_, yEnd_);
             }
             Real xMin() const {
                 return *xBegin_;
@@ -126,28 +134,35 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return xLocator_(xBegin_, xEnd_, x);
+            }
+            Size locateX(Real x, Size& hint) const {
+                #if defined(QL_EXTRA_SAFETY_CHECKS)
+                for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
+                    QL_REQUIRE(*j > *i, "unsorted x values");
+                #endif
+                return xLocator_(xBegin_, xEnd_, x, hint);
             }
             Size locateY(Real y) const {
                 #if defined(QL_EXTRA_SAFETY_CHECKS)
                 for (I2 k=yBegin_, l=yBegin_+1; l!=yEnd_; ++k, ++l)
                     QL_REQUIRE(*l > *k, "unsorted y values");
                 #endif
-                if (y < *yBegin_)
-                    return 0;
-                else if (y > *(yEnd_-1))
-                    return yEnd_-yBegin_-2;
-                else
-                    return std::upper_bound(yBegin_,yEnd_-1,y)-yBegin_-1;
+                return yLocator_(yBegin_, yEnd_, y);
+            }
+            Size locateY(Real y, Size& hint) const {
+                #if defined(QL_EXTRA_SAFETY_CHECKS)
+                for (I2 k=yBegin_, l=yBegin_+1; l!=yEnd_; ++k, ++l)
+                    QL_REQUIRE(*l > *k, "unsorted y values");
+                #endif
+                return yLocator_(yBegin_, yEnd_, y, hint);
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_, yEnd_;
             const M& zData_;
+          private:
+            detail::GridLocator<I1> xLocator_;
+            detail::GridLocator<I2> yLocator_;
         };
       public:
         Interpolation2D() {}
@@ -156,6 +171,16 @@ namespace QuantLib {
             checkRange(x,y,allowExtrapolation);
             return impl_->value(x,y);
         }
+        /*! Interpolates at the n points (x[0], y[0]), ...,
+            (x[n-1], y[n-1]) and writes the results to z, which must
+            be allocated by the caller.
+        */
+        void operator()(const Real* x, const Real* y, Real* z, Size n,
+                        bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],y[i],allowExtrapolation);
+            impl_->values(x, y, z, n);
+        }
         Real xMin() const {
             return impl_->xMin();
         }
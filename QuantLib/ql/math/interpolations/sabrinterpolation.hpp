@@ -229,25 +229,27 @@ namespace QuantLib {
             }
             // calculate total squared weighted difference (L2 norm)
             Real interpolationSquaredError() const {
+                const SabrVolatilityEvaluator sabr = evaluator();
                 Real error, totalError = 0.0;
                 std::vector<Real>::const_iterator x = this->xBegin_;
                 std::vector<Real>::const_iterator y = this->yBegin_;
                 std::vector<Real>::const_iterator w = weights_.begin();
                 for (; x != this->xEnd_; ++x, ++y, ++w) {
-                    error = (value(*x) - *y);
+                    error = (value(sabr, *x) - *y);
                     totalError += error*error * (*w);
                 }
                 return totalError;
             }
             // calculate weighted differences
             Disposable<Array> interpolationErrors(const Array&) const {
+                const SabrVolatilityEvaluator sabr = evaluator();
                 Array results(this->xEnd_ - this->xBegin_);
                 std::vector<Real>::const_iterator x = this->xBegin_;
                 Array::iterator r = results.begin();
                 std::vector<Real>::const_iterator y = this->yBegin_;
                 std::vector<Real>::const_iterator w = weights_.begin();
                 for (; x != this->xEnd_; ++x, ++r, ++w, ++y) {
-                    *r = (value(*x) - *y)* std::sqrt(*w);
+                    *r = (value(sabr, *x) - *y)* std::sqrt(*w);
                 }
                 return results;
             }
@@ -262,13 +264,26 @@ namespace QuantLib {
                 Real error, maxError = QL_MIN_REAL;
                 I1 i = this->xBegin_;
                 I2 j = this->yBegin_;
+                const SabrVolatilityEvaluator sabr = evaluator();
                 for (; i != this->xEnd_; ++i, ++j) {
-                    error = std::fabs(value(*i) - *j);
+                    error = std::fabs(value(sabr, *i) - *j);
                     maxError = std::max(maxError, error);
                 }
                 return maxError;
             }
           private:
+            // the smile is evaluated on all the strikes for each set
+            // of parameters tried by the optimizer; forward, expiry
+            // and parameters are validated once per set
+            SabrVolatilityEvaluator evaluator() const {
+                return SabrVolatilityEvaluator(forward_, t_, alpha_, beta_,
+                                               nu_, rho_);
+            }
+            Real value(const SabrVolatilityEvaluator& sabr, Real x) const {
+                QL_REQUIRE(x>0.0, "strike must be positive: " <<
+                                  io::rate(x) << " not allowed");
+                return sabr(x);
+            }
             class SabrParametersTransformation :
                   public ParametersTransformation {
                      mutable Array y_;
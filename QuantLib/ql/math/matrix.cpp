@@ -22,6 +22,8 @@
 */
 
 #include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
+#include <vector>
 #if defined(QL_PATCH_MSVC)
 #pragma warning(push)
 #pragma warning(disable:4180)
@@ -39,8 +41,85 @@
 
 namespace QuantLib {
 
+    const Disposable<Matrix> operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        Matrix result(m1.rows(), m2.columns(), 0.0);
+        if (result.empty() || m1.columns() == 0)
+            return result;
+
+        #if defined(QL_USE_LAPACK)
+
+        // the transpose of the result is calculated as m2^T * m1^T
+        const detail::lapack_int m = m2.columns(), n = m1.rows(),
+                                 k = m1.columns();
+        const double one = 1.0, zero = 0.0;
+        dgemm_("N", "N", &m, &n, &k, &one, m2.begin(), &m,
+               m1.begin(), &k, &zero, result.begin(), &m, 1, 1);
+
+        #else
+
+        /* Rows of the result are accumulated as linear combinations
+           of the rows of m2, which are accessed sequentially; the
+           loops are blocked so that the rows in use stay in cache.
+           The sum for each element is performed in the same order
+           as in the inner product of row and column.
+        */
+        const Size blockSize = 64;
+        const Size rows = m1.rows(), columns = m2.columns(),
+                   inner = m1.columns();
+        for (Size k0=0; k0<inner; k0+=blockSize) {
+            Size k1 = std::min(k0+blockSize, inner);
+            for (Size j0=0; j0<columns; j0+=blockSize) {
+                Size j1 = std::min(j0+blockSize, columns);
+                for (Size i=0; i<rows; i++) {
+                    Matrix::row_iterator r = result.row_begin(i);
+                    for (Size k=k0; k<k1; k++) {
+                        Real a = m1[i][k];
+                        Matrix::const_row_iterator b = m2.row_begin(k);
+                        for (Size j=j0; j<j1; j++)
+                            r[j] += a*b[j];
+                    }
+                }
+            }
+        }
+
+        #endif
+
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
-        #if !defined(QL_NO_UBLAS_SUPPORT)
+        #if defined(QL_USE_LAPACK)
+
+        QL_REQUIRE(m.rows() == m.columns(), "matrix is not square");
+
+        // the inverse of the transpose is the transpose of the inverse
+        Matrix result = m;
+        const detail::lapack_int n = m.rows();
+        if (n == 0)
+            return result;
+        std::vector<detail::lapack_int> pivots(n);
+        detail::lapack_int info;
+        dgetrf_(&n, &n, result.begin(), &n, &pivots[0], &info);
+        QL_REQUIRE(info >= 0, "invalid argument passed to dgetrf");
+        QL_REQUIRE(info == 0, "singular matrix given");
+
+        detail::lapack_int lwork = -1;
+        double size;
+        dgetri_(&n, result.begin(), &n, &pivots[0], &size, &lwork, &info);
+        lwork = std::max<detail::lapack_int>(
+                                  static_cast<detail::lapack_int>(size), n);
+        std::vector<double> work(lwork);
+        dgetri_(&n, result.begin(), &n, &pivots[0], &work[0], &lwork, &info);
+        QL_REQUIRE(info == 0, "singular matrix given");
+
+        return result;
+
+        #elif !defined(QL_NO_UBLAS_SUPPORT)
 
         QL_REQUIRE(m.rows() == m.columns(), "matrix is not square");
 
@@ -73,7 +152,30 @@ namespace QuantLib {
     }
 
     Real determinant(const Matrix& m) {
-        #if !defined(QL_NO_UBLAS_SUPPORT)
+        #if defined(QL_USE_LAPACK)
+        QL_REQUIRE(m.rows() == m.columns(), "matrix is not square");
+
+        // the determinant of the transpose is the same
+        Matrix a = m;
+        const detail::lapack_int n = m.rows();
+        if (n == 0)
+            return 1.0;
+        std::vector<detail::lapack_int> pivots(n);
+        detail::lapack_int info;
+        dgetrf_(&n, &n, a.begin(), &n, &pivots[0], &info);
+        QL_REQUIRE(info >= 0, "invalid argument passed to dgetrf");
+
+        Real retVal = 1.0;
+        for (detail::lapack_int i=0; i < n; ++i) {
+            // pivot indices are 1-based
+            if (pivots[i] != i+1)
+                retVal *= -a[i][i];
+            else
+                retVal *=  a[i][i];
+        }
+        return retVal;
+
+        #elif !defined(QL_NO_UBLAS_SUPPORT)
         QL_REQUIRE(m.rows() == m.columns(), "matrix is not square");
 
         boost::numeric::ublas::matrix<Real> a(m.rows(), m.columns());
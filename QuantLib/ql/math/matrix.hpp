@@ -520,29 +520,20 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
-                                              const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns());
-        for (Size i=0; i<result.rows(); i++)
-            for (Size j=0; j<result.columns(); j++)
-                result[i][j] =
-                    std::inner_product(m1.row_begin(i), m1.row_end(i),
-                                       m2.column_begin(j), 0.0);
-        return result;
-    }
-
     inline const Disposable<Matrix> transpose(const Matrix& m) {
         Matrix result(m.columns(),m.rows());
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (!m.empty())
-        #endif
-        for (Size i=0; i<m.rows(); i++)
-            std::copy(m.row_begin(i),m.row_end(i),result.column_begin(i));
+        // copy by square blocks, so that both the rows being read
+        // and those being written stay in cache
+        const Size blockSize = 32;
+        for (Size i0=0; i0<m.rows(); i0+=blockSize) {
+            Size i1 = std::min(i0+blockSize, m.rows());
+            for (Size j0=0; j0<m.columns(); j0+=blockSize) {
+                Size j1 = std::min(j0+blockSize, m.columns());
+                for (Size i=i0; i<i1; i++)
+                    for (Size j=j0; j<j1; j++)
+                        result[j][i] = m[i][j];
+            }
+        }
         return result;
     }
 
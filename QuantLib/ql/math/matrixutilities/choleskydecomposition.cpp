@@ -18,6 +18,8 @@
 */
 
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -34,6 +36,22 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
+        #if defined(QL_USE_LAPACK)
+        if (!flexible && size > 0) {
+            // the upper factor U of the transpose (i.e., of S itself)
+            // is stored by LAPACK by columns, i.e., as L = U^T by rows
+            Matrix result = S;
+            const detail::lapack_int n = size;
+            detail::lapack_int info;
+            dpotrf_("U", &n, result.begin(), &n, &info, 1);
+            QL_REQUIRE(info >= 0, "invalid argument passed to dpotrf");
+            QL_REQUIRE(info == 0, "input matrix is not positive definite");
+            for (i=0; i<size; i++)
+                std::fill(result.row_begin(i)+i+1, result.row_end(i), 0.0);
+            return result;
+        }
+        #endif
+
         Matrix result(size, size, 0.0);
         Real sum;
         for (i=0; i<size; i++) {
@@ -0,0 +1,238 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/utilities/parallel.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+        const long minParallelSize = 10000;
+    }
+
+    CompressedRowMatrix::CompressedRowMatrix()
+    : rows_(0), columns_(0), rowOffsets_(1, 0) {}
+
+    CompressedRowMatrix::CompressedRowMatrix(
+                                       Size rows, Size columns,
+                                       const std::vector<Size>& rowOffsets,
+                                       const std::vector<Size>& columnIndices,
+                                       const std::vector<Real>& values)
+    : rows_(rows), columns_(columns), rowOffsets_(rowOffsets),
+      columnIndices_(columnIndices), values_(values) {
+        QL_REQUIRE(rowOffsets_.size() == rows_+1,
+                   "wrong number of row offsets (" << rowOffsets_.size()
+                   << ") for " << rows_ << " rows");
+        QL_REQUIRE(columnIndices_.size() == values_.size(),
+                   "the number of column indices (" << columnIndices_.size()
+                   << ") differs from the number of values ("
+                   << values_.size() << ")");
+        QL_REQUIRE(rowOffsets_.front() == 0 &&
+                   rowOffsets_.back() == values_.size(),
+                   "row offsets inconsistent with the number of values");
+        for (Size i=0; i<rows_; ++i) {
+            QL_REQUIRE(rowOffsets_[i] <= rowOffsets_[i+1],
+                       "decreasing row offsets at row " << i);
+            for (Size k=rowOffsets_[i]; k<rowOffsets_[i+1]; ++k) {
+                QL_REQUIRE(columnIndices_[k] < columns_,
+                           "column index " << columnIndices_[k]
+                           << " out of range at row " << i);
+                QL_REQUIRE(k == rowOffsets_[i] ||
+                           columnIndices_[k-1] < columnIndices_[k],
+                           "column indices not increasing at row " << i);
+            }
+        }
+    }
+
+    #if !defined(QL_NO_UBLAS_SUPPORT)
+    CompressedRowMatrix::CompressedRowMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowOffsets_(m.size1()+1) {
+        // uBLAS might not store the offsets of trailing empty rows
+        const Size filledRows = m.filled1();
+        const Size filled = m.filled2();
+        for (Size i=0; i<=rows_; ++i)
+            rowOffsets_[i] = (i < filledRows) ? m.index1_data()[i] : filled;
+        columnIndices_.assign(m.index2_data().begin(),
+                              m.index2_data().begin() + filled);
+        values_.assign(m.value_data().begin(),
+                       m.value_data().begin() + filled);
+    }
+    #endif
+
+    Real CompressedRowMatrix::operator()(Size i, Size j) const {
+        Size k = position(i, j);
+        return k == Null<Size>() ? 0.0 : values_[k];
+    }
+
+    Size CompressedRowMatrix::position(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "element (" << i << ", " << j << ") out of range");
+        std::vector<Size>::const_iterator begin =
+            columnIndices_.begin() + rowOffsets_[i];
+        std::vector<Size>::const_iterator end =
+            columnIndices_.begin() + rowOffsets_[i+1];
+        std::vector<Size>::const_iterator k =
+            std::lower_bound(begin, end, j);
+        if (k == end || *k != j)
+            return Null<Size>();
+        return k - columnIndices_.begin();
+    }
+
+    Disposable<Array> CompressedRowMatrix::apply(const Array& x) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "array of size " << x.size() << " cannot be multiplied "
+                   "by a matrix with " << columns_ << " columns");
+
+        Array y(rows_);
+        const Size* offsets = rows_ > 0 ? &rowOffsets_[0] : 0;
+        const Size* indices = values_.empty() ? 0 : &columnIndices_[0];
+        const Real* values = values_.empty() ? 0 : &values_[0];
+
+        const long n = rows_;
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(long(values_.size()) >= minParallelSize)
+        #endif
+        for (long i=0; i<n; ++i) {
+            Real sum = 0.0;
+            for (Size k=offsets[i]; k<offsets[i+1]; ++k)
+                sum += values[k]*x[indices[k]];
+            y[i] = sum;
+        }
+        return y;
+    }
+
+    const CompressedRowMatrix& CompressedRowMatrix::operator*=(Real x) {
+        for (Size k=0; k<values_.size(); ++k)
+            values_[k] *= x;
+        return *this;
+    }
+
+    void CompressedRowMatrix::swap(CompressedRowMatrix& from) {
+        std::swap(rows_, from.rows_);
+        std::swap(columns_, from.columns_);
+        rowOffsets_.swap(from.rowOffsets_);
+        columnIndices_.swap(from.columnIndices_);
+        values_.swap(from.values_);
+    }
+
+
+    const Disposable<CompressedRowMatrix> operator+(
+                                            const CompressedRowMatrix& m1,
+                                            const CompressedRowMatrix& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() && m1.columns() == m2.columns(),
+                   "matrices with different sizes ("
+                   << m1.rows() << "x" << m1.columns() << ", "
+                   << m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "added");
+
+        const std::vector<Size>& o1 = m1.rowOffsets();
+        const std::vector<Size>& o2 = m2.rowOffsets();
+        const std::vector<Size>& c1 = m1.columnIndices();
+        const std::vector<Size>& c2 = m2.columnIndices();
+        const std::vector<Real>& v1 = m1.values();
+        const std::vector<Real>& v2 = m2.values();
+
+        std::vector<Size> offsets(m1.rows()+1, 0), indices;
+        std::vector<Real> values;
+        indices.reserve(m1.nonZeros()+m2.nonZeros());
+        values.reserve(m1.nonZeros()+m2.nonZeros());
+
+        // the rows are merged as sorted sequences
+        for (Size i=0; i<m1.rows(); ++i) {
+            Size k1 = o1[i], k2 = o2[i];
+            while (k1 < o1[i+1] || k2 < o2[i+1]) {
+                if (k2 == o2[i+1] || (k1 < o1[i+1] && c1[k1] < c2[k2])) {
+                    indices.push_back(c1[k1]);
+                    values.push_back(v1[k1++]);
+                } else if (k1 == o1[i+1] || c2[k2] < c1[k1]) {
+                    indices.push_back(c2[k2]);
+                    values.push_back(v2[k2++]);
+                } else {
+                    indices.push_back(c1[k1]);
+                    values.push_back(v1[k1++] + v2[k2++]);
+                }
+            }
+            offsets[i+1] = values.size();
+        }
+
+        CompressedRowMatrix result(m1.rows(), m1.columns(),
+                                   offsets, indices, values);
+        return result;
+    }
+
+    const Disposable<CompressedRowMatrix> operator*(
+                                       const CompressedRowMatrix& m, Real x) {
+        CompressedRowMatrix result = m;
+        result *= x;
+        return result;
+    }
+
+    const Disposable<CompressedRowMatrix> operator*(
+                                       Real x, const CompressedRowMatrix& m) {
+        CompressedRowMatrix result = m;
+        result *= x;
+        return result;
+    }
+
+    const Disposable<CompressedRowMatrix> identityPlus(
+                                             Real alpha, Real beta,
+                                             const CompressedRowMatrix& m) {
+        QL_REQUIRE(m.rows() == m.columns(),
+                   "square matrix required (" << m.rows() << "x"
+                   << m.columns() << " given)");
+        const Size n = m.rows();
+        std::vector<Size> offsets(n+1), indices(n);
+        std::vector<Real> values(n, alpha);
+        for (Size i=0; i<n; ++i) {
+            offsets[i] = i;
+            indices[i] = i;
+        }
+        offsets[n] = n;
+        CompressedRowMatrix identity(n, n, offsets, indices, values);
+        CompressedRowMatrix result = identity + beta*m;
+        return result;
+    }
+
+    namespace detail {
+
+        void appendCompressedRow(const Size* columns, const Real* elements,
+                                 Size n, std::vector<Size>& columnIndices,
+                                 std::vector<Real>& values) {
+            const Size start = values.size();
+            for (Size k=0; k<n; ++k) {
+                // insertion into the sorted part of the row
+                Size p = values.size();
+                while (p > start && columnIndices[p-1] > columns[k])
+                    --p;
+                if (p > start && columnIndices[p-1] == columns[k]) {
+                    values[p-1] += elements[k];
+                } else {
+                    columnIndices.insert(columnIndices.begin()+p,
+                                         columns[k]);
+                    values.insert(values.begin()+p, elements[k]);
+                }
+            }
+        }
+
+    }
+
+}
+
@@ -0,0 +1,171 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compressedrowmatrix.hpp
+    \brief sparse matrix in compressed-row storage
+*/
+
+#ifndef quantlib_compressed_row_matrix_hpp
+#define quantlib_compressed_row_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed-row storage
+    /*! The non-zero elements of the matrix are stored row by row in
+        a single array, together with their column indices; the
+        elements of the \f$ i \f$-th row are found between positions
+        <tt>rowOffsets()[i]</tt> (included) and
+        <tt>rowOffsets()[i+1]</tt> (excluded.) Column indices must
+        be strictly increasing within each row.
+
+        The structure of the matrix cannot be modified after
+        construction, but the products with an array are performed
+        with contiguous access to the stored elements and can be
+        distributed among threads if the library is compiled with
+        OpenMP support.
+
+        \test the matrix assembled from a finite-difference operator
+              and the results of its product with an array are
+              checked against those of the corresponding uBLAS
+              sparse matrix.
+    */
+    class CompressedRowMatrix {
+      public:
+        //! \name Constructors
+        //@{
+        //! creates an empty matrix
+        CompressedRowMatrix();
+        //! creates the matrix from its compressed-row representation
+        CompressedRowMatrix(Size rows, Size columns,
+                            const std::vector<Size>& rowOffsets,
+                            const std::vector<Size>& columnIndices,
+                            const std::vector<Real>& values);
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        //! creates the matrix from a uBLAS sparse matrix
+        explicit CompressedRowMatrix(const SparseMatrix& m);
+        #endif
+        CompressedRowMatrix(const Disposable<CompressedRowMatrix>&);
+        CompressedRowMatrix& operator=(
+                                  const Disposable<CompressedRowMatrix>&);
+        //@}
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        const std::vector<Size>& rowOffsets() const { return rowOffsets_; }
+        const std::vector<Size>& columnIndices() const {
+            return columnIndices_;
+        }
+        const std::vector<Real>& values() const { return values_; }
+        //! returns 0 for elements which are not stored
+        Real operator()(Size i, Size j) const;
+        //! position of the given element, or Null<Size>() if not stored
+        Size position(Size i, Size j) const;
+        //@}
+        //! \name Algebraic operations
+        //@{
+        //! product with an array
+        Disposable<Array> apply(const Array& x) const;
+        const CompressedRowMatrix& operator*=(Real x);
+        //@}
+        //! \name Utilities
+        //@{
+        void swap(CompressedRowMatrix&);
+        //@}
+      private:
+        Size rows_, columns_;
+        std::vector<Size> rowOffsets_, columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    // algebraic operators
+
+    /*! \relates CompressedRowMatrix */
+    const Disposable<Array> prod(const CompressedRowMatrix&, const Array&);
+
+    /*! \relates CompressedRowMatrix */
+    const Disposable<CompressedRowMatrix> operator+(
+                                               const CompressedRowMatrix&,
+                                               const CompressedRowMatrix&);
+
+    /*! \relates CompressedRowMatrix */
+    const Disposable<CompressedRowMatrix> operator*(
+                                         const CompressedRowMatrix&, Real);
+
+    /*! \relates CompressedRowMatrix */
+    const Disposable<CompressedRowMatrix> operator*(
+                                         Real, const CompressedRowMatrix&);
+
+    //! returns the matrix \f$ \alpha I + \beta M \f$
+    /*! \relates CompressedRowMatrix */
+    const Disposable<CompressedRowMatrix> identityPlus(
+                                                   Real alpha, Real beta,
+                                                   const CompressedRowMatrix&);
+
+    // utilities
+
+    /*! \relates CompressedRowMatrix */
+    void swap(CompressedRowMatrix&, CompressedRowMatrix&);
+
+    namespace detail {
+
+        /* Appends to the given storage a row whose elements are given
+           in any order; elements with the same column index are added.
+           Used to assemble the matrices of finite-difference operators,
+           whose rows have a few elements and might repeat the same
+           column at the boundaries of the grid. */
+        void appendCompressedRow(const Size* columns, const Real* elements,
+                                 Size n, std::vector<Size>& columnIndices,
+                                 std::vector<Real>& values);
+
+    }
+
+
+    // inline definitions
+
+    inline CompressedRowMatrix::CompressedRowMatrix(
+                               const Disposable<CompressedRowMatrix>& from)
+    : rows_(0), columns_(0) {
+        swap(const_cast<Disposable<CompressedRowMatrix>&>(from));
+    }
+
+    inline CompressedRowMatrix& CompressedRowMatrix::operator=(
+                               const Disposable<CompressedRowMatrix>& from) {
+        swap(const_cast<Disposable<CompressedRowMatrix>&>(from));
+        return *this;
+    }
+
+    inline const Disposable<Array> prod(const CompressedRowMatrix& m,
+                                        const Array& x) {
+        return m.apply(x);
+    }
+
+    inline void swap(CompressedRowMatrix& m1, CompressedRowMatrix& m2) {
+        m1.swap(m2);
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,151 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.cpp
+    \brief generalized minimal residual method
+*/
+
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    GMRES::GMRES(const GMRES::MatrixMult& A, Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(A), M_(preConditioner), maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater than zero");
+    }
+
+    GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
+        GMRESResult result = solveImpl(b, x0);
+
+        QL_REQUIRE(result.errors.back() < relTol_, "could not converge");
+
+        return result;
+    }
+
+    GMRESResult GMRES::solveWithRestart(Size restart, const Array& b,
+                                        const Array& x0) const {
+        GMRESResult result = solveImpl(b, x0);
+
+        for (Size i=0; i < restart && result.errors.back() >= relTol_; ++i) {
+            const GMRESResult next = solveImpl(b, result.x);
+            result.errors.insert(result.errors.end(),
+                                 ++next.errors.begin(), next.errors.end());
+            result.x = next.x;
+        }
+
+        QL_REQUIRE(result.errors.back() < relTol_, "could not converge");
+
+        return result;
+    }
+
+    GMRESResult GMRES::solveImpl(const Array& b, const Array& x0) const {
+        const Real bn = norm2(b);
+        if (bn == 0.0) {
+            GMRESResult result = { std::list<Real>(1, 0.0), b };
+            return result;
+        }
+
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        Array r = b - A_(x);
+
+        const Real beta = norm2(r);
+
+        GMRESResult result = { std::list<Real>(1, beta/bn), Array() };
+        if (beta/bn < relTol_) {
+            result.x = x;
+            return result;
+        }
+
+        // Arnoldi basis, Hessenberg matrix reduced to triangular form
+        // by Givens rotations, and rotated right-hand side
+        std::vector<Array> v(1, r/beta);
+        Matrix h(maxIter_+1, maxIter_, 0.0);
+        Array c(maxIter_), s(maxIter_), g(maxIter_+1, 0.0);
+        g[0] = beta;
+
+        Size k = 0;
+        while (k < maxIter_) {
+            Array w = (M_) ? A_(M_(v[k])) : A_(v[k]);
+
+            // modified Gram-Schmidt orthogonalization
+            for (Size i=0; i <= k; ++i) {
+                h[i][k] = DotProduct(w, v[i]);
+                w -= h[i][k]*v[i];
+            }
+            h[k+1][k] = norm2(w);
+
+            for (Size i=0; i < k; ++i) {
+                const Real tmp = c[i]*h[i][k] + s[i]*h[i+1][k];
+                h[i+1][k] = -s[i]*h[i][k] + c[i]*h[i+1][k];
+                h[i][k] = tmp;
+            }
+
+            const Real nu = std::sqrt(h[k][k]*h[k][k] + h[k+1][k]*h[k+1][k]);
+            const bool breakdown = (h[k+1][k] == 0.0);
+            if (!breakdown)
+                v.push_back(w/h[k+1][k]);
+
+            if (nu == 0.0) {
+                // the basis cannot be extended any further
+                break;
+            }
+            c[k] = h[k][k]/nu;
+            s[k] = h[k+1][k]/nu;
+            h[k][k] = nu;
+            h[k+1][k] = 0.0;
+
+            g[k+1] = -s[k]*g[k];
+            g[k] = c[k]*g[k];
+
+            ++k;
+            result.errors.push_back(std::fabs(g[k])/bn);
+
+            if (result.errors.back() < relTol_ || breakdown)
+                break;
+        }
+
+        // back substitution for the minimizing combination
+        Array y(k);
+        for (Size i=k; i > 0; --i) {
+            Real sum = g[i-1];
+            for (Size j=i; j < k; ++j)
+                sum -= h[i-1][j]*y[j];
+            y[i-1] = sum/h[i-1][i-1];
+        }
+
+        Array z(b.size(), 0.0);
+        for (Size i=0; i < k; ++i)
+            z += y[i]*v[i];
+
+        if (M_)
+            result.x = x + M_(z);
+        else
+            result.x = x + z;
+
+        return result;
+    }
+
+    Real GMRES::norm2(const Array& a) const {
+        return std::sqrt(DotProduct(a, a));
+    }
+}
+
@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.hpp
+    \brief generalized minimal residual method
+*/
+
+#ifndef quantlib_gmres_hpp
+#define quantlib_gmres_hpp
+
+#include <ql/math/array.hpp>
+#include <boost/function.hpp>
+#include <list>
+
+namespace QuantLib {
+
+    struct GMRESResult {
+        //! relative residuals, starting from the initial guess
+        std::list<Real> errors;
+        Array x;
+    };
+
+    //! generalized minimal residual method
+    /*! Solves \f$ Ax = b \f$ by minimizing the residual over Krylov
+        subspaces of increasing dimension, up to the given maximum
+        number of iterations; the restarted variant repeats the
+        process starting from the last solution. As for BiCGstab,
+        the matrix and the (right) preconditioner are given as
+        functions returning their product with an array.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html
+
+        \test the solver is checked against the product with the
+              matrix for a Heston implicit step, with and without
+              restarts.
+    */
+    class GMRES  {
+      public:
+        typedef boost::function1<Disposable<Array> , const Array& > MatrixMult;
+
+        GMRES(const MatrixMult& A, Size maxIter, Real relTol,
+              const MatrixMult& preConditioner = MatrixMult());
+
+        GMRESResult solve(const Array& b, const Array& x0 = Array()) const;
+        GMRESResult solveWithRestart(Size restart, const Array& b,
+                                     const Array& x0 = Array()) const;
+
+      protected:
+        GMRESResult solveImpl(const Array& b, const Array& x0) const;
+        Real norm2(const Array& a) const;
+
+        const MatrixMult A_, M_;
+        const Size maxIter_;
+        const Real relTol_;
+    };
+}
+
+#endif
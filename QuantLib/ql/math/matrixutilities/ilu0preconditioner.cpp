@@ -0,0 +1,100 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/ilu0preconditioner.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    ILU0Preconditioner::ILU0Preconditioner(const CompressedRowMatrix& A)
+    : diagonal_(A.rows()) {
+
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "ILU(0) preconditioner works only with square matrices");
+
+        const Size n = A.rows();
+        const std::vector<Size>& offsets = A.rowOffsets();
+        const std::vector<Size>& indices = A.columnIndices();
+        std::vector<Real> lu = A.values();
+
+        for (Size i=0; i<n; ++i) {
+            diagonal_[i] = A.position(i, i);
+            QL_REQUIRE(diagonal_[i] != Null<Size>(),
+                       "diagonal element missing at row " << i);
+        }
+
+        // position in the current row of each column, if stored
+        std::vector<Size> position(n, Null<Size>());
+
+        // IKJ variant of Gaussian elimination restricted to the
+        // pattern of the matrix (Saad, algorithm 10.4)
+        for (Size i=0; i<n; ++i) {
+            for (Size p=offsets[i]; p<offsets[i+1]; ++p)
+                position[indices[p]] = p;
+
+            for (Size p=offsets[i]; p<diagonal_[i]; ++p) {
+                const Size k = indices[p];
+                const Real pivot = lu[diagonal_[k]];
+                QL_REQUIRE(pivot != 0.0, "null pivot at row " << k);
+                const Real l = (lu[p] /= pivot);
+                for (Size q=diagonal_[k]+1; q<offsets[k+1]; ++q) {
+                    const Size j = position[indices[q]];
+                    if (j != Null<Size>())
+                        lu[j] -= l*lu[q];
+                }
+            }
+            QL_REQUIRE(lu[diagonal_[i]] != 0.0, "null pivot at row " << i);
+
+            for (Size p=offsets[i]; p<offsets[i+1]; ++p)
+                position[indices[p]] = Null<Size>();
+        }
+
+        LU_ = CompressedRowMatrix(n, n, offsets, indices, lu);
+    }
+
+    Disposable<Array> ILU0Preconditioner::apply(const Array& b) const {
+        const Size n = LU_.rows();
+        QL_REQUIRE(b.size() == n,
+                   "array of size " << b.size() << " given for a "
+                   << n << "x" << n << " preconditioner");
+
+        const std::vector<Size>& offsets = LU_.rowOffsets();
+        const std::vector<Size>& indices = LU_.columnIndices();
+        const std::vector<Real>& lu = LU_.values();
+
+        Array x(n);
+        // forward substitution with L
+        for (Size i=0; i<n; ++i) {
+            Real sum = b[i];
+            for (Size p=offsets[i]; p<diagonal_[i]; ++p)
+                sum -= lu[p]*x[indices[p]];
+            x[i] = sum;
+        }
+        // backward substitution with U
+        for (Size i=n; i>0; --i) {
+            Real sum = x[i-1];
+            for (Size p=diagonal_[i-1]+1; p<offsets[i]; ++p)
+                sum -= lu[p]*x[indices[p]];
+            x[i-1] = sum/lu[diagonal_[i-1]];
+        }
+        return x;
+    }
+
+}
+
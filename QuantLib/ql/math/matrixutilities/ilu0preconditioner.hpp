@@ -0,0 +1,67 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ilu0preconditioner.hpp
+    \brief incomplete LU preconditioner without fill-in
+*/
+
+#ifndef quantlib_ilu0_preconditioner_hpp
+#define quantlib_ilu0_preconditioner_hpp
+
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
+
+namespace QuantLib {
+
+    //! incomplete LU preconditioner without fill-in
+    /*! The factors \f$ L \f$ (with unit diagonal) and \f$ U \f$ have
+        the same sparsity pattern as the given matrix \f$ A \f$ and
+        are stored together in a single compressed-row matrix; their
+        product equals \f$ A \f$ on the stored elements. The apply()
+        method returns the solution of \f$ LUx = b \f$, which
+        approximates \f$ A^{-1}b \f$ and can be passed as a
+        preconditioner to the BiCGstab and GMRES solvers.
+
+        The diagonal elements of the matrix must be stored and the
+        factorization must not produce null pivots; this is the case,
+        e.g., for diagonally dominant matrices such as those of
+        implicit finite-difference steps.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html
+
+        \test the preconditioner is used for the GMRES and BiCGstab
+              solution of a Heston implicit step and the results are
+              checked against the product with the matrix.
+    */
+    class ILU0Preconditioner {
+      public:
+        explicit ILU0Preconditioner(const CompressedRowMatrix& A);
+        //! the factors, stored in the pattern of the matrix
+        const CompressedRowMatrix& LU() const { return LU_; }
+        Disposable<Array> apply(const Array& b) const;
+      private:
+        CompressedRowMatrix LU_;
+        std::vector<Size> diagonal_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lapack.hpp
+    \brief declarations of the BLAS/LAPACK routines used by the library
+
+    The routines are used only if QL_USE_LAPACK is defined; they are
+    declared here with the Fortran calling convention, which is
+    exported by all BLAS/LAPACK implementations, so that no CBLAS or
+    LAPACKE headers are required. Character arguments are followed
+    by their hidden lengths, as expected by most Fortran compilers;
+    the extra arguments are harmless for the others.
+
+    Matrices are stored by rows in the library and by columns in
+    LAPACK; therefore, the routines see the transpose of the matrices
+    passed to them.
+*/
+
+#ifndef quantlib_lapack_hpp
+#define quantlib_lapack_hpp
+
+#include <ql/qldefines.hpp>
+
+#if defined(QL_USE_LAPACK)
+
+#include <ql/types.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <cstddef>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        BOOST_STATIC_ASSERT((boost::is_same<Real,double>::value));
+
+        typedef int lapack_int;
+        typedef std::size_t lapack_strlen;
+
+    }
+
+}
+
+extern "C" {
+
+    void dgemm_(const char* transa, const char* transb,
+                const QuantLib::detail::lapack_int* m,
+                const QuantLib::detail::lapack_int* n,
+                const QuantLib::detail::lapack_int* k,
+                const double* alpha,
+                const double* a, const QuantLib::detail::lapack_int* lda,
+                const double* b, const QuantLib::detail::lapack_int* ldb,
+                const double* beta,
+                double* c, const QuantLib::detail::lapack_int* ldc,
+                QuantLib::detail::lapack_strlen,
+                QuantLib::detail::lapack_strlen);
+
+    void dgetrf_(const QuantLib::detail::lapack_int* m,
+                 const QuantLib::detail::lapack_int* n,
+                 double* a, const QuantLib::detail::lapack_int* lda,
+                 QuantLib::detail::lapack_int* ipiv,
+                 QuantLib::detail::lapack_int* info);
+
+    void dgetri_(const QuantLib::detail::lapack_int* n,
+                 double* a, const QuantLib::detail::lapack_int* lda,
+                 const QuantLib::detail::lapack_int* ipiv,
+                 double* work, const QuantLib::detail::lapack_int* lwork,
+                 QuantLib::detail::lapack_int* info);
+
+    void dpotrf_(const char* uplo,
+                 const QuantLib::detail::lapack_int* n,
+                 double* a, const QuantLib::detail::lapack_int* lda,
+                 QuantLib::detail::lapack_int* info,
+                 QuantLib::detail::lapack_strlen);
+
+    void dsyevd_(const char* jobz, const char* uplo,
+                 const QuantLib::detail::lapack_int* n,
+                 double* a, const QuantLib::detail::lapack_int* lda,
+                 double* w,
+                 double* work, const QuantLib::detail::lapack_int* lwork,
+                 QuantLib::detail::lapack_int* iwork,
+                 const QuantLib::detail::lapack_int* liwork,
+                 QuantLib::detail::lapack_int* info,
+                 QuantLib::detail::lapack_strlen,
+                 QuantLib::detail::lapack_strlen);
+
+    void dgesvd_(const char* jobu, const char* jobvt,
+                 const QuantLib::detail::lapack_int* m,
+                 const QuantLib::detail::lapack_int* n,
+                 double* a, const QuantLib::detail::lapack_int* lda,
+                 double* s,
+                 double* u, const QuantLib::detail::lapack_int* ldu,
+                 double* vt, const QuantLib::detail::lapack_int* ldvt,
+                 double* work, const QuantLib::detail::lapack_int* lwork,
+                 QuantLib::detail::lapack_int* info,
+                 QuantLib::detail::lapack_strlen,
+                 QuantLib::detail::lapack_strlen);
+
+}
+
+#endif
+
+#endif
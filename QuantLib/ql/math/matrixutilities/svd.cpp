@@ -34,6 +34,8 @@
 
 
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -91,6 +93,34 @@ namespace QuantLib {
 
         // we're sure that m_ >= n_
 
+        #if defined(QL_USE_LAPACK)
+
+        /* LAPACK sees A^T (n_ x m_) and decomposes it as
+           A^T = U' S V'^T, so that A = V' S U'^T. Stored by columns,
+           V'^T (n_ x m_) is V' by rows, i.e., our U; U' (n_ x n_) is
+           U'^T by rows and must be transposed to give our V.
+        */
+        s_ = Array(n_);
+        U_ = Matrix(m_, n_);
+        Matrix Ut(n_, n_);
+        const detail::lapack_int m = n_, n = m_;
+        detail::lapack_int lwork = -1, info;
+        double workSize;
+        dgesvd_("S", "S", &m, &n, A.begin(), &m, s_.begin(),
+                Ut.begin(), &m, U_.begin(), &m,
+                &workSize, &lwork, &info, 1, 1);
+        QL_REQUIRE(info == 0, "invalid argument passed to dgesvd");
+        lwork = static_cast<detail::lapack_int>(workSize);
+        std::vector<double> work(lwork);
+        dgesvd_("S", "S", &m, &n, A.begin(), &m, s_.begin(),
+                Ut.begin(), &m, U_.begin(), &m,
+                &work[0], &lwork, &info, 1, 1);
+        QL_ENSURE(info == 0, "singular value decomposition "
+                  "failed to converge");
+        V_ = transpose(Ut);
+
+        #else
+
         s_ = Array(n_);
         U_ = Matrix(m_,n_, 0.0);
         V_ = Matrix(n_,n_);
@@ -480,6 +510,8 @@ namespace QuantLib {
                 break;
             }
         }
+
+        #endif
     }
 
     const Matrix& SVD::U() const {
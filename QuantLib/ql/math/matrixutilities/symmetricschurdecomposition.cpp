@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -30,6 +31,30 @@ namespace QuantLib {
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
         Size size = s.rows();
+
+        #if defined(QL_USE_LAPACK)
+
+        // s is symmetric, so that its storage by rows and by columns
+        // is the same; the eigenvectors are returned as the columns
+        // of the LAPACK matrix, i.e., as rows in our storage.
+        Matrix a = s;
+        const detail::lapack_int n = size;
+        detail::lapack_int lwork = -1, liwork = -1, iworkSize, info;
+        double workSize;
+        dsyevd_("V", "L", &n, a.begin(), &n, diagonal_.begin(),
+                &workSize, &lwork, &iworkSize, &liwork, &info, 1, 1);
+        QL_REQUIRE(info == 0, "invalid argument passed to dsyevd");
+        lwork = static_cast<detail::lapack_int>(workSize);
+        liwork = iworkSize;
+        std::vector<double> work(lwork);
+        std::vector<detail::lapack_int> iwork(liwork);
+        dsyevd_("V", "L", &n, a.begin(), &n, diagonal_.begin(),
+                &work[0], &lwork, &iwork[0], &liwork, &info, 1, 1);
+        QL_ENSURE(info == 0, "eigenvalue calculation failed to converge");
+        eigenVectors_ = transpose(a);
+
+        #else
+
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
             eigenVectors_[q][q] = 1.0;
@@ -111,6 +136,8 @@ namespace QuantLib {
         QL_ENSURE(ite<=maxIterations,
                   "Too many iterations (" << maxIterations << ") reached");
 
+        #endif
+
 
         // sort (eigenvalues, eigenvectors)
         std::vector<std::pair<Real, std::vector<Real> > > temp(size);
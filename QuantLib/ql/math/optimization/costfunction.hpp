@@ -25,6 +25,7 @@
 #define quantlib_optimization_costfunction_h
 
 #include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -60,6 +61,26 @@ namespace QuantLib {
             return value(x);
         }
 
+        //! method to overload to compute J_f, the jacobian of
+        //  the cost function values with respect to x
+        /*! The default implementation uses central differences;
+            jac must be preallocated with as many rows as values
+            and as many columns as variables.
+        */
+        virtual void jacobian(Matrix& jac, const Array& x) const {
+            Real eps = finiteDifferenceEpsilon();
+            Array xx(x), fp, fm;
+            for (Size i=0; i<x.size(); ++i) {
+                xx[i] += eps;
+                fp = values(xx);
+                xx[i] -= 2.0*eps;
+                fm = values(xx);
+                for (Size j=0; j<fp.size(); ++j)
+                    jac[j][i] = 0.5*(fp[j] - fm[j])/eps;
+                xx[i] = x[i];
+            }
+        }
+
         //! Default epsilon for finite difference method :
         virtual Real finiteDifferenceEpsilon() const { return 1e-8; }
     };
@@ -26,8 +26,10 @@ namespace QuantLib {
 
     LevenbergMarquardt::LevenbergMarquardt(Real epsfcn,
                                            Real xtol,
-                                           Real gtol)
-    : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol) {}
+                                           Real gtol,
+                                           bool useCostFunctionsJacobian)
+    : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+      useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
 
     Integer LevenbergMarquardt::getInfo() const {
         return info_;
@@ -75,6 +77,10 @@ namespace QuantLib {
         // in n variables by the Levenberg-Marquardt algorithm.
         MINPACK::LmdifCostFunction lmdifCostFunction = 
             boost::bind(&LevenbergMarquardt::fcn, this, _1, _2, _3, _4, _5);
+        MINPACK::LmdifCostFunction lmdifJacFunction;
+        if (useCostFunctionsJacobian_)
+            lmdifJacFunction = boost::bind(&LevenbergMarquardt::jacFcn,
+                                           this, _1, _2, _3, _4, _5);
         MINPACK::lmdif(m, n, xx.get(), fvec.get(),
                        static_cast<double>(endCriteria.functionEpsilon()),
                        static_cast<double>(xtol_),
@@ -85,7 +91,7 @@ namespace QuantLib {
                        nprint, &info, &nfev, fjac.get(),
                        ldfjac, ipvt.get(), qtf.get(),
                        wa1.get(), wa2.get(), wa3.get(), wa4.get(),
-                       lmdifCostFunction);
+                       lmdifCostFunction, lmdifJacFunction);
         info_ = info;
         // check requirements & endCriteria evaluation
         QL_REQUIRE(info != 0, "MINPACK: improper input parameters");
@@ -123,5 +129,59 @@ namespace QuantLib {
         }
     }
 
-}
+    void LevenbergMarquardt::jacFcn(int m, int n, double* x,
+                                    double* fjac, int*) {
+        Array xt(n);
+        std::copy(x, x+n, xt.begin());
+        Matrix jac(m, n);
 
+        // the cost function might evaluate the points at a distance
+        // eps from xt; check them against the constraint first
+        const Real eps =
+            currentProblem_->costFunction().finiteDifferenceEpsilon();
+        const Constraint& constraint = currentProblem_->constraint();
+        std::vector<bool> up(n), down(n);
+        bool feasible = true;
+        Array xx(xt);
+        for (Size j=0; j<Size(n); ++j) {
+            xx[j] = xt[j] + eps;
+            up[j] = constraint.test(xx);
+            xx[j] = xt[j] - eps;
+            down[j] = constraint.test(xx);
+            xx[j] = xt[j];
+            feasible = feasible && up[j] && down[j];
+        }
+
+        if (feasible) {
+            currentProblem_->jacobian(jac, xt);
+        } else {
+            // central differences where possible, one-sided ones
+            // where a bump would violate the constraint
+            const Array f0 = currentProblem_->values(xt);
+            for (Size j=0; j<Size(n); ++j) {
+                Array fp = f0, fm = f0;
+                Real h = 0.0;
+                if (up[j]) {
+                    xx[j] = xt[j] + eps;
+                    fp = currentProblem_->values(xx);
+                    h += eps;
+                }
+                if (down[j]) {
+                    xx[j] = xt[j] - eps;
+                    fm = currentProblem_->values(xx);
+                    h += eps;
+                }
+                xx[j] = xt[j];
+                // no information if both bumps are infeasible
+                for (Size i=0; i<Size(m); ++i)
+                    jac[i][j] = h > 0.0 ? (fp[i]-fm[i])/h : 0.0;
+            }
+        }
+
+        // MINPACK stores the jacobian by columns
+        for (Size j=0; j<Size(n); ++j)
+            for (Size i=0; i<Size(m); ++i)
+                fjac[j*m+i] = jac[i][j];
+    }
+
+}
@@ -32,12 +32,23 @@ namespace QuantLib {
     /*! This implementation is based on MINPACK
         (<http://www.netlib.org/minpack>,
         <http://www.netlib.org/cephes/linalg.tgz>)
+
+        By default, the jacobian is approximated by forward
+        differences of the cost function values.  If
+        useCostFunctionsJacobian is true, it is obtained instead from
+        the jacobian() method of the cost function, which can be
+        overloaded to provide analytic derivatives. In the latter
+        case, if moving any variable by the finite-difference epsilon
+        of the cost function would violate the constraint, the
+        jacobian is calculated instead by finite differences, one-sided
+        for the variables close to the constraint.
     */
     class LevenbergMarquardt : public OptimizationMethod {
       public:
         LevenbergMarquardt(Real epsfcn = 1.0e-8,
                            Real xtol = 1.0e-8,
-                           Real gtol = 1.0e-8);
+                           Real gtol = 1.0e-8,
+                           bool useCostFunctionsJacobian = false);
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria //= EndCriteria()
                                            );
@@ -48,11 +59,17 @@ namespace QuantLib {
                  double* x,
                  double* fvec,
                  int* iflag);
+        void jacFcn(int m,
+                    int n,
+                    double* x,
+                    double* fjac,
+                    int* iflag);
       private:
         Problem* currentProblem_;
         Array initCostValues_;
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
+        const bool useCostFunctionsJacobian_;
     };
 
 }
@@ -36,13 +36,20 @@ namespace QuantLib {
                                       double*,
                                       int*)> LmdifCostFunction;
 
+        /*! If a jacobian function is given, it is called with the
+            same arguments as the cost function, except that the
+            output array is the m by n jacobian matrix stored by
+            columns; otherwise, the jacobian is approximated by
+            forward differences.
+        */
         void lmdif(int m,int n,double* x,double* fvec,double ftol,
                    double xtol,double gtol,int maxfev,double epsfcn,
                    double* diag, int mode, double factor,
                    int nprint, int* info,int* nfev,double* fjac,
                    int ldfjac,int* ipvt,double* qtf,
                    double* wa1,double* wa2,double* wa3,double* wa4,
-                   const LmdifCostFunction& fcn);
+                   const LmdifCostFunction& fcn,
+                   const LmdifCostFunction& jacFcn = LmdifCostFunction());
         
         void qrsolv(int n,double* r,int ldr,int* ipvt,
                     double* diag,double* qtb, double* x,
@@ -46,7 +46,8 @@ namespace QuantLib {
                 Constraint& constraint,
                 const Array& initialValue = Array())
         : costFunction_(costFunction), constraint_(constraint),
-          currentValue_(initialValue) {}
+          currentValue_(initialValue), functionEvaluation_(0),
+          gradientEvaluation_(0) {}
 
         /*! \warning it does not reset the current minumum to any initial value
         */
@@ -67,6 +68,11 @@ namespace QuantLib {
         Real valueAndGradient(Array& grad_f,
                               const Array& x);
 
+        //! call cost values jacobian computation and increment
+        //  gradient evaluation counter
+        void jacobian(Matrix& jac,
+                      const Array& x);
+
         //! Constraint
         Constraint& constraint() const { return constraint_; }
 
@@ -136,6 +142,12 @@ namespace QuantLib {
         return costFunction_.valueAndGradient(grad_f, x);
     }
 
+    inline void Problem::jacobian(Matrix& jac,
+                                  const Array& x) {
+        ++gradientEvaluation_;
+        costFunction_.jacobian(jac, x);
+    }
+
     inline void Problem::reset() {
         functionEvaluation_ = gradientEvaluation_ = 0;
         functionValue_ = squaredNorm_ = Null<Real>();
@@ -26,10 +26,48 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    //! sequence generator positioned a number of samples ahead
+    /*! Returns a generator for the substream starting \c offset
+        samples after the current position of the given one. Different
+        offsets yield substreams that can be drawn concurrently and
+        reproducibly, e.g., by different threads.
+
+        This generic version draws and discards the skipped samples;
+        overloads are provided for generators that can do better.
+    */
+    template <class SG>
+    SG sequenceSubstream(const SG& generator, Size offset) {
+        SG g(generator);
+        for (Size i=0; i<offset; ++i)
+            g.nextSequence();
+        return g;
+    }
+
+    //! applies an inverse cumulative distribution to a range of values
+    /*! This generic version calls the distribution on each value;
+        overloads are provided for distributions that can work on
+        whole ranges more efficiently.
+    */
+    template <class IC>
+    void inverseCumulativeValues(const IC& inverseCumulative,
+                                 const Real* begin, const Real* end,
+                                 Real* out) {
+        for (; begin != end; ++begin, ++out)
+            *out = inverseCumulative(*begin);
+    }
+
+    inline void inverseCumulativeValues(
+                                const InverseCumulativeNormal& inverseCumulative,
+                                const Real* begin, const Real* end,
+                                Real* out) {
+        inverseCumulative(begin, end, out);
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -63,6 +101,11 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        //! generator for the substream starting \c offset samples ahead
+        InverseCumulativeRsg substream(Size offset) const {
+            return InverseCumulativeRsg(
+                   sequenceSubstream(uniformSequenceGenerator_, offset), ICD_);
+        }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -87,15 +130,22 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        if (dimension_ > 0)
+            inverseCumulativeValues(ICD_, &sample.value[0],
+                                    &sample.value[0] + dimension_,
+                                    &x_.value[0]);
         return x_;
     }
 
+    template <class USG, class IC>
+    inline InverseCumulativeRsg<USG, IC>
+    sequenceSubstream(const InverseCumulativeRsg<USG, IC>& g, Size offset) {
+        return g.substream(offset);
+    }
+
 }
 
 
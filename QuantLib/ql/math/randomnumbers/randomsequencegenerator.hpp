@@ -24,6 +24,7 @@
 #ifndef quantlib_random_sequence_generator_h
 #define quantlib_random_sequence_generator_h
 
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
 #include <vector>
@@ -84,6 +85,30 @@ namespace QuantLib {
             return sequence_;
         }
         Size dimension() const {return dimensionality_;}
+        /*! returns an independent generator for the substream
+            starting \c offset samples ahead. Pseudo-random generators
+            cannot be skipped ahead efficiently; instead, the returned
+            generator is seeded with a value derived from the current
+            state of this one and from the offset, so that the result
+            is reproducible and different offsets give different
+            streams.
+        */
+        RandomSequenceGenerator substream(Size offset) const {
+            RNG rng(rng_);
+            std::vector<unsigned long> seeds(3);
+            seeds[0] = static_cast<unsigned long>(
+                                        rng.next().value*4294967296.0);
+            seeds[1] = static_cast<unsigned long>(offset & 0xffffffffUL);
+            seeds[2] = static_cast<unsigned long>(
+                               (static_cast<BigNatural>(offset) >> 16) >> 16);
+            MersenneTwisterUniformRng mixer(seeds);
+            unsigned long seed;
+            do {
+                // a null seed would select a random one
+                seed = mixer.nextInt32();
+            } while (seed == 0);
+            return RandomSequenceGenerator(dimensionality_, RNG(seed));
+        }
       private:
         Size dimensionality_;
         RNG rng_;
@@ -91,6 +116,12 @@ namespace QuantLib {
         mutable std::vector<BigNatural> int32Sequence_;
     };
 
+    template <class RNG>
+    inline RandomSequenceGenerator<RNG>
+    sequenceSubstream(const RandomSequenceGenerator<RNG>& g, Size offset) {
+        return g.substream(offset);
+    }
+
 }
 
 
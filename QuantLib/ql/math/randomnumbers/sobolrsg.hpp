@@ -116,6 +116,18 @@ namespace QuantLib {
                  DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(unsigned long n);
+        /*! returns a copy of this generator whose next sample is the
+            one which would be returned after skipping \c offset
+            samples; different offsets partition the sequence into
+            contiguous blocks which can be drawn concurrently.
+        */
+        SobolRsg substream(Size offset) const {
+            SobolRsg g(*this);
+            g.skipTo((firstDraw_ ? sequenceCounter_ : sequenceCounter_+1)
+                     + offset);
+            g.firstDraw_ = true;
+            return g;
+        }
         const std::vector<unsigned long>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const {
             const std::vector<unsigned long>& v = nextInt32Sequence();
@@ -137,6 +149,10 @@ namespace QuantLib {
         std::vector<std::vector<unsigned long> > directionIntegers_;
     };
 
+    inline SobolRsg sequenceSubstream(const SobolRsg& g, Size offset) {
+        return g.substream(offset);
+    }
+
 }
 
 #endif
@@ -26,6 +26,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 
 namespace QuantLib {
 
@@ -123,6 +124,16 @@ namespace QuantLib {
     */
     typedef GenericRiskStatistics<GaussianStatistics> RiskStatistics;
 
+    //! risk measures tool with bounded memory requirements
+    /*! Risk measures are calculated on the percentile sketch of
+        StreamingStatistics; see its documentation for error bounds.
+        It can be used in place of Statistics in large Monte Carlo
+        simulations.
+    */
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                       StreamingStatistics> >
+                                                     StreamingRiskStatistics;
+
 
 
     // inline definitions
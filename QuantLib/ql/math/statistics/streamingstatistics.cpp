@@ -0,0 +1,262 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Combines the central moments of two data sets; see
+        // P. Pebay, "Formulas for robust, one-pass parallel computation
+        // of covariances and arbitrary-order statistical moments",
+        // Sandia Report SAND2008-6212 (2008).
+        void mergeMoments(Real& wa, Real& ma,
+                          Real& m2a, Real& m3a, Real& m4a,
+                          Real wb, Real mb,
+                          Real m2b, Real m3b, Real m4b) {
+            if (wb == 0.0)
+                return;
+            if (wa == 0.0) {
+                wa = wb; ma = mb;
+                m2a = m2b; m3a = m3b; m4a = m4b;
+                return;
+            }
+            Real w = wa+wb, d = mb-ma, d2 = d*d;
+            Real m4 = m4a + m4b
+                + d2*d2*wa*wb*(wa*wa-wa*wb+wb*wb)/(w*w*w)
+                + 6.0*d2*(wa*wa*m2b+wb*wb*m2a)/(w*w)
+                + 4.0*d*(wa*m3b-wb*m3a)/w;
+            Real m3 = m3a + m3b
+                + d2*d*wa*wb*(wa-wb)/(w*w)
+                + 3.0*d*(wa*m2b-wb*m2a)/w;
+            Real m2 = m2a + m2b + d2*wa*wb/w;
+            ma += d*wb/w;
+            wa = w;
+            m2a = m2; m3a = m3; m4a = m4;
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Size compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression >= 10,
+                   "compression (" << compression << ") too small");
+        reset();
+    }
+
+    Real StreamingStatistics::mean() const {
+        QL_REQUIRE(samples() != 0, "empty sample set");
+        QL_REQUIRE(sampleWeight_ > 0.0,
+                   "sampleWeight_=0, unsufficient");
+        return mean_;
+    }
+
+    Real StreamingStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        QL_REQUIRE(sampleWeight_ > 0.0,
+                   "sampleWeight_=0, unsufficient");
+        return (m2_/sampleWeight_)*N/(N-1.0);
+    }
+
+    Real StreamingStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/sampleWeight_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real StreamingStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/sampleWeight_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(sampleWeight_ > 0.0,
+                   "empty sample set");
+
+        compress();
+
+        Real target = percent*sampleWeight_;
+
+        // The empirical distribution is interpolated linearly
+        // between the centers of the centroids; single samples are
+        // represented exactly, i.e., they cover the whole range of
+        // their weight. The extremes are known exactly as well.
+        Real x0 = 0.0, y0 = min_, integral = 0.0;
+        std::vector<Centroid>::const_iterator i;
+        for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+            Real x1, y1 = i->mean;
+            if (i->count == 1) {
+                x1 = integral;
+                if (target <= x1 + i->weight && target >= x1)
+                    return y1;
+            } else {
+                x1 = integral + 0.5*i->weight;
+            }
+            if (target <= x1) {
+                if (x1 == x0)
+                    return y1;
+                return y0 + (y1-y0)*(target-x0)/(x1-x0);
+            }
+            integral += i->weight;
+            x0 = (i->count == 1 ? integral : x1);
+            y0 = y1;
+        }
+        if (x0 >= sampleWeight_)
+            return max_;
+        return y0 + (max_-y0)*(target-x0)/(sampleWeight_-x0);
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        if (percent == 1.0)
+            return min();
+        return percentile(1.0-percent);
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0,
+                   "negative weight (" << weight << ") not allowed");
+
+        if (sampleNumber_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(value, min_);
+            max_ = std::max(value, max_);
+        }
+        ++sampleNumber_;
+
+        // null weights do not contribute to the distribution
+        if (weight > 0.0) {
+            mergeMoments(sampleWeight_, mean_, m2_, m3_, m4_,
+                         weight, value, 0.0, 0.0, 0.0);
+            buffer_.push_back(Centroid(value, weight, 1));
+            if (buffer_.size() >= 5*compression_)
+                compress();
+        }
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        if (&other == this) {
+            StreamingStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        if (other.sampleNumber_ == 0)
+            return;
+
+        if (sampleNumber_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(other.min_, min_);
+            max_ = std::max(other.max_, max_);
+        }
+        sampleNumber_ += other.sampleNumber_;
+
+        mergeMoments(sampleWeight_, mean_, m2_, m3_, m4_,
+                     other.sampleWeight_, other.mean_,
+                     other.m2_, other.m3_, other.m4_);
+
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        compress();
+    }
+
+    void StreamingStatistics::reset() {
+        sampleNumber_ = 0;
+        sampleWeight_ = 0.0;
+        mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+    }
+
+    Real StreamingStatistics::limit(Real q) const {
+        // scale function k(q) = delta/(2 pi) asin(2q-1); returns the
+        // largest quantile q' such that k(q')-k(q) <= 1.
+        Real k = std::asin(2.0*q-1.0) + 2.0*M_PI/compression_;
+        if (k >= M_PI_2)
+            return 1.0;
+        return 0.5*(std::sin(k)+1.0);
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end());
+
+        Real total = 0.0;
+        std::vector<Centroid>::const_iterator i;
+        for (i=buffer_.begin(); i!=buffer_.end(); ++i)
+            total += i->weight;
+
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        Real integral = 0.0, qLimit = limit(0.0);
+        for (i=buffer_.begin()+1; i!=buffer_.end(); ++i) {
+            Real q = (integral + current.weight + i->weight)/total;
+            if (q <= qLimit) {
+                current.weight += i->weight;
+                current.mean +=
+                    (i->mean-current.mean)*i->weight/current.weight;
+                current.count += i->count;
+            } else {
+                integral += current.weight;
+                centroids_.push_back(current);
+                qLimit = limit(integral/total);
+                current = *i;
+            }
+        }
+        centroids_.push_back(current);
+
+        buffer_.clear();
+    }
+
+}
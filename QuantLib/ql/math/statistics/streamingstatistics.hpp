@@ -0,0 +1,270 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded memory requirements
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+#include <vector>
+#include <utility>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory requirements
+    /*! This class accumulates a set of data and returns their
+        statistics without storing the samples; therefore, its memory
+        requirements do not grow with the number of samples and it is
+        suited to large Monte Carlo simulations.
+
+        Mean and higher moments are exact; they are accumulated as
+        central moments, which avoids the numerical instability of
+        IncrementalStatistics.
+
+        Percentiles and expectation values are calculated on a
+        t-digest sketch of the empirical distribution, i.e., a sorted
+        set of weighted centroids, see T. Dunning and O. Ertl,
+        <i>Computing extremely accurate quantiles using
+        t-digests</i> (2019). The size of each centroid is limited
+        according to its position in the distribution, so that
+        centroids near the tails are small: for a given compression
+        \f$ \delta \f$, the sketch contains at most \f$ \delta \f$
+        centroids and the rank of the returned \f$ y \f$-th
+        percentile differs from \f$ y \f$ by at most
+        \f$ \pi \sqrt{y(1-y)}/\delta \f$ (the error is usually much
+        smaller, since values are interpolated between centroids).
+        Expectation values are calculated by replacing each centroid
+        with a point mass at its mean; they are exact for functions
+        linear in each centroid and for ranges not splitting any
+        centroid.
+
+        Two instances can be merged; this allows one to accumulate
+        data on separate threads and to combine the results.
+
+        \test the returned moments are checked against those of
+              GeneralStatistics, and the returned percentiles and
+              risk measures against the error bounds above.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        StreamingStatistics(Size compression = 500);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Approximate expectation value of a function \f$ f \f$ on a
+            given range \f$ \mathcal{R} \f$, i.e.,
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] \approx
+                \frac{\sum_{c_j \in \mathcal{R}} f(c_j) w_j}{
+                      \sum_{c_j \in \mathcal{R}} w_j} \f]
+            where \f$ c_j \f$ and \f$ w_j \f$ are the means and the
+            weights of the centroids in the sketch.
+            The range is passed as a boolean function returning
+            <tt>true</tt> if the argument belongs to the range
+            or <tt>false</tt> otherwise.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+                Real x = i->mean, w = i->weight;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += i->count;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! approximate \f$ y \f$-th percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! approximate \f$ y \f$-th top percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression of the percentile sketch
+        Size compression() const;
+        //! current number of centroids in the percentile sketch
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        /*! The moments of the result are the same (up to rounding)
+            as if all data had been added to this instance; the
+            percentile sketch is within the same error bounds.
+        */
+        void merge(const StreamingStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Centroid(Real mean, Real weight, Size count)
+            : mean(mean), weight(weight), count(count) {}
+            Real mean, weight;
+            Size count;
+            bool operator<(const Centroid& c) const { return mean < c.mean; }
+        };
+        void compress() const;
+        Real limit(Real q) const;
+        Size compression_;
+        Size sampleNumber_;
+        Real sampleWeight_;
+        // central moments, i.e., sums of w_i (x_i-mean)^k
+        Real mean_, m2_, m3_, m4_;
+        Real min_, max_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+
+    // inline definitions
+
+    inline Size StreamingStatistics::samples() const {
+        return sampleNumber_;
+    }
+
+    inline Real StreamingStatistics::weightSum() const {
+        return sampleWeight_;
+    }
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real StreamingStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real StreamingStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    inline Size StreamingStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Size StreamingStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
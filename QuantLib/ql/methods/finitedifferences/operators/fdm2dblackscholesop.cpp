@@ -166,4 +166,15 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CompressedRowMatrix> >
+    Fdm2dBlackScholesOp::toCompressedRowMatrixDecomp() const {
+        std::vector<CompressedRowMatrix> retVal(3);
+        retVal[0] = opX_.toCompressedRowMatrix();
+        retVal[1] = opY_.toCompressedRowMatrix();
+        retVal[2] = identityPlus(currentForwardRate_, 1.0,
+                                 corrMapT_.toCompressedRowMatrix());
+
+        return retVal;
+    }
 }
@@ -134,4 +134,11 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CompressedRowMatrix> >
+    FdmBlackScholesOp::toCompressedRowMatrixDecomp() const {
+        std::vector<CompressedRowMatrix> retVal(
+                                          1, mapT_.toCompressedRowMatrix());
+        return retVal;
+    }
 }
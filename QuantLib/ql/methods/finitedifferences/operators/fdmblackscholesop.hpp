@@ -58,6 +58,8 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CompressedRowMatrix> >
+            toCompressedRowMatrixDecomp() const;
       private:
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
@@ -123,5 +123,15 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CompressedRowMatrix> >
+    FdmG2Op::toCompressedRowMatrixDecomp() const {
+        std::vector<CompressedRowMatrix> retVal(3);
+        retVal[0] = mapX_.toCompressedRowMatrix();
+        retVal[1] = mapY_.toCompressedRowMatrix();
+        retVal[2] = corrMap_.toCompressedRowMatrix();
+
+        return retVal;
+    }
 }
 
@@ -54,6 +54,8 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CompressedRowMatrix> >
+            toCompressedRowMatrixDecomp() const;
       private:
         const Size direction1_, direction2_;
         const Array x_, y_;
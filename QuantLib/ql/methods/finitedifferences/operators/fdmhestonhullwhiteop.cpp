@@ -168,4 +168,16 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CompressedRowMatrix> >
+    FdmHestonHullWhiteOp::toCompressedRowMatrixDecomp() const {
+        std::vector<CompressedRowMatrix> retVal(4);
+        retVal[0] = dxMap_.getMap().toCompressedRowMatrix();
+        retVal[1] = dyMap_.toCompressedRowMatrix();
+        retVal[2] = hullWhiteOp_.toCompressedRowMatrixDecomp().front();
+        retVal[3] = hestonCorrMap_.toCompressedRowMatrix()
+                  + equityIrCorrMap_.toCompressedRowMatrix();
+
+        return retVal;
+    }
 }
@@ -83,6 +83,8 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CompressedRowMatrix> >
+            toCompressedRowMatrixDecomp() const;
       private:
         const Real v0_, kappa_, theta_, sigma_, rho_;
         const boost::shared_ptr<HullWhite> hwModel_;
@@ -174,4 +174,15 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CompressedRowMatrix> >
+    FdmHestonOp::toCompressedRowMatrixDecomp() const {
+        std::vector<CompressedRowMatrix> retVal(3);
+
+        retVal[0] = dxMap_.getMap().toCompressedRowMatrix();
+        retVal[1] = dyMap_.getMap().toCompressedRowMatrix();
+        retVal[2] = correlationMap_.toCompressedRowMatrix();
+
+        return retVal;
+    }
 }
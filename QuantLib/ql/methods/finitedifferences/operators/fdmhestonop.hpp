@@ -98,6 +98,8 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CompressedRowMatrix> >
+            toCompressedRowMatrixDecomp() const;
       private:
         NinePointLinearOp correlationMap_;
         FdmHestonVariancePart dyMap_;
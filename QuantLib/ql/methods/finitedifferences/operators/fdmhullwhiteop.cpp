@@ -101,5 +101,12 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CompressedRowMatrix> >
+    FdmHullWhiteOp::toCompressedRowMatrixDecomp() const {
+        std::vector<CompressedRowMatrix> retVal(
+                                          1, mapT_.toCompressedRowMatrix());
+        return retVal;
+    }
 }
 
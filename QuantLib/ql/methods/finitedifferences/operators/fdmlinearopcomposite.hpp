@@ -27,6 +27,7 @@
 #define quantlib_fdm_affine_map_composite_hpp
 
 #include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -61,6 +62,35 @@ namespace QuantLib {
             return retVal;
         }
 #endif
+
+        //! decomposition of the operator as compressed-row matrices
+        /*! The default implementation converts the uBLAS matrices
+            returned by toMatrixDecomp(); operators built on
+            TripleBandLinearOp and NinePointLinearOp override it to
+            assemble the matrices directly.
+        */
+        virtual Disposable<std::vector<CompressedRowMatrix> >
+        toCompressedRowMatrixDecomp() const {
+            #if !defined(QL_NO_UBLAS_SUPPORT)
+            const std::vector<SparseMatrix> dcmp = toMatrixDecomp();
+            std::vector<CompressedRowMatrix> retVal(dcmp.size());
+            for (Size i=0; i < dcmp.size(); ++i)
+                retVal[i] = CompressedRowMatrix(dcmp[i]);
+            return retVal;
+            #else
+            QL_FAIL("compressed-row decomposition not implemented");
+            #endif
+        }
+
+        //! operator as a compressed-row matrix
+        Disposable<CompressedRowMatrix> toCompressedRowMatrix() const {
+            const std::vector<CompressedRowMatrix> dcmp =
+                toCompressedRowMatrixDecomp();
+            CompressedRowMatrix retVal = dcmp.front();
+            for (Size i=1; i < dcmp.size(); ++i)
+                retVal = retVal + dcmp[i];
+            return retVal;
+        }
     };
 }
 
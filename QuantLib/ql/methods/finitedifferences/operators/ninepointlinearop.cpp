@@ -25,6 +25,13 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // smaller grids are not worth the overhead of a parallel region
+        const long minParallelSize = 10000;
+
+    }
+
     NinePointLinearOp::NinePointLinearOp(
         Size d0, Size d1,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -144,7 +151,11 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        for (Size i=0; i < retVal.size(); ++i) {
+        const long n = retVal.size();
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(n >= minParallelSize)
+        #endif
+        for (long i=0; i < n; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -180,6 +191,30 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<CompressedRowMatrix>
+    NinePointLinearOp::toCompressedRowMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> offsets(n+1, 0), indices;
+        std::vector<Real> values;
+        indices.reserve(9*n);
+        values.reserve(9*n);
+        for (Size i=0; i < n; ++i) {
+            const Size columns[] = { i00_[i], i01_[i], i02_[i],
+                                     i10_[i], i,       i12_[i],
+                                     i20_[i], i21_[i], i22_[i] };
+            const Real elements[] = { a00_[i], a01_[i], a02_[i],
+                                      a10_[i], a11_[i], a12_[i],
+                                      a20_[i], a21_[i], a22_[i] };
+            detail::appendCompressedRow(columns, elements, 9,
+                                        indices, values);
+            offsets[i+1] = values.size();
+        }
+
+        CompressedRowMatrix retVal(n, n, offsets, indices, values);
+        return retVal;
+    }
+
 
     Disposable<NinePointLinearOp>
         NinePointLinearOp::mult(const Array & u) const {
@@ -26,7 +26,7 @@
 #ifndef quantlib_nine_point_linear_op_hpp
 #define quantlib_nine_point_linear_op_hpp
 
-#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 
 #include <boost/shared_array.hpp>
@@ -51,6 +51,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CompressedRowMatrix> toCompressedRowMatrix() const;
 
       protected:
         NinePointLinearOp() {}
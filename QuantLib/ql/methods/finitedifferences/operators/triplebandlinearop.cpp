@@ -23,9 +23,17 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/utilities/parallel.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // smaller grids are not worth the overhead of a parallel region
+        const long minParallelSize = 10000;
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -113,6 +121,8 @@ namespace QuantLib {
                                    const Array& b) {
         const Size size = mesher_->layout()->size();
 
+        const long n = size;
+
         Real *diag(diag_.get());
         Real *lower(lower_.get());
         Real *upper(upper_.get());
@@ -123,7 +133,10 @@ namespace QuantLib {
 
         if (a.empty()) {
             if (b.empty()) {
-                for (Size i=0; i < size; ++i) {
+                #if defined(_OPENMP)
+                #pragma omp parallel for if(n >= minParallelSize)
+                #endif
+                for (long i=0; i < n; ++i) {
                     diag[i]  = y_diag[i];
                     lower[i] = y_lower[i];
                     upper[i] = y_upper[i];
@@ -133,7 +146,10 @@ namespace QuantLib {
                 Array::const_iterator bptr(b.begin());
                 const Size binc = (b.size() > 1) ? 1 : 0;
 
-                for (Size i=0; i < size; ++i) {
+                #if defined(_OPENMP)
+                #pragma omp parallel for if(n >= minParallelSize)
+                #endif
+                for (long i=0; i < n; ++i) {
                     diag[i]  = y_diag[i] + bptr[i*binc];
                     lower[i] = y_lower[i];
                     upper[i] = y_upper[i];
@@ -148,7 +164,10 @@ namespace QuantLib {
             const Real *x_lower(x.lower_.get());
             const Real *x_upper(x.upper_.get());
 
-            for (Size i=0; i < size; ++i) {
+            #if defined(_OPENMP)
+            #pragma omp parallel for if(n >= minParallelSize)
+            #endif
+            for (long i=0; i < n; ++i) {
                 const Real s = aptr[i*ainc];
                 diag[i]  = y_diag[i]  + s*x_diag[i];
                 lower[i] = y_lower[i] + s*x_lower[i];
@@ -166,7 +185,10 @@ namespace QuantLib {
             const Real *x_lower(x.lower_.get());
             const Real *x_upper(x.upper_.get());
 
-            for (Size i=0; i < size; ++i) {
+            #if defined(_OPENMP)
+            #pragma omp parallel for if(n >= minParallelSize)
+            #endif
+            for (long i=0; i < n; ++i) {
                 const Real s = aptr[i*ainc];
                 diag[i]  = y_diag[i]  + s*x_diag[i] + bptr[i*binc];
                 lower[i] = y_lower[i] + s*x_lower[i];
@@ -230,8 +252,12 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
+        const long n = index->size();
         array_type retVal(r.size());
-        for (Size i=0; i < index->size(); ++i) {
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(n >= minParallelSize)
+        #endif
+        for (long i=0; i < n; ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
 
@@ -254,6 +280,26 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<CompressedRowMatrix>
+    TripleBandLinearOp::toCompressedRowMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> offsets(n+1, 0), indices;
+        std::vector<Real> values;
+        indices.reserve(3*n);
+        values.reserve(3*n);
+        for (Size i=0; i < n; ++i) {
+            const Size columns[] = { i0_[i], i, i2_[i] };
+            const Real elements[] = { lower_[i], diag_[i], upper_[i] };
+            detail::appendCompressedRow(columns, elements, 3,
+                                        indices, values);
+            offsets[i+1] = values.size();
+        }
+
+        CompressedRowMatrix retVal(n, n, offsets, indices, values);
+        return retVal;
+    }
+
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
@@ -280,26 +326,53 @@ namespace QuantLib {
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        // The lines along the direction of the operator are
+        // independent (the entries coupling them are null) and
+        // contiguous in the reverse index; they're solved separately,
+        // which gives the same results as a single sweep over the
+        // whole system and allows to solve them in parallel.
+        const Size lineSize = layout->dim()[direction_];
+        const long lines = layout->size()/lineSize;
+        const Size* rptr = reverseIndex_.get();
+        ParallelErrors errors;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(Size(lines)*lineSize >= minParallelSize)
+        #endif
+        for (long k=0; k < lines; ++k) {
+            const Size* ri = rptr + k*lineSize;
+            Real* t = tmp.begin() + k*lineSize;
+
+            Size rim1 = ri[0];
+            Real bet=1.0/(a*dptr[rim1]+b);
+            if (bet == 0.0) {
+                errors.record("division by zero");
+                continue;
+            }
+            retVal[rim1] = r[rim1]*bet;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            Size j;
+            for (j=1; j < lineSize; ++j) {
+                const Size rj = ri[j];
+                t[j] = a*uptr[rim1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                bet=b+a*(dptr[rj]-t[j]*lptr[rj]);
+                if (bet == 0.0)
+                    break;
+                bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                retVal[rj] = (r[rj]-a*lptr[rj]*retVal[rim1])*bet;
+                rim1 = rj;
+            }
+            if (j < lineSize) {
+                errors.record("division by zero");
+                continue;
+            }
+            // cannot be j>=0 with Size j
+            for (j=lineSize-1; j>0; --j)
+                retVal[ri[j-1]] -= t[j]*retVal[ri[j]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        errors.rethrow();
 
         return retVal;
     }
@@ -30,6 +30,7 @@
 #ifndef quantlib_triple_band_linear_op_hpp
 #define quantlib_triple_band_linear_op_hpp
 
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <boost/shared_array.hpp>
 
@@ -64,6 +65,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CompressedRowMatrix> toCompressedRowMatrix() const;
 
       protected:
         TripleBandLinearOp() {}
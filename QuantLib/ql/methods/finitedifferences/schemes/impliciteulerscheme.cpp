@@ -20,6 +20,8 @@
 */
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/ilu0preconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 
 #include <boost/bind.hpp>
@@ -30,9 +32,11 @@ namespace QuantLib {
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType)
     : dt_    (Null<Real>()),
       relTol_(relTol),
+      solverType_(solverType),
       map_   (map),
       bcSet_ (bcSet) {
     }
@@ -48,15 +52,37 @@ namespace QuantLib {
 
         bcSet_.applyBeforeSolving(*map_, a);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
-        
+        if (solverType_ == BiCGstab) {
+            const boost::function<Disposable<Array>(const Array&)>
+                matrixMult(boost::bind(&ImplicitEulerScheme::apply, this, _1));
+            const boost::function<Disposable<Array>(const Array&)>
+                preconditioner(boost::bind(
+                                     &FdmLinearOpComposite::preconditioner,
+                                     map_, _1, -dt_));
+
+            a = QuantLib::BiCGstab(matrixMult, 10*a.size(), relTol_,
+                                   preconditioner).solve(a).x;
+        } else {
+            // the matrix of the step is assembled once and factorized
+            // for the preconditioner
+            const CompressedRowMatrix m =
+                identityPlus(1.0, -dt_, map_->toCompressedRowMatrix());
+            const ILU0Preconditioner ilu(m);
+
+            const boost::function<Disposable<Array>(const Array&)>
+                matrixMult(boost::bind(&CompressedRowMatrix::apply, &m, _1));
+            const boost::function<Disposable<Array>(const Array&)>
+                preconditioner(boost::bind(&ILU0Preconditioner::apply,
+                                           &ilu, _1));
+
+            // restarted to bound the memory used by the Krylov basis
+            const Size restartLength =
+                std::max<Size>(std::min<Size>(a.size(), 50), 1);
+            a = QuantLib::GMRES(matrixMult, restartLength, relTol_,
+                                preconditioner)
+                .solveWithRestart(10*a.size()/restartLength, a).x;
+        }
+
         bcSet_.applyAfterSolving(a);
     }
 
@@ -34,6 +34,17 @@ namespace QuantLib {
 
     class ImplicitEulerScheme {
       public:
+        //! iterative solver used for the implicit step
+        /*! With BiCGstab, the operator is applied without being
+            assembled and the system is preconditioned with the
+            operator's own preconditioner() method. With GMRES, the
+            matrix of the step is assembled at each step through
+            FdmLinearOpComposite::toCompressedRowMatrix() and the
+            restarted solver is preconditioned with its incomplete
+            LU factorization.
+        */
+        enum SolverType { BiCGstab, GMRES };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -45,7 +56,8 @@ namespace QuantLib {
         ImplicitEulerScheme(
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstab);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -55,6 +67,7 @@ namespace QuantLib {
           
         Time dt_;
         const Real relTol_;
+        const SolverType solverType_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
     };
@@ -31,11 +31,17 @@
 #include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/utilities/parallel.hpp>
 
 namespace QuantLib {
     
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Size aThreads)
+    : type(aType), theta(aTheta), mu(aMu), threads(aThreads) { }
+
+    FdmSchemeDesc FdmSchemeDesc::withThreads(Size aThreads) const {
+        return FdmSchemeDesc(type, theta, mu, aThreads);
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -89,7 +95,9 @@ namespace QuantLib {
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
         const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
-                    
+
+        ParallelThreadsGuard threads(schemeDesc_.threads);
+
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
             ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
@@ -37,10 +37,21 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        /*! The operators are applied and the line systems of the
+            splitting schemes are solved using the given number of
+            threads, if the library was compiled with OpenMP support;
+            a null or zero number selects all the available threads.
+            The results don't depend on the number of threads.
+        */
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Size threads = 1);
 
         const FdmSchemeType type;
         const Real theta, mu;
+        const Size threads;
+
+        //! returns a copy of the description using the given threads
+        FdmSchemeDesc withThreads(Size threads) const;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
@@ -23,6 +23,10 @@
 
 namespace QuantLib {
 
+    namespace {
+        const long minParallelSize = 10000;
+    }
+
     TrinomialTree::TrinomialTree(
                         const boost::shared_ptr<StochasticProcess1D>& process,
                         const TimeGrid& timeGrid,
@@ -72,5 +76,44 @@ namespace QuantLib {
         }
     }
 
-}
+    void TrinomialTree::stepback(Size i,
+                                 const Array& values,
+                                 const Array& discounts,
+                                 Array& newValues) const {
+        QL_REQUIRE(values.size() == size(i+1),
+                   "wrong number of values (" << values.size()
+                   << ") at step " << i+1 << ", " << size(i+1)
+                   << " required");
+        QL_REQUIRE(discounts.size() == size(i),
+                   "wrong number of discount factors (" << discounts.size()
+                   << ") at step " << i << ", " << size(i) << " required");
+        QL_REQUIRE(newValues.size() == size(i),
+                   "wrong size of result array (" << newValues.size()
+                   << ") at step " << i << ", " << size(i) << " required");
+        branchings_[i].stepback(values, discounts, newValues);
+    }
 
+    void TrinomialTree::Branching::stepback(const Array& values,
+                                            const Array& discounts,
+                                            Array& newValues) const {
+        const long n = k_.size();
+        const Integer* k = &k_[0];
+        const Real* p1 = &probs_[0][0];
+        const Real* p2 = &probs_[1][0];
+        const Real* p3 = &probs_[2][0];
+        // the first descendant of node j is at k[j]-jMin_-1
+        const Integer offset = -(jMin_ + 1);
+        const Real* v = values.begin();
+        const Real* d = discounts.begin();
+        Real* result = newValues.begin();
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(n >= minParallelSize)
+        #endif
+        for (long j=0; j<n; ++j) {
+            const Real* w = v + (k[j] + offset);
+            result[j] = (p1[j]*w[0] + p2[j]*w[1] + p3[j]*w[2]) * d[j];
+        }
+    }
+
+}
@@ -26,6 +26,7 @@
 #define quantlib_trinomial_tree_hpp
 
 #include <ql/methods/lattices/tree.hpp>
+#include <ql/math/array.hpp>
 #include <ql/timegrid.hpp>
 
 namespace QuantLib {
@@ -53,6 +54,18 @@ namespace QuantLib {
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
 
+        //! discounted expectation at step i of the values at step i+1
+        /*! The value at the j-th node is the sum of the values at its
+            descendants weighted by the branch probabilities, times
+            the j-th discount factor.  The branchings are stored in
+            contiguous arrays; with OpenMP, the nodes of wide trees
+            are processed in parallel.
+        */
+        void stepback(Size i,
+                      const Array& values,
+                      const Array& discounts,
+                      Array& newValues) const;
+
       protected:
         std::vector<Branching> branchings_;
         Real x0_;
@@ -72,6 +85,9 @@ namespace QuantLib {
             Integer jMin() const;
             Integer jMax() const;
             void add(Integer k, Real p1, Real p2, Real p3);
+            void stepback(const Array& values,
+                          const Array& discounts,
+                          Array& newValues) const;
           private:
             std::vector<Integer> k_;
             std::vector<std::vector<Real> > probs_;
@@ -0,0 +1,370 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchpathgenerator.hpp
+    \brief Generates blocks of paths
+*/
+
+#ifndef quantlib_montecarlo_batch_path_generator_hpp
+#define quantlib_montecarlo_batch_path_generator_hpp
+
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolcurve.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/timegrid.hpp>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    //! Generates blocks of paths
+    /*! Each call to next() generates a given number of paths and
+        stores them in contiguous buffers, one matrix per asset; the
+        rows of each matrix correspond to the points of the time grid
+        and its columns to the paths. Thus, the values of all paths
+        at a given time are contiguous; this is the layout needed for
+        evolving the paths simultaneously, and it allows pricers to
+        work on whole blocks of paths.
+
+        The paths are the same that would be returned by the same
+        number of calls to PathGenerator::next() (for
+        one-dimensional processes) or MultiPathGenerator::next()
+        (for multi-dimensional ones) with the same sequence
+        generator; antithetic() returns the corresponding
+        antithetic paths.
+
+        Buffers are reused between calls, so that no allocation is
+        performed unless the number of paths changes. For the most
+        common processes, the paths are evolved by specialized
+        kernels which perform no virtual calls or allocations inside
+        the loop over the paths, namely:
+        - Black-Scholes processes with constant or strike-independent
+          volatility;
+        - the Hull-White process;
+        - the Heston process with the partial-truncation,
+          full-truncation or reflection discretization.
+        Other processes are evolved by calling their evolve() method
+        on each path.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against those returned
+              by PathGenerator and MultiPathGenerator.
+    */
+    template <class GSG>
+    class BatchPathGenerator {
+      public:
+        typedef std::vector<Matrix> block_type;
+        BatchPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                           const TimeGrid& timeGrid,
+                           const GSG& generator,
+                           bool brownianBridge = false);
+        //! \name inspectors
+        //@{
+        //! generates the next block of paths
+        const block_type& next(Size paths) const;
+        //! generates the paths antithetic to the last block
+        const block_type& antithetic() const;
+        //! weights of the paths in the last block
+        const std::vector<Real>& weights() const { return weights_; }
+        Size size() const { return dimension_; }
+        Size assets() const { return assets_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        /*! returns a copy of this generator drawing its paths from
+            the substream starting \c offset paths ahead; see
+            sequenceSubstream().
+        */
+        BatchPathGenerator substream(Size offset) const;
+      private:
+        enum Kernel { Generic, BlackScholes, HullWhite, Heston };
+        Kernel kernel() const;
+        void evolve(Real sign) const;
+        void evolveGeneric(Real sign) const;
+        void evolveBlackScholes(Real sign) const;
+        void evolveHullWhite(Real sign) const;
+        void evolveHeston(Real sign) const;
+        boost::shared_ptr<StochasticProcess> process_;
+        TimeGrid timeGrid_;
+        GSG generator_;
+        bool brownianBridge_;
+        Size dimension_, factors_, assets_;
+        BrownianBridge bb_;
+        mutable Size paths_;
+        // one (steps x paths) matrix per factor
+        mutable std::vector<Matrix> draws_;
+        // one (points x paths) matrix per asset
+        mutable block_type values_;
+        mutable std::vector<Real> weights_, temp_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    BatchPathGenerator<GSG>::BatchPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& timeGrid,
+                          const GSG& generator,
+                          bool brownianBridge)
+    : process_(process), timeGrid_(timeGrid), generator_(generator),
+      brownianBridge_(brownianBridge), dimension_(generator_.dimension()),
+      factors_(process->factors()), assets_(process->size()),
+      bb_(timeGrid_), paths_(0), temp_(dimension_) {
+        QL_REQUIRE(dimension_ == factors_*(timeGrid_.size()-1),
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != " << factors_ << " factors * "
+                   << timeGrid_.size()-1 << " time steps");
+        QL_REQUIRE(!brownianBridge_ || factors_ == 1,
+                   "Brownian bridge not supported");
+    }
+
+    template <class GSG>
+    const typename BatchPathGenerator<GSG>::block_type&
+    BatchPathGenerator<GSG>::next(Size paths) const {
+        QL_REQUIRE(paths > 0, "null number of paths requested");
+        const Size steps = timeGrid_.size()-1;
+
+        if (paths != paths_) {
+            draws_ = std::vector<Matrix>(factors_, Matrix(steps, paths));
+            values_ = block_type(assets_, Matrix(steps+1, paths));
+            weights_.resize(paths);
+            paths_ = paths;
+        }
+
+        for (Size j=0; j<paths; ++j) {
+            typedef typename GSG::sample_type sequence_type;
+            const sequence_type& sequence = generator_.nextSequence();
+            weights_[j] = sequence.weight;
+            if (brownianBridge_)
+                bb_.transform(sequence.value.begin(), sequence.value.end(),
+                              temp_.begin());
+            else
+                std::copy(sequence.value.begin(), sequence.value.end(),
+                          temp_.begin());
+            for (Size i=0; i<steps; ++i)
+                for (Size k=0; k<factors_; ++k)
+                    draws_[k][i][j] = temp_[i*factors_+k];
+        }
+
+        evolve(1.0);
+        return values_;
+    }
+
+    template <class GSG>
+    const typename BatchPathGenerator<GSG>::block_type&
+    BatchPathGenerator<GSG>::antithetic() const {
+        QL_REQUIRE(paths_ > 0, "no paths generated yet");
+        evolve(-1.0);
+        return values_;
+    }
+
+    template <class GSG>
+    BatchPathGenerator<GSG>
+    BatchPathGenerator<GSG>::substream(Size offset) const {
+        BatchPathGenerator<GSG> g(*this);
+        g.generator_ = sequenceSubstream(generator_, offset);
+        return g;
+    }
+
+    template <class GSG>
+    typename BatchPathGenerator<GSG>::Kernel
+    BatchPathGenerator<GSG>::kernel() const {
+        const StochasticProcess& p = *process_;
+        // derived classes might change the dynamics, so we check the
+        // exact type of the process
+        if (typeid(p) == typeid(GeneralizedBlackScholesProcess) ||
+            typeid(p) == typeid(BlackScholesProcess) ||
+            typeid(p) == typeid(BlackScholesMertonProcess) ||
+            typeid(p) == typeid(BlackProcess) ||
+            typeid(p) == typeid(GarmanKohlagenProcess)) {
+            const GeneralizedBlackScholesProcess& bs =
+                dynamic_cast<const GeneralizedBlackScholesProcess&>(p);
+            const boost::shared_ptr<LocalVolTermStructure>& localVol =
+                bs.localVolatility().currentLink();
+            if (boost::dynamic_pointer_cast<LocalConstantVol>(localVol) ||
+                boost::dynamic_pointer_cast<LocalVolCurve>(localVol))
+                return BlackScholes;
+        } else if (typeid(p) == typeid(HullWhiteProcess)) {
+            return HullWhite;
+        } else if (typeid(p) == typeid(HestonProcess)) {
+            HestonProcess::Discretization d =
+                dynamic_cast<const HestonProcess&>(p).discretization();
+            if (d == HestonProcess::PartialTruncation ||
+                d == HestonProcess::FullTruncation ||
+                d == HestonProcess::Reflection)
+                return Heston;
+        }
+        return Generic;
+    }
+
+    template <class GSG>
+    void BatchPathGenerator<GSG>::evolve(Real sign) const {
+        switch (kernel()) {
+          case BlackScholes:
+            evolveBlackScholes(sign);
+            break;
+          case HullWhite:
+            evolveHullWhite(sign);
+            break;
+          case Heston:
+            evolveHeston(sign);
+            break;
+          default:
+            evolveGeneric(sign);
+        }
+    }
+
+    template <class GSG>
+    void BatchPathGenerator<GSG>::evolveGeneric(Real sign) const {
+        const Size steps = timeGrid_.size()-1;
+        if (assets_ == 1 && factors_ == 1) {
+            const StochasticProcess1D& p =
+                dynamic_cast<const StochasticProcess1D&>(*process_);
+            Matrix& x = values_[0];
+            std::fill(x.row_begin(0), x.row_end(0), p.x0());
+            for (Size i=0; i<steps; ++i) {
+                Time t = timeGrid_[i], dt = timeGrid_.dt(i);
+                const Real* dw = draws_[0].row_begin(i);
+                const Real* x0 = x.row_begin(i);
+                Real* x1 = x.row_begin(i+1);
+                for (Size j=0; j<paths_; ++j)
+                    x1[j] = p.evolve(t, x0[j], dt, sign*dw[j]);
+            }
+        } else {
+            Array initialValues = process_->initialValues();
+            Array x(assets_), dw(factors_);
+            for (Size j=0; j<paths_; ++j) {
+                for (Size a=0; a<assets_; ++a)
+                    values_[a][0][j] = x[a] = initialValues[a];
+                for (Size i=0; i<steps; ++i) {
+                    for (Size k=0; k<factors_; ++k)
+                        dw[k] = sign*draws_[k][i][j];
+                    x = process_->evolve(timeGrid_[i], x,
+                                         timeGrid_.dt(i), dw);
+                    for (Size a=0; a<assets_; ++a)
+                        values_[a][i+1][j] = x[a];
+                }
+            }
+        }
+    }
+
+    template <class GSG>
+    void BatchPathGenerator<GSG>::evolveBlackScholes(Real sign) const {
+        // with a state-independent volatility, drift and diffusion
+        // only depend on time and are calculated once for each step.
+        const GeneralizedBlackScholesProcess& p =
+            dynamic_cast<const GeneralizedBlackScholesProcess&>(*process_);
+        const Size steps = timeGrid_.size()-1;
+        const Real s0 = p.x0();
+        Matrix& x = values_[0];
+        std::fill(x.row_begin(0), x.row_end(0), s0);
+        for (Size i=0; i<steps; ++i) {
+            Time t = timeGrid_[i], dt = timeGrid_.dt(i);
+            // the drift is obtained from evolve() in order to use
+            // the discretization of the process
+            const Real mu = std::log(p.evolve(t, 1.0, dt, 0.0));
+            const Real sigma = sign*p.stdDeviation(t, s0, dt);
+            const Real* dw = draws_[0].row_begin(i);
+            const Real* x0 = x.row_begin(i);
+            Real* x1 = x.row_begin(i+1);
+            for (Size j=0; j<paths_; ++j)
+                x1[j] = x0[j] * std::exp(mu + sigma*dw[j]);
+        }
+    }
+
+    template <class GSG>
+    void BatchPathGenerator<GSG>::evolveHullWhite(Real sign) const {
+        // the expectation is linear in the current state, and the
+        // standard deviation does not depend on it.
+        const HullWhiteProcess& p =
+            dynamic_cast<const HullWhiteProcess&>(*process_);
+        const Size steps = timeGrid_.size()-1;
+        Matrix& x = values_[0];
+        std::fill(x.row_begin(0), x.row_end(0), p.x0());
+        for (Size i=0; i<steps; ++i) {
+            Time t = timeGrid_[i], dt = timeGrid_.dt(i);
+            const Real b = p.expectation(t, 0.0, dt);
+            const Real a = p.expectation(t, 1.0, dt) - b;
+            const Real sigma = sign*p.stdDeviation(t, 0.0, dt);
+            const Real* dw = draws_[0].row_begin(i);
+            const Real* x0 = x.row_begin(i);
+            Real* x1 = x.row_begin(i+1);
+            for (Size j=0; j<paths_; ++j)
+                x1[j] = a*x0[j] + b + sigma*dw[j];
+        }
+    }
+
+    template <class GSG>
+    void BatchPathGenerator<GSG>::evolveHeston(Real sign) const {
+        // same as HestonProcess::evolve for the Euler-like schemes
+        const HestonProcess& p =
+            dynamic_cast<const HestonProcess&>(*process_);
+        const HestonProcess::Discretization d = p.discretization();
+        const Real kappa = p.kappa(), theta = p.theta(),
+                   sigma = p.sigma(), rho = p.rho();
+        const Real sqrhov = std::sqrt(1.0 - rho*rho);
+        const Size steps = timeGrid_.size()-1;
+
+        Matrix& s = values_[0];
+        Matrix& v = values_[1];
+        std::fill(s.row_begin(0), s.row_end(0), p.s0()->value());
+        std::fill(v.row_begin(0), v.row_end(0), p.v0());
+
+        for (Size i=0; i<steps; ++i) {
+            Time t = timeGrid_[i], dt = timeGrid_.dt(i);
+            const Real sdt = std::sqrt(dt);
+            const Real r =
+                p.riskFreeRate()->forwardRate(t, t+dt, Continuous)
+                - p.dividendYield()->forwardRate(t, t+dt, Continuous);
+            const Real* dw0 = draws_[0].row_begin(i);
+            const Real* dw1 = draws_[1].row_begin(i);
+            const Real* s0 = s.row_begin(i);
+            const Real* v0 = v.row_begin(i);
+            Real* s1 = s.row_begin(i+1);
+            Real* v1 = v.row_begin(i+1);
+            for (Size j=0; j<paths_; ++j) {
+                const Real z0 = sign*dw0[j], z1 = sign*dw1[j];
+                Real vol, base, nu;
+                if (d == HestonProcess::Reflection) {
+                    vol = std::sqrt(std::fabs(v0[j]));
+                    base = vol*vol;
+                    nu = kappa*(theta - vol*vol);
+                } else {
+                    vol = (v0[j] > 0.0) ? std::sqrt(v0[j]) : 0.0;
+                    base = v0[j];
+                    nu = (d == HestonProcess::PartialTruncation)
+                        ? kappa*(theta - v0[j])
+                        : kappa*(theta - vol*vol);
+                }
+                const Real vol2 = sigma * vol;
+                const Real mu = r - 0.5 * vol * vol;
+                s1[j] = s0[j] * std::exp(mu*dt+vol*z0*sdt);
+                v1[j] = base + nu*dt + vol2*sdt*(rho*z0 + sqrhov*z1);
+            }
+        }
+    }
+
+}
+
+
+#endif
@@ -29,6 +29,7 @@
 #include <ql/math/generallinearleastsquares.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
+#include <ql/utilities/parallel.hpp>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 
@@ -41,10 +42,35 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        During the calibration phase, the calibration paths are not
+        stored; for each exercise time, only the in-the-money paths
+        are recorded together with their exercise value and the state
+        passed to the basis functions.  Buffers are released as soon
+        as the corresponding regression is done.
+
+        The regressions must be performed backwards in time, since
+        each of them depends on the exercise decisions taken at later
+        times.  When parallel calibration is enabled, each regression
+        is performed by building its normal equations over blocks of
+        paths in parallel; the blocks are then summed in order, so
+        that the results do not depend on the number of threads.  The
+        normal equations are solved by singular value decomposition.
+        The results are close, but not identical, to the ones of the
+        serial calibration, which performs the decomposition of the
+        full regression matrix instead.
+
+        \warning Parallel calibration squares the condition number of
+                 the regression; basis functions should be evaluated
+                 on states of order one, as done by the engines in
+                 the library.
+
         \ingroup mcarlo
 
-        \test the correctness of the returned value is tested by
-              reproducing results available in web/literature
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in web/literature
+        - the results of parallel calibration are checked against
+          the serial ones.
     */
     template <class PathType>
     class LongstaffSchwartzPathPricer : public PathPricer<PathType> {
@@ -59,7 +85,24 @@ namespace QuantLib {
         Real operator()(const PathType& path) const;
         virtual void calibrate();
 
+        //! \name Parallel calibration
+        //@{
+        /*! A null or zero number of threads selects all the available
+            ones; see parallelThreads(). */
+        void enableParallelCalibration(Size threads = 0);
+        void disableParallelCalibration();
+        //@}
       protected:
+        //! calibration data for a single exercise time
+        struct ExerciseData {
+            std::vector<Size> paths;
+            std::vector<Real> exercise;
+            std::vector<StateType> states;
+        };
+
+        Array normalEquationsCoefficients(const std::vector<StateType>& x,
+                                          const std::vector<Real>& y) const;
+
         bool  calibrationPhase_;
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
@@ -67,8 +110,10 @@ namespace QuantLib {
         boost::scoped_array<Array> coeff_;
         boost::scoped_array<DiscountFactor> dF_;
 
-        mutable std::vector<PathType> paths_;
+        mutable std::vector<Real> payoffs_;
+        mutable std::vector<ExerciseData> exerciseData_;
         const   std::vector<boost::function1<Real, StateType> > v_;
+        Size threads_;
     };
 
     template <class PathType> inline
@@ -81,7 +126,8 @@ namespace QuantLib {
       pathPricer_(pathPricer),
       coeff_     (new Array[times.size()-1]),
       dF_        (new DiscountFactor[times.size()-1]),
-      v_         (pathPricer_->basisSystem()) {
+      v_         (pathPricer_->basisSystem()),
+      threads_   (Null<Size>()) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -89,17 +135,43 @@ namespace QuantLib {
         }
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::enableParallelCalibration(
+                                                               Size threads) {
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::disableParallelCalibration() {
+        threads_ = Null<Size>();
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
+        const Size len = EarlyExerciseTraits<PathType>::pathLength(path);
+
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.push_back(path);
+            // store the data needed by the calibration
+            if (exerciseData_.empty())
+                exerciseData_.resize(len-1);
+            QL_REQUIRE(exerciseData_.size() == len-1,
+                       "calibration paths of different lengths");
+            const Size n = payoffs_.size();
+            payoffs_.push_back((*pathPricer_)(path, len-1));
+            for (Size i=1; i<len-1; ++i) {
+                const Real exercise = (*pathPricer_)(path, i);
+                if (exercise > 0.0) {
+                    ExerciseData& data = exerciseData_[i];
+                    data.paths.push_back(n);
+                    data.exercise.push_back(exercise);
+                    data.states.push_back(pathPricer_->state(path, i));
+                }
+            }
             // result doesn't matter
             return 0.0;
         }
 
-        const Size len = EarlyExerciseTraits<PathType>::pathLength(path);
         Real price = (*pathPricer_)(path, len-1);
         for (Size i=len-2; i>0; --i) {
             price*=dF_[i];
@@ -124,31 +196,28 @@ namespace QuantLib {
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
-        const Size n = paths_.size();
-        Array prices(n), exercise(n);
-        const Size len = EarlyExerciseTraits<PathType>::pathLength(paths_[0]);
-
-        for (Size i=0; i<n; ++i)
-            prices[i] = (*pathPricer_)(paths_[i], len-1);
+        const Size n = payoffs_.size();
+        QL_REQUIRE(n > 0, "no calibration paths");
+        Array prices(payoffs_.begin(), payoffs_.end());
+        const Size len = exerciseData_.size()+1;
 
-        std::vector<Real>      y;
-        std::vector<StateType> x;
+        std::vector<Real> y;
         for (Size i=len-2; i>0; --i) {
-            y.clear();
-            x.clear();
+            ExerciseData& data = exerciseData_[i];
+            const std::vector<StateType>& x = data.states;
+            const Size m = data.paths.size();
 
             //roll back step
-            for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
-
-                if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
-                    y.push_back(dF_[i]*prices[j]);
-                }
-            }
-
-            if (v_.size() <=  x.size()) {
-                coeff_[i] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            y.resize(m);
+            for (Size k=0; k<m; ++k)
+                y[k] = dF_[i]*prices[data.paths[k]];
+
+            if (v_.size() <= m) {
+                if (threads_ != Null<Size>())
+                    coeff_[i] = normalEquationsCoefficients(x, y);
+                else
+                    coeff_[i] =
+                        GeneralLinearLeastSquares(x, y, v_).coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
@@ -156,27 +225,109 @@ namespace QuantLib {
                 coeff_[i] = Array(v_.size(), 0.0);
             }
 
-            for (Size j=0, k=0; j<n; ++j) {
+            for (Size j=0; j<n; ++j)
                 prices[j]*=dF_[i];
-                if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i][l] * v_[l](x[k]);
-                    }
-                    if (continuationValue < exercise[j]) {
-                        prices[j] = exercise[j];
-                    }
-                    ++k;
+            for (Size k=0; k<m; ++k) {
+                Real continuationValue = 0.0;
+                for (Size l=0; l<v_.size(); ++l) {
+                    continuationValue += coeff_[i][l] * v_[l](x[k]);
+                }
+                if (continuationValue < data.exercise[k]) {
+                    prices[data.paths[k]] = data.exercise[k];
                 }
             }
+
+            // release memory as soon as possible
+            ExerciseData empty;
+            std::swap(data, empty);
         }
 
-        // remove calibration paths and release memory
-        std::vector<PathType> empty;
-        paths_.swap(empty);
+        // remove calibration data and release memory
+        std::vector<Real> emptyPayoffs;
+        payoffs_.swap(emptyPayoffs);
+        std::vector<ExerciseData> emptyData;
+        exerciseData_.swap(emptyData);
         // entering the calculation phase
         calibrationPhase_ = false;
     }
+
+    template <class PathType> inline
+    Array LongstaffSchwartzPathPricer<PathType>::normalEquationsCoefficients(
+                                            const std::vector<StateType>& x,
+                                            const std::vector<Real>& y) const {
+        const Size m = x.size(), p = v_.size();
+        const Size blockSize = 1024;
+        const Size blocks = (m + blockSize - 1) / blockSize;
+
+        // each block accumulates its contribution to A^T A (the
+        // upper triangle, stored by rows) and to A^T y
+        const Size stride = p*(p+1)/2 + p;
+        std::vector<Real> sums(blocks*stride, 0.0);
+        ParallelErrors errors;
+
+        #if defined(_OPENMP)
+        const Size threads = parallelThreads(threads_);
+        #pragma omp parallel for num_threads(threads) schedule(dynamic)
+        #endif
+        for (long b=0; b<long(blocks); ++b) {
+            try {
+                Real* s = &sums[Size(b)*stride];
+                std::vector<Real> f(p);
+                const Size end = std::min(m, Size(b+1)*blockSize);
+                for (Size k=Size(b)*blockSize; k<end; ++k) {
+                    for (Size l=0; l<p; ++l)
+                        f[l] = v_[l](x[k]);
+                    Size pos = 0;
+                    for (Size l=0; l<p; ++l) {
+                        for (Size h=l; h<p; ++h)
+                            s[pos++] += f[l]*f[h];
+                    }
+                    for (Size l=0; l<p; ++l)
+                        s[pos++] += f[l]*y[k];
+                }
+            } catch (std::exception& e) {
+                errors.record(e.what());
+            } catch (...) {
+                errors.record("unknown error in parallel calibration");
+            }
+        }
+        errors.rethrow();
+
+        Matrix A(p, p, 0.0);
+        Array b(p, 0.0);
+        for (Size k=0; k<blocks; ++k) {
+            const Real* s = &sums[k*stride];
+            Size pos = 0;
+            for (Size l=0; l<p; ++l) {
+                for (Size h=l; h<p; ++h)
+                    A[l][h] += s[pos++];
+            }
+            for (Size l=0; l<p; ++l)
+                b[l] += s[pos++];
+        }
+        for (Size l=0; l<p; ++l) {
+            for (Size h=0; h<l; ++h)
+                A[l][h] = A[h][l];
+        }
+
+        const SVD svd(A);
+        const Matrix& U = svd.U();
+        const Matrix& V = svd.V();
+        const Array& w = svd.singularValues();
+        const Real threshold = p*w[0]*QL_EPSILON;
+
+        Array a(p, 0.0);
+        for (Size l=0; l<p; ++l) {
+            if (w[l] > threshold) {
+                const Real u = std::inner_product(U.column_begin(l),
+                                                  U.column_end(l),
+                                                  b.begin(), 0.0)/w[l];
+                for (Size h=0; h<p; ++h)
+                    a[h] += u*V[h][l];
+            }
+        }
+        return a;
+    }
 }
 
 
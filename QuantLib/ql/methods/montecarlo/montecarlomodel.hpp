@@ -27,7 +27,9 @@
 
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/utilities/parallel.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -45,6 +47,16 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Samples are drawn serially by default.  When parallel
+        sampling is enabled, they are split into blocks of fixed size;
+        each block is drawn from its own substream of the path
+        generator (see sequenceSubstream()) and the resulting values
+        are added to the accumulator in block order.  Therefore, the
+        results do not depend on the number of threads used; with
+        low-discrepancy sequences, they are also the same as in the
+        serial case.  The path pricers must be safe to call
+        concurrently.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -72,7 +84,8 @@ namespace QuantLib {
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator),
+          threads_(Null<Size>()), blockSize_(1024) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
@@ -80,7 +93,19 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        //! \name Parallel sampling
+        //@{
+        /*! A null or zero number of threads selects all the available
+            ones; see parallelThreads(). */
+        void enableParallelSampling(Size threads = 0,
+                                    Size blockSize = 1024);
+        void disableParallelSampling();
+        //@}
       private:
+        result_type nextSample(path_generator_type& generator,
+                               path_generator_type* cvGenerator,
+                               Real& weight) const;
+        void addSamplesInParallel(Size samples);
         boost::shared_ptr<path_generator_type> pathGenerator_;
         boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -89,43 +114,137 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size threads_, blockSize_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
-    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::nextSample(path_generator_type& generator,
+                                          path_generator_type* cvGenerator,
+                                          Real& weight) const {
+        sample_type path = generator.next();
+        result_type price = (*pathPricer_)(path.value);
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        if (isControlVariate_) {
+            if (!cvGenerator) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                sample_type cvPath = cvGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
 
+        if (isAntitheticVariate_) {
+            path = generator.antithetic();
+            result_type price2 = (*pathPricer_)(path.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!cvGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
                 else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    sample_type cvPath = cvGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
+            weight = path.weight;
+            return (price+price2)/2.0;
+        } else {
+            weight = path.weight;
+            return price;
+        }
+    }
 
-            if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (threads_ != Null<Size>()) {
+            addSamplesInParallel(samples);
+            return;
+        }
+        for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price =
+                nextSample(*pathGenerator_, cvPathGenerator_.get(), weight);
+            sampleAccumulator_.add(price, weight);
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                                              Size samples) {
+        if (samples == 0)
+            return;
+
+        // paths and pricers might perform lazy initializations on
+        // first use; we trigger them here, before any concurrent call.
+        {
+            path_generator_type warmup(*pathGenerator_);
+            Real weight;
+            nextSample(warmup, 0, weight);
+        }
+
+        const Size threads = parallelThreads(threads_);
+        const Size blocks = (samples + blockSize_ - 1) / blockSize_;
+        // blocks are processed in batches to limit memory usage
+        const Size batchSize = std::max<Size>(threads*4, 1);
+
+        std::vector<result_type> values(std::min(blocks,batchSize)*blockSize_);
+        std::vector<Real> weights(values.size());
+
+        for (Size first = 0; first < blocks; first += batchSize) {
+            const Size last = std::min(first + batchSize, blocks);
+            ParallelErrors errors;
+
+            #if defined(_OPENMP)
+            #pragma omp parallel for num_threads(threads) schedule(dynamic)
+            #endif
+            for (long b = long(first); b < long(last); ++b) {
+                try {
+                    const Size start = Size(b)*blockSize_;
+                    const Size size = std::min(blockSize_, samples-start);
+                    path_generator_type generator =
+                        pathGenerator_->substream(start);
+                    boost::shared_ptr<path_generator_type> cvGenerator;
+                    if (cvPathGenerator_)
+                        cvGenerator.reset(new path_generator_type(
+                                          cvPathGenerator_->substream(start)));
+                    const Size offset = (Size(b)-first)*blockSize_;
+                    for (Size j=0; j<size; ++j)
+                        values[offset+j] = nextSample(generator,
+                                                      cvGenerator.get(),
+                                                      weights[offset+j]);
+                } catch (std::exception& e) {
+                    errors.record(e.what());
+                } catch (...) {
+                    errors.record("unknown error in parallel sampling");
+                }
             }
+
+            errors.rethrow();
+
+            const Size start = first*blockSize_;
+            const Size size = std::min(last*blockSize_, samples) - start;
+            for (Size j=0; j<size; ++j)
+                sampleAccumulator_.add(values[j], weights[j]);
         }
+
+        *pathGenerator_ = pathGenerator_->substream(samples);
+        if (cvPathGenerator_)
+            *cvPathGenerator_ = cvPathGenerator_->substream(samples);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::enableParallelSampling(
+                                                            Size threads,
+                                                            Size blockSize) {
+        QL_REQUIRE(blockSize > 0, "null block size given");
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+        blockSize_ = blockSize;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::disableParallelSampling() {
+        threads_ = Null<Size>();
     }
 
     template <template <class> class MC, class RNG, class S>
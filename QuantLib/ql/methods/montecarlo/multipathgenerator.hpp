@@ -56,6 +56,11 @@ namespace QuantLib {
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        /*! returns a copy of this generator drawing its paths from
+            the substream starting \c offset paths ahead; see
+            sequenceSubstream().
+        */
+        MultiPathGenerator substream(Size offset) const;
       private:
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
@@ -87,6 +92,14 @@ namespace QuantLib {
                    "no times given");
     }
 
+    template <class GSG>
+    inline MultiPathGenerator<GSG>
+    MultiPathGenerator<GSG>::substream(Size offset) const {
+        MultiPathGenerator<GSG> g(*this);
+        g.generator_ = sequenceSubstream(generator_, offset);
+        return g;
+    }
+
     template <class GSG>
     inline const typename MultiPathGenerator<GSG>::sample_type&
     MultiPathGenerator<GSG>::next() const {
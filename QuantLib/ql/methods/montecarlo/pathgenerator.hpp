@@ -61,6 +61,11 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        /*! returns a copy of this generator drawing its paths from
+            the substream starting \c offset paths ahead; see
+            sequenceSubstream().
+        */
+        PathGenerator substream(Size offset) const;
       private:
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
@@ -119,6 +124,13 @@ namespace QuantLib {
         return next(true);
     }
 
+    template <class GSG>
+    PathGenerator<GSG> PathGenerator<GSG>::substream(Size offset) const {
+        PathGenerator<GSG> g(*this);
+        g.generator_ = sequenceSubstream(generator_, offset);
+        return g;
+    }
+
     template <class GSG>
     const typename PathGenerator<GSG>::sample_type&
     PathGenerator<GSG>::next(bool antithetic) const {
@@ -41,6 +41,22 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! Paths are simulated serially by default.  When parallel
+        sampling is enabled, they are split into blocks of fixed
+        size; each block is simulated by a copy of the engine, with
+        its own clone of the product and of the discounters, and
+        with an evolver drawing from its own substream (see
+        MarketModelEvolver::substream()).  The path values are added
+        to the statistics in block order; therefore, the results do
+        not depend on the number of threads used and, with Sobol
+        Brownian generators, they are also the same as in the serial
+        case.  After a parallel simulation, the engine uses a
+        substream of the evolver positioned after the simulated
+        paths; the evolver passed to the constructor is not modified.
+
+        \test the results of parallel simulations are checked against
+              the serial ones.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
@@ -48,8 +64,18 @@ namespace QuantLib {
                          Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! \name Parallel sampling
+        //@{
+        /*! A null or zero number of threads selects all the available
+            ones; see parallelThreads(). */
+        void enableParallelSampling(Size threads = 0,
+                                    Size blockSize = 1024);
+        void disableParallelSampling();
+        //@}
       private:
         Real singlePathValues(std::vector<Real>& values);
+        void multiplePathValuesInParallel(SequenceStatisticsInc& stats,
+                                          Size numberOfPaths);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
@@ -64,6 +90,7 @@ namespace QuantLib {
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
 
+        Size threads_, blockSize_;
     };
 
 }
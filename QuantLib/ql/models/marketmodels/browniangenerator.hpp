@@ -22,6 +22,7 @@
 #define quantlib_brownian_generator_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
 
@@ -37,8 +38,22 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        /*! returns an independent generator whose next path is the
+            one that this generator would return after skipping
+            \c offset paths; different offsets can be drawn
+            concurrently.  See sequenceSubstream() for the properties
+            of the substreams of the underlying sequence generators.
+        */
+        virtual boost::shared_ptr<BrownianGenerator>
+                                             substream(Size offset) const;
     };
 
+    inline boost::shared_ptr<BrownianGenerator>
+    BrownianGenerator::substream(Size) const {
+        QL_FAIL("substreams not supported by this Brownian generator");
+    }
+
     class BrownianGeneratorFactory {
       public:
         virtual ~BrownianGeneratorFactory() {}
@@ -56,6 +56,15 @@ namespace QuantLib {
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    boost::shared_ptr<BrownianGenerator>
+    MTBrownianGenerator::substream(Size offset) const {
+        boost::shared_ptr<MTBrownianGenerator> g(
+                                             new MTBrownianGenerator(*this));
+        g->generator_ = generator_.substream(offset);
+        g->lastStep_ = 0;
+        return g;
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
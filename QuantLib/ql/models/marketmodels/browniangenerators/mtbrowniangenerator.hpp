@@ -51,6 +51,8 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        boost::shared_ptr<BrownianGenerator> substream(Size offset) const;
       private:
         Size factors_, steps_;
         Size lastStep_;
@@ -208,6 +208,15 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    boost::shared_ptr<BrownianGenerator>
+    SobolBrownianGenerator::substream(Size offset) const {
+        boost::shared_ptr<SobolBrownianGenerator> g(
+                                          new SobolBrownianGenerator(*this));
+        g->generator_ = generator_.substream(offset);
+        g->lastStep_ = 0;
+        return g;
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
@@ -59,7 +59,9 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
-        
+
+        boost::shared_ptr<BrownianGenerator> substream(Size offset) const;
+
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
         std::vector<std::vector<Real> > transform(
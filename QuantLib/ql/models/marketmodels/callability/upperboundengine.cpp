@@ -28,6 +28,7 @@
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
+#include <ql/utilities/parallel.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -119,7 +120,8 @@ namespace QuantLib {
                    Real initialNumeraireValue)
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
       composite_(MultiProductComposite()),
-      initialNumeraireValue_(initialNumeraireValue) {
+      initialNumeraireValue_(initialNumeraireValue),
+      threads_(Null<Size>()), blockSize_(64) {
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -170,6 +172,11 @@ namespace QuantLib {
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
                                               Size innerPaths) {
+        if (threads_ != Null<Size>()) {
+            multiplePathValuesInParallel(stats, outerPaths, innerPaths);
+            return;
+        }
+
         for (Size i=0; i<outerPaths; ++i) {
             std::pair<Real,Real> result = singlePathValue(innerPaths);
             stats.add(result.first, result.second);
@@ -177,6 +184,75 @@ namespace QuantLib {
     }
 
 
+    void UpperBoundEngine::multiplePathValuesInParallel(Statistics& stats,
+                                                        Size outerPaths,
+                                                        Size innerPaths) {
+        if (outerPaths == 0)
+            return;
+
+        const Size threads = parallelThreads(threads_);
+        const Size blocks = (outerPaths + blockSize_ - 1) / blockSize_;
+        // blocks are processed in batches to limit memory usage
+        const Size batchSize = std::max<Size>(threads*4, 1);
+
+        std::vector<std::pair<Real,Real> > results(
+                                      std::min(blocks,batchSize)*blockSize_);
+
+        for (Size first = 0; first < blocks; first += batchSize) {
+            const Size last = std::min(first + batchSize, blocks);
+            ParallelErrors errors;
+
+            #if defined(_OPENMP)
+            #pragma omp parallel for num_threads(threads) schedule(dynamic)
+            #endif
+            for (long b = long(first); b < long(last); ++b) {
+                try {
+                    const Size start = Size(b)*blockSize_;
+                    const Size size = std::min(blockSize_, outerPaths-start);
+                    // each outer path draws innerPaths paths from
+                    // each of the inner evolvers
+                    UpperBoundEngine worker(*this);
+                    worker.evolver_ = evolver_->substream(start);
+                    for (Size i=0; i<innerEvolvers_.size(); ++i)
+                        worker.innerEvolvers_[i] =
+                            innerEvolvers_[i]->substream(start*innerPaths);
+                    const Size offset = (Size(b)-first)*blockSize_;
+                    for (Size j=0; j<size; ++j)
+                        results[offset+j] = worker.singlePathValue(innerPaths);
+                } catch (std::exception& e) {
+                    errors.record(e.what());
+                } catch (...) {
+                    errors.record("unknown error in parallel simulation");
+                }
+            }
+
+            errors.rethrow();
+
+            const Size start = first*blockSize_;
+            const Size size = std::min(last*blockSize_, outerPaths) - start;
+            for (Size j=0; j<size; ++j)
+                stats.add(results[j].first, results[j].second);
+        }
+
+        evolver_ = evolver_->substream(outerPaths);
+        for (Size i=0; i<innerEvolvers_.size(); ++i)
+            innerEvolvers_[i] =
+                innerEvolvers_[i]->substream(outerPaths*innerPaths);
+    }
+
+
+    void UpperBoundEngine::enableParallelSampling(Size threads,
+                                                  Size blockSize) {
+        QL_REQUIRE(blockSize > 0, "null block size given");
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+        blockSize_ = blockSize;
+    }
+
+    void UpperBoundEngine::disableParallelSampling() {
+        threads_ = Null<Size>();
+    }
+
+
     std::pair<Real,Real> UpperBoundEngine::singlePathValue(Size innerPaths) {
 
         DecoratedHedge& callable =
@@ -37,8 +37,17 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! Outer paths can be simulated in parallel as in
+        AccountingEngine.  Each block of outer paths uses substreams
+        of the outer and inner evolvers positioned so that, with
+        Sobol Brownian generators, the results are the same as in the
+        serial case.
+
+        \pre product and hedge must have the same rate times
              and exercise times
+
+        \test the results of parallel simulations are checked against
+              the serial ones.
     */
     class UpperBoundEngine {
       public:
@@ -56,7 +65,17 @@ namespace QuantLib {
                                 Size outerPaths,
                                 Size innerPaths);
         std::pair<Real,Real> singlePathValue(Size innerPaths);
+        //! \name Parallel sampling
+        //@{
+        //! see AccountingEngine::enableParallelSampling()
+        void enableParallelSampling(Size threads = 0,
+                                    Size blockSize = 64);
+        void disableParallelSampling();
+        //@}
       private:
+        void multiplePathValuesInParallel(Statistics& stats,
+                                          Size outerPaths,
+                                          Size innerPaths);
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
                               Size beginProduct,
@@ -78,6 +97,8 @@ namespace QuantLib {
         std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
+
+        Size threads_, blockSize_;
     };
 
 }
@@ -37,7 +37,7 @@ namespace QuantLib {
       numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()),
       pseudo_(pseudo), tmp_(taus.size(), 0.0),
-      e_(pseudo_.columns(), pseudo_.rows(), 0.0),
+      e_(pseudo_.columns(), 0.0),
       downs_(taus.size()), ups_(taus.size()) {
 
         // Check requirements
@@ -128,10 +128,6 @@ namespace QuantLib {
             tmp_[i] = (forwards[i]+displacements_[i]) /
                 (oneOverTaus_[i]+forwards[i]);
 
-        // Enforce initialization
-        for (Size r=0; r<numberOfFactors_; ++r)
-            e_[r][std::max(0,static_cast<Integer>(numeraire_)-1)] = 0.0;
-
         // Now compute drifts: take the numeraire P_N (numeraire_=N)
         // as the reference point, divide the summation into 3 steps,
         // et impera:
@@ -141,42 +137,147 @@ namespace QuantLib {
         if (numeraire_>0) drifts[numeraire_-1] = 0.0;
 
         // 2nd step: then, move backward from N-2 (included) back to
-        // alive (included) (if N=0 jumps to 3rd step, if N=numberOfRates_ the
-        // e_[r][N-1] are correctly initialized):
-
+        // alive (included) (if N=0 jumps to 3rd step).  e_[r] holds the
+        // partial sum over the rates already visited for factor r.
+        std::fill(e_.begin(), e_.end(), 0.0);
         for (Integer i=static_cast<Integer>(numeraire_)-2;
              i>=static_cast<Integer>(alive_); --i) {
-            drifts[i] = 0.0;
+            const Real x = tmp_[i+1];
+            Matrix::const_row_iterator p0 = pseudo_.row_begin(i);
+            Matrix::const_row_iterator p1 = pseudo_.row_begin(i+1);
+            Real drift = 0.0;
             for (Size r=0; r<numberOfFactors_; ++r) {
-                e_[r][i] = e_[r][i+1] + tmp_[i+1] * pseudo_[i+1][r];
-                drifts[i] -= e_[r][i]*pseudo_[i][r];
+                e_[r] += x*p1[r];
+                drift -= e_[r]*p0[r];
             }
-
-            /*
-            Matrix::column_iterator p1 = e_.column_begin(i);
-            Matrix::column_iterator end = e_.column_end(i);
-            Matrix::const_column_iterator p2 = e_.column_begin(i+1);
-            Matrix::const_row_iterator q1 = pseudo_.row_begin(i);
-            Matrix::const_row_iterator q2 = pseudo_.row_begin(i+1);
-            Real x = tmp_[i+1];
-            while (p1 != end) {
-                *p1 = *p2 + x*(*q2);
-                drifts[i] -= *p1*(*q1);
-                ++p1; ++p2; ++q1; ++q2;
-            }
-            */
+            drifts[i] = drift;
         }
 
         // 3rd step: now, move forward from N (included) up to n (excluded)
         // (if N=0 this is the only relevant computation):
+        std::fill(e_.begin(), e_.end(), 0.0);
         for (Size i=numeraire_; i<numberOfRates_; ++i) {
-            drifts[i] = 0.0;
+            const Real x = tmp_[i];
+            Matrix::const_row_iterator p = pseudo_.row_begin(i);
+            Real drift = 0.0;
             for (Size r=0; r<numberOfFactors_; ++r) {
-                if (i==0)
-                    e_[r][i] = tmp_[i] * pseudo_[i][r];
-                else
-                    e_[r][i] = e_[r][i-1] + tmp_[i] * pseudo_[i][r];
-                drifts[i] += e_[r][i]*pseudo_[i][r];
+                e_[r] += x*p[r];
+                drift += e_[r]*p[r];
+            }
+            drifts[i] = drift;
+        }
+    }
+
+    void LMMDriftCalculator::compute(const Matrix& fwds,
+                                     Matrix& drifts) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(fwds.rows()==numberOfRates_, "numberOfRates <> dim");
+            QL_REQUIRE(drifts.rows()==numberOfRates_, "drifts.rows() <> dim");
+            QL_REQUIRE(drifts.columns()==fwds.columns(),
+                       "drifts.columns() <> number of paths");
+        #endif
+
+        if (isFullFactor_)
+            computePlain(fwds, drifts);
+        else
+            computeReduced(fwds, drifts);
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& forwards,
+                                          Matrix& drifts) const {
+
+        // Same as above, with the paths in the innermost loops.
+        const Size paths = forwards.columns();
+        if (tmpPaths_.rows() != numberOfRates_ ||
+            tmpPaths_.columns() != paths)
+            tmpPaths_ = Matrix(numberOfRates_, paths);
+
+        // Precompute forwards factor
+        Size i, j, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator t = tmpPaths_.row_begin(i);
+            const Real d = displacements_[i], x = oneOverTaus_[i];
+            for (p=0; p<paths; ++p)
+                t[p] = (f[p]+d)/(x+f[p]);
+        }
+
+        // Compute drifts
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            for (j=downs_[i]; j<ups_[i]; ++j) {
+                const Real c = C_[i][j];
+                Matrix::const_row_iterator t = tmpPaths_.row_begin(j);
+                for (p=0; p<paths; ++p)
+                    d[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (p=0; p<paths; ++p)
+                    d[p] = -d[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+
+        // Same as above, with the paths in the innermost loops;
+        // ePaths_ holds the partial sums by factor (rows) and path
+        // (columns).
+        const Size paths = forwards.columns();
+        if (tmpPaths_.rows() != numberOfRates_ ||
+            tmpPaths_.columns() != paths)
+            tmpPaths_ = Matrix(numberOfRates_, paths);
+        if (ePaths_.rows() != numberOfFactors_ ||
+            ePaths_.columns() != paths)
+            ePaths_ = Matrix(numberOfFactors_, paths);
+
+        // Precompute forwards factor
+        Size i, r, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator t = tmpPaths_.row_begin(i);
+            const Real d = displacements_[i], x = oneOverTaus_[i];
+            for (p=0; p<paths; ++p)
+                t[p] = (f[p]+d)/(x+f[p]);
+        }
+
+        // 1st step
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step
+        std::fill(ePaths_.begin(), ePaths_.end(), 0.0);
+        for (Integer k=static_cast<Integer>(numeraire_)-2;
+             k>=static_cast<Integer>(alive_); --k) {
+            Matrix::const_row_iterator t = tmpPaths_.row_begin(k+1);
+            Matrix::row_iterator d = drifts.row_begin(k);
+            std::fill(d, d+paths, 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                const Real a0 = pseudo_[k][r], a1 = pseudo_[k+1][r];
+                Matrix::row_iterator e = ePaths_.row_begin(r);
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p]*a1;
+                    d[p] -= e[p]*a0;
+                }
+            }
+        }
+
+        // 3rd step
+        std::fill(ePaths_.begin(), ePaths_.end(), 0.0);
+        for (i=numeraire_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator t = tmpPaths_.row_begin(i);
+            Matrix::row_iterator d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                const Real a = pseudo_[i][r];
+                Matrix::row_iterator e = ePaths_.row_begin(r);
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    d[p] += e[p]*a;
+                }
             }
         }
     }
@@ -65,6 +65,25 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! \name Multiple paths
+
+            The following methods compute the drifts for a number of
+            paths at once.  Each column of the matrices holds the
+            forward rates (or the drifts) for a single path, so that
+            the inner loops run over contiguous paths.  The results
+            are the same as the ones returned by the corresponding
+            single-path methods; drifts for expired rates are left
+            untouched.
+        */
+        //@{
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
+        //@}
+
 
       private:
         Size numberOfRates_, numberOfFactors_;
@@ -73,8 +92,8 @@ namespace QuantLib {
         std::vector<Real> oneOverTaus_;
         Matrix C_, pseudo_;
         // temporary variables to be added later
-        mutable std::vector<Real> tmp_;
-        mutable Matrix e_;
+        mutable std::vector<Real> tmp_, e_;
+        mutable Matrix tmpPaths_, ePaths_;
         std::vector<Size> downs_, ups_;
     };
 
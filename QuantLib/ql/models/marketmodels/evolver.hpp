@@ -22,6 +22,8 @@
 #define quantlib_market_model_evolver_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -42,8 +44,22 @@ namespace QuantLib {
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
         virtual void setInitialState(const CurveState&) = 0;
+
+        /*! returns an independent copy of this evolver, including
+            its initial state, whose next path is the one that this
+            evolver would generate after skipping \c offset paths.
+            Copies with different offsets can evolve concurrently;
+            see BrownianGenerator::substream().
+        */
+        virtual boost::shared_ptr<MarketModelEvolver>
+                                             substream(Size offset) const;
     };
 
+    inline boost::shared_ptr<MarketModelEvolver>
+    MarketModelEvolver::substream(Size) const {
+        QL_FAIL("substreams not supported by this evolver");
+    }
+
 }
 
 #endif
@@ -160,4 +160,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalCmSwapRatePc::substream(Size offset) const {
+        boost::shared_ptr<LogNormalCmSwapRatePc> evolver(
+                                             new LogNormalCmSwapRatePc(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -157,4 +157,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalCotSwapRatePc::substream(Size offset) const {
+        boost::shared_ptr<LogNormalCotSwapRatePc> evolver(
+                                            new LogNormalCotSwapRatePc(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
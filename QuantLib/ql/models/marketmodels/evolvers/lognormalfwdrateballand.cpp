@@ -154,4 +154,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateBalland::substream(Size offset) const {
+        boost::shared_ptr<LogNormalFwdRateBalland> evolver(
+                                           new LogNormalFwdRateBalland(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -143,4 +143,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateEuler::substream(Size offset) const {
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver(
+                                             new LogNormalFwdRateEuler(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -46,6 +46,7 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> substream(Size offset) const;
         //@}
 
         //! accessor methods useful for doing pathwise vegas
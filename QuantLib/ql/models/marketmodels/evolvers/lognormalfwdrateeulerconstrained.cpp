@@ -234,4 +234,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateEulerConstrained::substream(Size offset) const {
+        boost::shared_ptr<LogNormalFwdRateEulerConstrained> evolver(
+                                new LogNormalFwdRateEulerConstrained(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -156,4 +156,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateiBalland::substream(Size offset) const {
+        boost::shared_ptr<LogNormalFwdRateiBalland> evolver(
+                                          new LogNormalFwdRateiBalland(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -151,4 +151,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateIpc::substream(Size offset) const {
+        boost::shared_ptr<LogNormalFwdRateIpc> evolver(
+                                               new LogNormalFwdRateIpc(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
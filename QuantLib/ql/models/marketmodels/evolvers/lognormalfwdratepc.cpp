@@ -144,6 +144,119 @@ namespace QuantLib {
         return weight;
     }
 
+    void LogNormalFwdRatePc::startNewPaths(Size paths,
+                                           std::vector<Real>& weights) {
+        QL_REQUIRE(paths > 0, "at least one path required");
+        const Size steps = calculators_.size() - initialStep_;
+
+        pathBrownians_.resize(steps);
+        for (Size j=0; j<steps; ++j) {
+            if (pathBrownians_[j].columns() != paths)
+                pathBrownians_[j] = Matrix(numberOfFactors_, paths);
+        }
+        if (pathWeights_.columns() != paths) {
+            pathWeights_ = Matrix(steps, paths);
+            pathForwards_ = Matrix(numberOfRates_, paths);
+            pathLogForwards_ = Matrix(numberOfRates_, paths);
+            pathDrifts1_ = Matrix(numberOfRates_, paths);
+            pathDrifts2_ = Matrix(numberOfRates_, paths);
+            pathDiffusions_.resize(paths);
+        }
+
+        // the increments are drawn path by path, as the generator
+        // would provide them to the single-path interface
+        weights.resize(paths);
+        for (Size p=0; p<paths; ++p) {
+            weights[p] = generator_->nextPath();
+            for (Size j=0; j<steps; ++j) {
+                pathWeights_[j][p] = generator_->nextStep(brownians_);
+                for (Size r=0; r<numberOfFactors_; ++r)
+                    pathBrownians_[j][r][p] = brownians_[r];
+            }
+        }
+
+        for (Size i=0; i<numberOfRates_; ++i) {
+            const Real l = initialLogForwards_[i];
+            const Real f = std::exp(l) - displacements_[i];
+            std::fill(pathLogForwards_.row_begin(i),
+                      pathLogForwards_.row_end(i), l);
+            std::fill(pathForwards_.row_begin(i),
+                      pathForwards_.row_end(i), f);
+        }
+
+        currentStep_ = initialStep_;
+    }
+
+    void LogNormalFwdRatePc::advanceSteps(std::vector<Real>& weights) {
+        const Size paths = pathForwards_.columns();
+        QL_REQUIRE(paths > 0, "no paths started");
+        QL_REQUIRE(currentStep_ < calculators_.size(),
+                   "no steps left to take");
+
+        // the same steps as in advanceStep(), with the paths in the
+        // innermost loops
+
+        // a) compute drifts D1 at T1;
+        Size i, r, p;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(pathForwards_, pathDrifts1_);
+        } else {
+            for (i=0; i<numberOfRates_; ++i)
+                std::fill(pathDrifts1_.row_begin(i),
+                          pathDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        const Matrix& brownians = pathBrownians_[currentStep_-initialStep_];
+
+        Size alive = alive_[currentStep_];
+        for (i=alive; i<numberOfRates_; ++i) {
+            std::fill(pathDiffusions_.begin(), pathDiffusions_.end(), 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                const Real a = A[i][r];
+                Matrix::const_row_iterator z = brownians.row_begin(r);
+                for (p=0; p<paths; ++p)
+                    pathDiffusions_[p] += a*z[p];
+            }
+            Matrix::row_iterator l = pathLogForwards_.row_begin(i);
+            Matrix::row_iterator f = pathForwards_.row_begin(i);
+            Matrix::const_row_iterator d = pathDrifts1_.row_begin(i);
+            const Real fixed = fixedDrift[i], displacement = displacements_[i];
+            for (p=0; p<paths; ++p) {
+                l[p] += d[p] + fixed;
+                l[p] += pathDiffusions_[p];
+                f[p] = std::exp(l[p]) - displacement;
+            }
+        }
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].compute(pathForwards_, pathDrifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Matrix::row_iterator l = pathLogForwards_.row_begin(i);
+            Matrix::row_iterator f = pathForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = pathDrifts1_.row_begin(i);
+            Matrix::const_row_iterator d2 = pathDrifts2_.row_begin(i);
+            const Real displacement = displacements_[i];
+            for (p=0; p<paths; ++p) {
+                l[p] += (d2[p]-d1[p])/2.0;
+                f[p] = std::exp(l[p]) - displacement;
+            }
+        }
+
+        weights.assign(pathWeights_.row_begin(currentStep_-initialStep_),
+                       pathWeights_.row_end(currentStep_-initialStep_));
+
+        ++currentStep_;
+    }
+
+    const Matrix& LogNormalFwdRatePc::currentForwards() const {
+        return pathForwards_;
+    }
+
     Size LogNormalFwdRatePc::currentStep() const {
         return currentStep_;
     }
@@ -152,4 +265,12 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRatePc::substream(Size offset) const {
+        boost::shared_ptr<LogNormalFwdRatePc> evolver(
+                                                new LogNormalFwdRatePc(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -46,6 +46,29 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> substream(Size offset) const;
+        //@}
+        /*! \name Multiple paths
+
+            The following methods evolve a number of paths at once;
+            the forwards of each path are stored in a column of a
+            matrix, and the drifts of all paths are computed together
+            by the multiple-path methods of LMMDriftCalculator.
+
+            The Brownian increments of all steps are drawn when the
+            paths are started, in the same order in which
+            startNewPath() and advanceStep() would draw them; thus,
+            the i-th path is the same as the i-th one obtained by the
+            single-path interface when all steps are taken. The curve
+            state returned by currentState() is not updated.
+        */
+        //@{
+        //! starts the given number of paths and returns their weights
+        void startNewPaths(Size paths, std::vector<Real>& weights);
+        //! advances all paths and returns the weights of the step
+        void advanceSteps(std::vector<Real>& weights);
+        //! current forwards, one column per path
+        const Matrix& currentForwards() const;
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -66,6 +89,11 @@ namespace QuantLib {
         std::vector<Size> alive_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
+        // working variables for multiple paths
+        Matrix pathForwards_, pathLogForwards_, pathDrifts1_, pathDrifts2_;
+        std::vector<Matrix> pathBrownians_;
+        Matrix pathWeights_;
+        std::vector<Real> pathDiffusions_;
     };
 
 }
@@ -143,4 +143,11 @@ namespace QuantLib {
         return curveState_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    NormalFwdRatePc::substream(Size offset) const {
+        boost::shared_ptr<NormalFwdRatePc> evolver(new NormalFwdRatePc(*this));
+        evolver->generator_ = generator_->substream(offset);
+        return evolver;
+    }
+
 }
@@ -23,6 +23,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/utilities/parallel.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -38,7 +39,8 @@ namespace QuantLib {
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
         cashFlowsGenerated_(product->numberOfProducts()) ,
-        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
+        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1),
+        threads_(Null<Size>()), blockSize_(1024)
     {
 
         numberRates_ = pseudoRootStructure_->numberOfRates();
@@ -312,6 +314,12 @@ namespace QuantLib {
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
         Size numberOfPaths)
     {
+        if (threads_ != Null<Size>())
+        {
+            multiplePathValuesInParallel(stats, numberOfPaths);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -320,6 +328,87 @@ namespace QuantLib {
         }
     }
 
+    void PathwiseAccountingEngine::multiplePathValuesInParallel(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths)
+    {
+        if (numberOfPaths == 0)
+            return;
+
+        const Size threads = parallelThreads(threads_);
+        const Size blocks = (numberOfPaths + blockSize_ - 1) / blockSize_;
+        // blocks are processed in batches to limit memory usage
+        const Size batchSize = std::max<Size>(threads*4, 1);
+        const Size n = numberProducts_*(numberRates_+1);
+
+        std::vector<Real> weights(std::min(blocks,batchSize)*blockSize_);
+        std::vector<Real> values(weights.size()*n);
+
+        for (Size first = 0; first < blocks; first += batchSize)
+        {
+            const Size last = std::min(first + batchSize, blocks);
+            ParallelErrors errors;
+
+            #if defined(_OPENMP)
+            #pragma omp parallel for num_threads(threads) schedule(dynamic)
+            #endif
+            for (long b = long(first); b < long(last); ++b)
+            {
+                try
+                {
+                    const Size start = Size(b)*blockSize_;
+                    const Size size = std::min(blockSize_,
+                                               numberOfPaths-start);
+                    PathwiseAccountingEngine worker(*this);
+                    worker.evolver_ =
+                        boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                                 evolver_->substream(start));
+                    std::vector<Real> pathValues(n);
+                    const Size offset = (Size(b)-first)*blockSize_;
+                    for (Size j=0; j<size; ++j)
+                    {
+                        weights[offset+j] =
+                            worker.singlePathValues(pathValues);
+                        std::copy(pathValues.begin(), pathValues.end(),
+                                  values.begin() + (offset+j)*n);
+                    }
+                }
+                catch (std::exception& e)
+                {
+                    errors.record(e.what());
+                }
+                catch (...)
+                {
+                    errors.record("unknown error in parallel simulation");
+                }
+            }
+
+            errors.rethrow();
+
+            const Size start = first*blockSize_;
+            const Size size = std::min(last*blockSize_, numberOfPaths) - start;
+            for (Size j=0; j<size; ++j)
+                stats.add(values.begin() + j*n, values.begin() + (j+1)*n,
+                          weights[j]);
+        }
+
+        evolver_ = boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                          evolver_->substream(numberOfPaths));
+    }
+
+    void PathwiseAccountingEngine::enableParallelSampling(Size threads,
+                                                          Size blockSize)
+    {
+        QL_REQUIRE(blockSize > 0, "null block size given");
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+        blockSize_ = blockSize;
+    }
+
+    void PathwiseAccountingEngine::disableParallelSampling()
+    {
+        threads_ = Null<Size>();
+    }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
  
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +41,8 @@ namespace QuantLib {
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, and requires knowledge of pseudo-roots and displacements 
     // This is tested in MarketModelTest::testPathwiseGreeks
+    // Paths can be simulated in parallel as in AccountingEngine;
+    // this is tested in MarketModelTest::testParallelAccountingEngines
     class PathwiseAccountingEngine 
     {
       public:
@@ -51,8 +53,17 @@ namespace QuantLib {
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! \name Parallel sampling
+        //@{
+        //! see AccountingEngine::enableParallelSampling()
+        void enableParallelSampling(Size threads = 0,
+                                    Size blockSize = 1024);
+        void disableParallelSampling();
+        //@}
       private:
           Real singlePathValues(std::vector<Real>& values);
+          void multiplePathValuesInParallel(SequenceStatisticsInc& stats,
+                                            Size numberOfPaths);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -95,6 +106,7 @@ namespace QuantLib {
 
         std::vector<std::vector<Size> > cashFlowIndicesThisStep_;
 
+        Size threads_, blockSize_;
     };
 
 
@@ -19,6 +19,9 @@
 
 #include <ql/models/model.hpp>
 #include <ql/math/optimization/problem.hpp>
+#include <ql/pricingengine.hpp>
+#include <ql/utilities/parallel.hpp>
+#include <set>
 
 namespace QuantLib {
 
@@ -29,7 +32,8 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None), threads_(Null<Size>()),
+      functionEvaluation_(0), gradientEvaluation_(0), calibrationTime_(0.0) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -37,18 +41,20 @@ namespace QuantLib {
                   CalibratedModel* model,
                   const std::vector<boost::shared_ptr<CalibrationHelper> >&
                                                                   instruments,
-                  const std::vector<Real>& weights)
+                  const std::vector<Real>& weights,
+                  Size threads = Null<Size>())
         : model_(model, no_deletion), instruments_(instruments),
-          weights_(weights) {}
+          weights_(weights), threads_(threads), evaluated_(false) {}
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(params);
+            Array errors = calibrationErrors();
 
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
 
@@ -57,11 +63,10 @@ namespace QuantLib {
 
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(params);
+            Array values = calibrationErrors();
 
-            Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
 
             return values;
@@ -69,9 +74,39 @@ namespace QuantLib {
 
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
       private:
+        Disposable<Array> calibrationErrors() const {
+            Array errors(instruments_.size());
+            const long n = instruments_.size();
+            if (threads_ == Null<Size>() || !evaluated_) {
+                for (long i=0; i<n; ++i)
+                    errors[i] = instruments_[i]->calibrationError();
+                evaluated_ = true;
+                return errors;
+            }
+
+            ParallelErrors failures;
+            #if defined(_OPENMP)
+            const Size threads = parallelThreads(threads_);
+            #pragma omp parallel for num_threads(threads) schedule(dynamic)
+            #endif
+            for (long i=0; i<n; ++i) {
+                try {
+                    errors[i] = instruments_[i]->calibrationError();
+                } catch (std::exception& e) {
+                    failures.record(e.what());
+                } catch (...) {
+                    failures.record("unknown error in parallel calibration");
+                }
+            }
+            failures.rethrow();
+            return errors;
+        }
+
         boost::shared_ptr<CalibratedModel> model_;
         const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments_;
         std::vector<Real> weights_;
+        Size threads_;
+        mutable bool evaluated_;
     };
 
     void CalibratedModel::calibrate(
@@ -93,13 +128,26 @@ namespace QuantLib {
         std::vector<Real> w = weights.empty() ?
                               std::vector<Real>(instruments.size(), 1.0):
                               weights;
-        CalibrationFunction f(this, instruments, w);
+        if (threads_ != Null<Size>()) {
+            std::set<PricingEngine*> engines;
+            for (Size i=0; i<instruments.size(); ++i) {
+                PricingEngine* engine = instruments[i]->pricingEngine().get();
+                QL_REQUIRE(engine == 0 || engines.insert(engine).second,
+                           "pricing engine shared by more than one helper; "
+                           "parallel calibration requires separate engines");
+            }
+        }
+        CalibrationFunction f(this, instruments, w, threads_);
 
+        const Real start = wallClockTime();
         Problem prob(f, c, params());
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
+        functionEvaluation_ = prob.functionEvaluation();
+        gradientEvaluation_ = prob.gradientEvaluation();
         Array result(prob.currentValue());
         setParams(result);
         Array shortRateProblemValues_ = prob.values(result);
+        calibrationTime_ = wallClockTime() - start;
 
         notifyObservers();
     }
@@ -108,6 +156,14 @@ namespace QuantLib {
         return shortRateEndCriteria_;
     }
 
+    void CalibratedModel::enableParallelCalibration(Size threads) {
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+    }
+
+    void CalibratedModel::disableParallelCalibration() {
+        threads_ = Null<Size>();
+    }
+
     Real CalibratedModel::value(const Array& params,
        const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments) {
         std::vector<Real> w = std::vector<Real>(instruments.size(), 1.0);
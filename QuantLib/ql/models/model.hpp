@@ -76,6 +76,26 @@ namespace QuantLib {
 
 
     //! Calibrated model class
+    /*! The calibration errors of the helpers are evaluated serially
+        by default.  When parallel calibration is enabled, they are
+        evaluated concurrently for each set of trial parameters; the
+        parameters are still set, and the model notifies its
+        observers, in the calling thread.  The first evaluation is
+        always performed serially, so that it also performs the lazy
+        calculations of the term structures and other market data
+        used by the helpers.
+
+        \warning Pricing engines can't be shared between threads;
+                 therefore, each helper must be given its own engine
+                 when parallel calibration is enabled.  Helpers
+                 using the ImpliedVolError type create engines while
+                 they are evaluated and should not be calibrated in
+                 parallel.
+
+        \test the results of a parallel calibration, and of a
+              calibration using the jacobian of the cost function,
+              are checked against those of a serial calibration.
+    */
     class CalibratedModel : public virtual Observer, public virtual Observable {
       public:
         CalibratedModel(Size nArguments);
@@ -102,11 +122,25 @@ namespace QuantLib {
         const boost::shared_ptr<Constraint>& constraint() const;
         //! returns end criteria result
         EndCriteria::Type endCriteria();
+        //! number of cost function evaluations in the last calibration
+        Integer functionEvaluation() const;
+        //! number of jacobian or gradient evaluations in the last calibration
+        Integer gradientEvaluation() const;
+        //! wall-clock time in seconds taken by the last calibration
+        Real calibrationTime() const;
         //! Returns array of arguments on which calibration is done
         Disposable<Array> params() const;
 
         virtual void setParams(const Array& params);
 
+        //! \name Parallel calibration
+        //@{
+        /*! A null or zero number of threads selects all the available
+            ones; see parallelThreads(). */
+        void enableParallelCalibration(Size threads = 0);
+        void disableParallelCalibration();
+        //@}
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -114,6 +148,9 @@ namespace QuantLib {
         EndCriteria::Type shortRateEndCriteria_;
 
       private:
+        Size threads_;
+        Integer functionEvaluation_, gradientEvaluation_;
+        Real calibrationTime_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -136,6 +173,18 @@ namespace QuantLib {
         return constraint_;
     }
 
+    inline Integer CalibratedModel::functionEvaluation() const {
+        return functionEvaluation_;
+    }
+
+    inline Integer CalibratedModel::gradientEvaluation() const {
+        return gradientEvaluation_;
+    }
+
+    inline Real CalibratedModel::calibrationTime() const {
+        return calibrationTime_;
+    }
+
     class CalibratedModel::PrivateConstraint : public Constraint {
       private:
         class Impl :  public Constraint::Impl {
@@ -89,6 +89,19 @@ namespace QuantLib {
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
       tree_(tree), dynamics_(dynamics) {}
 
+    void OneFactorModel::ShortRateTree::computeDiscounts() const {
+        // the discount at the last time is not needed for rollbacks
+        const Size steps = timeGrid().size() - 1;
+        std::vector<Array> discounts(steps);
+        for (Size i=0; i<steps; ++i) {
+            Array d(size(i));
+            for (Size j=0; j<d.size(); ++j)
+                d[j] = discount(i, j);
+            discounts[i] = d;
+        }
+        discounts_.swap(discounts);
+    }
+
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
 
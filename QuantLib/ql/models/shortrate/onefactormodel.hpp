@@ -72,6 +72,12 @@ namespace QuantLib {
     };
 
     //! Recombining trinomial tree discretizing the state variable
+    /*! The discount factors at the nodes are calculated once, at
+        the first rollback (i.e., after the tree is fitted, even when
+        the fitting is performed by the model after construction) and
+        rollbacks are performed by the trinomial tree on contiguous
+        arrays.
+    */
     class OneFactorModel::ShortRateTree
         : public TreeLattice1D<OneFactorModel::ShortRateTree> {
       public:
@@ -90,10 +96,17 @@ namespace QuantLib {
             return tree_->size(i);
         }
         DiscountFactor discount(Size i, Size index) const {
+            if (i < discounts_.size())
+                return discounts_[i][index];
             Real x = tree_->underlying(i, index);
             Rate r = dynamics_->shortRate(timeGrid()[i], x);
             return std::exp(-r*timeGrid().dt(i));
         }
+        void stepback(Size i, const Array& values, Array& newValues) const {
+            if (discounts_.empty())
+                computeDiscounts();
+            tree_->stepback(i, values, discounts_[i], newValues);
+        }
         Real underlying(Size i, Size index) const {
             return tree_->underlying(i, index);
         }
@@ -104,8 +117,10 @@ namespace QuantLib {
             return tree_->probability(i, index, branch);
         }
       private:
+        void computeDiscounts() const;
         boost::shared_ptr<TrinomialTree> tree_;
         boost::shared_ptr<ShortRateDynamics> dynamics_;
+        mutable std::vector<Array> discounts_;
         class Helper;
     };
 
@@ -28,22 +28,45 @@
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#endif
 
 #include <set>
+#include <vector>
 
 namespace QuantLib {
 
     class Observer;
+    class ObservableSettings;
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! When the library is compiled with the
+        QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN macro defined,
+        registration and notification can be performed concurrently
+        from different threads.
+
+        \warning even in thread-safe mode, an observer must not be
+                 destroyed by a thread while another one might be
+                 notifying it. Also, an observer unregistering from a
+                 thread might still receive a notification that another
+                 thread started before.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
       public:
+        typedef std::set<Observer*> set_type;
+        typedef set_type::iterator iterator;
         // constructors, assignment, destructor
-        Observable() {}
+        Observable();
         Observable(const Observable&);
         Observable& operator=(const Observable&);
         virtual ~Observable() {}
@@ -52,10 +75,78 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*>::iterator iterator;
         std::pair<iterator, bool> registerObserver(Observer*);
         Size unregisterObserver(Observer*);
-        std::set<Observer*> observers_;
+        set_type observers_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        mutable boost::recursive_mutex mutex_;
+        #endif
+    };
+
+    //! global settings for the observer pattern
+    /*! Notifications can be globally disabled, e.g., while a number
+        of market quotes are being set. If updates are disabled with
+        the <tt>deferred</tt> flag set, the observers which would have
+        been notified are collected (each of them only once) and
+        notified when updates are enabled again; the ensuing
+        propagation is performed breadth-first, so that each observer
+        downstream is also notified at most once per level of the
+        observer graph.
+
+        \ingroup patterns
+    */
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+      public:
+        void disableUpdates(bool deferred = false);
+        /*! Re-enables notifications and, if they were deferred,
+            notifies the collected observers.
+        */
+        void enableUpdates();
+        bool updatesEnabled() const;
+        bool updatesDeferred() const;
+        //! number of observers waiting for a deferred notification
+        Size deferredObservers() const;
+      private:
+        ObservableSettings();
+        void registerDeferredObservers(const Observable::set_type&);
+        void unregisterDeferredObserver(Observer*);
+        Observable::set_type deferredObservers_;
+        bool updatesEnabled_, updatesDeferred_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        mutable boost::recursive_mutex mutex_;
+        #endif
+    };
+
+    //! Scope guard for batches of deferred notifications
+    /*! Notifications are deferred from construction until either
+        commit() is called or the instance goes out of scope. Nested
+        instances are allowed; only the outermost one flushes the
+        collected notifications.
+
+        \code
+        {
+            ObservableBatchUpdate batch;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(values[i]);
+            batch.commit();
+        }
+        \endcode
+
+        \warning Exceptions thrown by observers while flushing are
+                 swallowed by the destructor; call commit() explicitly
+                 if they need to be reported.
+
+        \ingroup patterns
+    */
+    class ObservableBatchUpdate : private boost::noncopyable {
+      public:
+        ObservableBatchUpdate();
+        ~ObservableBatchUpdate();
+        void commit();
+      private:
+        bool owner_;
     };
 
     //! Object that gets notified when a given observable changes
@@ -81,11 +172,16 @@ namespace QuantLib {
       private:
         std::set<boost::shared_ptr<Observable> > observables_;
         typedef std::set<boost::shared_ptr<Observable> >::iterator iterator;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        mutable boost::recursive_mutex mutex_;
+        #endif
     };
 
 
     // inline definitions
 
+    inline Observable::Observable() {}
+
     inline Observable::Observable(const Observable&) {
         // the observer set is not copied; no observer asked to
         // register with this object
@@ -107,65 +203,248 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::set<Observer*>::iterator, bool>
+    inline std::pair<Observable::iterator, bool>
     Observable::registerObserver(Observer* o) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
         return observers_.insert(o);
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
+        ObservableSettings::instance().unregisterDeferredObserver(o);
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
         return observers_.erase(o);
     }
 
+    namespace detail {
+
+        template <class Iterator>
+        void notifyAll(Iterator begin, Iterator end) {
+            bool successful = true;
+            std::string errMsg;
+            for (Iterator i=begin; i!=end; ++i) {
+                try {
+                    (*i)->update();
+                } catch (std::exception& e) {
+                    // quite a dilemma. If we don't catch the exception,
+                    // other observers will not receive the notification
+                    // and might be left in an incorrect state. If we do
+                    // catch it and continue the loop (as we do here) we
+                    // lose the exception. The least evil might be to try
+                    // and notify all observers, while raising an
+                    // exception if something bad happened.
+                    successful = false;
+                    errMsg = e.what();
+                } catch (...) {
+                    successful = false;
+                }
+            }
+            QL_ENSURE(successful,
+                      "could not notify one or more observers: " << errMsg);
+        }
+
+    }
+
     inline void Observable::notifyObservers() {
-        bool successful = true;
-        std::string errMsg;
-        for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (!settings.updatesEnabled()) {
+            if (settings.updatesDeferred()) {
+                #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+                // copied so that no lock is held while registering
+                set_type observers;
+                {
+                    boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+                    observers = observers_;
+                }
+                settings.registerDeferredObservers(observers);
+                #else
+                settings.registerDeferredObservers(observers_);
+                #endif
+            }
+            return;
+        }
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        // the observers are copied and notified after the lock is
+        // released; since update() often notifies other observables,
+        // holding it could deadlock two threads notifying objects
+        // registered with each other.
+        std::vector<Observer*> observers;
+        {
+            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+            observers.assign(observers_.begin(), observers_.end());
+        }
+        detail::notifyAll(observers.begin(), observers.end());
+        #else
+        detail::notifyAll(observers_.begin(), observers_.end());
+        #endif
+    }
+
+
+    inline ObservableSettings::ObservableSettings()
+    : updatesEnabled_(true), updatesDeferred_(false) {}
+
+    inline void ObservableSettings::disableUpdates(bool deferred) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
+        updatesEnabled_ = false;
+        updatesDeferred_ = deferred;
+    }
+
+    inline void ObservableSettings::enableUpdates() {
+        // Notifications stay deferred while the collected observers
+        // are updated, so that the observers downstream are collected
+        // (and deduplicated) in turn for the next round. No lock is
+        // held while observers are being updated.
+        std::vector<Observer*> observers;
+        for (;;) {
+            {
+                #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+                #endif
+                if (deferredObservers_.empty()) {
+                    updatesEnabled_ = true;
+                    updatesDeferred_ = false;
+                    return;
+                }
+                observers.assign(deferredObservers_.begin(),
+                                 deferredObservers_.end());
+                deferredObservers_.clear();
+            }
             try {
-                (*i)->update();
-            } catch (std::exception& e) {
-                // quite a dilemma. If we don't catch the exception,
-                // other observers will not receive the notification
-                // and might be left in an incorrect state. If we do
-                // catch it and continue the loop (as we do here) we
-                // lose the exception. The least evil might be to try
-                // and notify all observers, while raising an
-                // exception if something bad happened.
-                successful = false;
-                errMsg = e.what();
+                detail::notifyAll(observers.begin(), observers.end());
             } catch (...) {
-                successful = false;
+                #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+                #endif
+                deferredObservers_.clear();
+                updatesEnabled_ = true;
+                updatesDeferred_ = false;
+                throw;
             }
         }
-        QL_ENSURE(successful,
-                  "could not notify one or more observers: " << errMsg);
     }
 
+    inline bool ObservableSettings::updatesEnabled() const {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
+        return updatesEnabled_;
+    }
+
+    inline bool ObservableSettings::updatesDeferred() const {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
+        return updatesDeferred_;
+    }
+
+    inline Size ObservableSettings::deferredObservers() const {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
+        return deferredObservers_.size();
+    }
+
+    inline void ObservableSettings::registerDeferredObservers(
+                                       const Observable::set_type& observers) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
+        if (updatesDeferred_)
+            deferredObservers_.insert(observers.begin(), observers.end());
+    }
+
+    inline void ObservableSettings::unregisterDeferredObserver(Observer* o) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
+        if (!deferredObservers_.empty())
+            deferredObservers_.erase(o);
+    }
+
+
+    inline ObservableBatchUpdate::ObservableBatchUpdate()
+    : owner_(false) {
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (settings.updatesEnabled()) {
+            settings.disableUpdates(true);
+            owner_ = true;
+        }
+    }
 
-    inline Observer::Observer(const Observer& o)
-    : observables_(o.observables_) {
+    inline ObservableBatchUpdate::~ObservableBatchUpdate() {
+        try {
+            commit();
+        } catch (...) {
+            // nothing we can do from a destructor
+        }
+    }
+
+    inline void ObservableBatchUpdate::commit() {
+        if (owner_) {
+            owner_ = false;
+            ObservableSettings::instance().enableUpdates();
+        }
+    }
+
+
+    // In the following, the lock on the observer is never held while
+    // calling into an observable, and observables release their own
+    // lock before notifying; thus, no thread ever waits for a lock
+    // while holding another one.
+
+    inline Observer::Observer(const Observer& o) {
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::lock_guard<boost::recursive_mutex> lock(o.mutex_);
+            #endif
+            observables_ = o.observables_;
+        }
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->registerObserver(this);
     }
 
     inline Observer& Observer::operator=(const Observer& o) {
+        if (&o == this)
+            return *this;
+        std::set<boost::shared_ptr<Observable> > observables;
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::lock_guard<boost::recursive_mutex> lock(o.mutex_);
+            #endif
+            observables = o.observables_;
+        }
         iterator i;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(this);
-        observables_ = o.observables_;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
+        for (i=observables.begin(); i!=observables.end(); ++i)
             (*i)->registerObserver(this);
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+            #endif
+            observables_.swap(observables);
+        }
+        // observables now holds the previous set
+        for (i=observables.begin(); i!=observables.end(); ++i)
+            if (observables_.find(*i) == observables_.end())
+                (*i)->unregisterObserver(this);
         return *this;
     }
 
     inline Observer::~Observer() {
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(this);
+        unregisterWithAll();
     }
 
     inline std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
     Observer::registerWith(const boost::shared_ptr<Observable>& h) {
         if (h) {
             h->registerObserver(this);
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+            #endif
             return observables_.insert(h);
         }
         return std::make_pair(observables_.end(), false);
@@ -175,13 +454,22 @@ namespace QuantLib {
     Size Observer::unregisterWith(const boost::shared_ptr<Observable>& h) {
         if (h)
             h->unregisterObserver(this);
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
         return observables_.erase(h);
     }
 
     inline void Observer::unregisterWithAll() {
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+        std::set<boost::shared_ptr<Observable> > observables;
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+            #endif
+            observables_.swap(observables);
+        }
+        for (iterator i=observables.begin(); i!=observables.end(); ++i)
             (*i)->unregisterObserver(this);
-        observables_.clear();
     }
 
 }
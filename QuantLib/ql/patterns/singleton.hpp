@@ -27,6 +27,11 @@
 #include <ql/types.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+    || defined(QL_ENABLE_THREAD_SESSIONS)
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#endif
 #include <map>
 
 namespace QuantLib {
@@ -36,6 +41,74 @@ namespace QuantLib {
     Integer sessionId();
     #endif
 
+    #if defined(QL_ENABLE_THREAD_SESSIONS)
+
+    #if defined(QL_ENABLE_SESSIONS)
+    #error QL_ENABLE_SESSIONS and QL_ENABLE_THREAD_SESSIONS are exclusive
+    #endif
+
+    #if defined(BOOST_MSVC)
+    #define QL_THREAD_LOCAL __declspec(thread)
+    #else
+    #define QL_THREAD_LOCAL __thread
+    #endif
+
+    //! Session bound to the current thread
+    /*! When QL_ENABLE_THREAD_SESSIONS is defined, singletons return
+        a different instance for each session. An instance of this
+        class binds the current thread to the given session for the
+        duration of its scope; the previous session of the thread is
+        restored when it goes out of scope. Threads that were not
+        bound explicitly belong to session 0.
+
+        Thus, threads bound to different sessions can run with
+        different evaluation dates, as in:
+        \code
+        #pragma omp parallel for
+        for (long i=0; i<n; ++i) {
+            ThreadSession session(omp_get_thread_num()+1);
+            Settings::instance().evaluationDate() = dates[i];
+            ... // build and price the instruments
+        }
+        \endcode
+        Notifications are scoped to the session as well, since term
+        structures and instruments register with the evaluation date
+        of the session in which they are created.
+
+        \warning All singletons are duplicated, including the index
+                 manager; past fixings must be added in each session
+                 that needs them. Objects depending on the settings
+                 must only be used in the session in which they were
+                 created, and other objects can be shared only if
+                 the observer pattern is thread-safe. Finally, the
+                 instances created for a session are kept until the
+                 program exits; session ids should be reused (e.g.,
+                 one per thread rather than one per task.)
+
+        \ingroup patterns
+    */
+    class ThreadSession : private boost::noncopyable {
+      public:
+        explicit ThreadSession(Integer id) : previous_(current()) {
+            currentId() = id;
+        }
+        ~ThreadSession() {
+            currentId() = previous_;
+        }
+        //! session to which the current thread is bound
+        static Integer current() {
+            return currentId();
+        }
+      private:
+        static Integer& currentId() {
+            static QL_THREAD_LOCAL Integer id = 0;
+            return id;
+        }
+        Integer previous_;
+    };
+
+    #endif
+
     // this is required on VC++ (with a slightly different syntax depending
     // on the compiler version) when CLR support is enabled
     #if defined(QL_PATCH_MSVC71)
@@ -75,15 +148,34 @@ namespace QuantLib {
 
     template <class T>
     T& Singleton<T>::instance() {
+        #if defined(QL_ENABLE_THREAD_SESSIONS)
+        // the last instance returned to each thread is cached, so
+        // that the lock below is only taken when the session changes
+        static QL_THREAD_LOCAL T* cached = 0;
+        static QL_THREAD_LOCAL Integer cachedId = 0;
+        Integer id = ThreadSession::current();
+        if (cached != 0 && cachedId == id)
+            return *cached;
+        #endif
         static std::map<Integer, boost::shared_ptr<T> > instances_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+            || defined(QL_ENABLE_THREAD_SESSIONS)
+        // instances might be requested concurrently
+        static boost::mutex mutex_;
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        #endif
         #if defined(QL_ENABLE_SESSIONS)
         Integer id = sessionId();
-        #else
+        #elif !defined(QL_ENABLE_THREAD_SESSIONS)
         Integer id = 0;
         #endif
         boost::shared_ptr<T>& instance = instances_[id];
         if (!instance)
             instance = boost::shared_ptr<T>(new T);
+        #if defined(QL_ENABLE_THREAD_SESSIONS)
+        cached = instance.get();
+        cachedId = id;
+        #endif
         return *instance;
     }
 
@@ -74,7 +74,8 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed);
+             BigNatural seed,
+             Size nThreads = Null<Size>());
         void calculate() const {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
@@ -126,6 +127,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withThreads(Size threads = 0);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +136,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -192,8 +195,9 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false),
+             BigNatural seed,
+             Size nThreads)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false, nThreads),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -212,6 +216,10 @@ namespace QuantLib {
         QL_REQUIRE(timeStepsPerYear != 0,
                    "timeStepsPerYear must be positive, " << timeStepsPerYear <<
                    " not allowed");
+        // the unbiased path pricer draws its own random numbers
+        QL_REQUIRE(isBiased || nThreads == Null<Size>(),
+                   "parallel sampling is only available "
+                   "with the biased path pricer");
         registerWith(process_);
     }
 
@@ -278,7 +286,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +358,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -367,7 +382,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   threads_));
     }
 
 }
@@ -27,12 +27,16 @@
 
 #include <ql/models/model.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
-        method
+        method.  If no time grid is passed to the constructor, they
+        should obtain their lattice through the tree() method, which
+        reuses the last lattice built when the instrument requires
+        the same time grid.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -49,9 +53,17 @@ namespace QuantLib {
                                const TimeGrid& timeGrid);
         void update();
       protected:
+        //! lattice on the given grid
+        /*! The last lattice built is reused if the grid is the same;
+            it is discarded when the engine is notified of a change.
+        */
+        boost::shared_ptr<Lattice> tree(const TimeGrid& grid) const;
         TimeGrid timeGrid_;
         Size timeSteps_;
         boost::shared_ptr<Lattice> lattice_;
+      private:
+        mutable TimeGrid cachedGrid_;
+        mutable boost::shared_ptr<Lattice> cachedLattice_;
     };
 
     template <class Arguments, class Results>
@@ -90,9 +102,22 @@ namespace QuantLib {
     {
         if (!timeGrid_.empty())
             lattice_ = this->model_->tree(timeGrid_);
+        cachedLattice_.reset();
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
+    template <class Arguments, class Results>
+    boost::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::tree(
+                                                const TimeGrid& grid) const {
+        if (!cachedLattice_ || cachedGrid_.size() != grid.size() ||
+            !std::equal(grid.begin(), grid.end(), cachedGrid_.begin())) {
+            cachedLattice_ = this->model_->tree(grid);
+            cachedGrid_ = grid;
+        }
+        return cachedLattice_;
+    }
+
 }
 
 
@@ -37,6 +37,11 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        If a number of threads is passed to the constructor, the
+        calibration of the Longstaff-Schwartz path pricer is also
+        performed in parallel; see
+        LongstaffSchwartzPathPricer::enableParallelCalibration().
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -64,7 +69,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            Size nThreads = Null<Size>());
 
         void calculate() const;
 
@@ -104,8 +110,9 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
-    : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
+            Size nCalibrationSamples,
+            Size nThreads)
+    : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate, nThreads),
       process_            (process),
       timeSteps_          (timeSteps),
       timeStepsPerYear_   (timeStepsPerYear),
@@ -153,6 +160,8 @@ namespace QuantLib {
                                stats_type(), this->antitheticVariate_));
 
         this->mcModel_->addSamples(nCalibrationSamples_);
+        if (this->nThreads_ != Null<Size>())
+            this->pathPricer_->enableParallelCalibration(this->nThreads_);
         this->pathPricer_->calibrate();
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
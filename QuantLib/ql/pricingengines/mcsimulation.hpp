@@ -37,6 +37,11 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        If a number of threads is passed to the constructor, samples
+        are drawn in parallel (a null value, the default, selects
+        serial sampling and zero selects all available threads); see
+        MonteCarloModel::enableParallelSampling() for details.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,9 +72,10 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size nThreads = Null<Size>())
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), nThreads_(nThreads) {}
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +103,7 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size nThreads_;
     };
 
 
@@ -195,6 +202,9 @@ namespace QuantLib {
                            this->antitheticVariate_));
         }
 
+        if (nThreads_ != Null<Size>())
+            this->mcModel_->enableParallelSampling(nThreads_);
+
         if (requiredTolerance != Null<Real>()) {
             if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
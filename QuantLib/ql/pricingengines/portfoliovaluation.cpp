@@ -0,0 +1,166 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/portfoliovaluation.hpp>
+#include <ql/utilities/parallel.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <ql/patterns/singleton.hpp>
+
+namespace QuantLib {
+
+    PortfolioValuation::PortfolioValuation(Size threads)
+    : threads_(threads) {}
+
+    Size PortfolioValuation::addEngine(const engine_factory& factory) {
+        QL_REQUIRE(!factory.empty(), "null engine factory");
+        factories_.push_back(factory);
+        return factories_.size()-1;
+    }
+
+    void PortfolioValuation::add(
+                            const boost::shared_ptr<Instrument>& instrument) {
+        QL_REQUIRE(instrument, "null instrument");
+        instruments_.push_back(instrument);
+        engineIndex_.push_back(Null<Size>());
+    }
+
+    void PortfolioValuation::add(
+                             const boost::shared_ptr<Instrument>& instrument,
+                             Size engine) {
+        QL_REQUIRE(instrument, "null instrument");
+        QL_REQUIRE(engine < factories_.size(),
+                   "engine index (" << engine << ") out of range; "
+                   << factories_.size() << " factories registered");
+        instruments_.push_back(instrument);
+        engineIndex_.push_back(engine);
+    }
+
+    void PortfolioValuation::calculate() {
+
+        Size n = instruments_.size();
+        NPVs_.assign(n, Null<Real>());
+        errorEstimates_.assign(n, Null<Real>());
+        additionalResults_.assign(n, std::map<std::string,boost::any>());
+        errors_.assign(n, std::string());
+
+        // engines are created in this thread, since their creation
+        // usually registers them as observers of market data.
+        Size threads = parallelThreads(threads_);
+        std::vector<engines> threadEngines(threads,
+                                           engines(factories_.size()));
+        for (Size t=0; t<threads; ++t) {
+            for (Size k=0; k<factories_.size(); ++k) {
+                threadEngines[t][k] = factories_[k]();
+                QL_REQUIRE(threadEngines[t][k],
+                           io::ordinal(k+1) << " factory returned "
+                           "a null engine");
+            }
+        }
+
+        // instruments priced by their own engines...
+        for (Size i=0; i<n; ++i) {
+            if (engineIndex_[i] == Null<Size>())
+                price(i, threadEngines[0]);
+        }
+
+        // ...the first instrument for each factory...
+        std::vector<bool> priced(factories_.size(), false);
+        std::vector<Size> remaining;
+        remaining.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            Size k = engineIndex_[i];
+            if (k == Null<Size>())
+                continue;
+            if (!priced[k]) {
+                price(i, threadEngines[0]);
+                priced[k] = true;
+            } else {
+                remaining.push_back(i);
+            }
+        }
+
+        // ...and the rest in parallel.  price() doesn't throw.
+        long m = remaining.size();
+        #if defined(QL_ENABLE_THREAD_SESSIONS)
+        const Integer session = ThreadSession::current();
+        #endif
+        #if defined(_OPENMP)
+        #pragma omp parallel num_threads(threads)
+        #endif
+        {
+            #if defined(QL_ENABLE_THREAD_SESSIONS)
+            // workers use the settings of the calling thread
+            ThreadSession workerSession(session);
+            #endif
+            #if defined(_OPENMP)
+            Size thread = omp_get_thread_num();
+            #pragma omp for schedule(dynamic)
+            #else
+            Size thread = 0;
+            #endif
+            for (long j=0; j<m; ++j)
+                price(remaining[j], threadEngines[thread]);
+        }
+    }
+
+    void PortfolioValuation::price(Size i, const engines& threadEngines) {
+        const Instrument& instrument = *instruments_[i];
+        try {
+            if (engineIndex_[i] == Null<Size>()) {
+                NPVs_[i] = instrument.NPV();
+                additionalResults_[i] = instrument.additionalResults();
+                try {
+                    errorEstimates_[i] = instrument.errorEstimate();
+                } catch (Error&) {
+                    // not provided by the engine
+                }
+            } else if (instrument.isExpired()) {
+                NPVs_[i] = 0.0;
+                errorEstimates_[i] = 0.0;
+            } else {
+                // same as Instrument::performCalculations, but with
+                // the engine owned by this thread.
+                const boost::shared_ptr<PricingEngine>& engine =
+                    threadEngines[engineIndex_[i]];
+                engine->reset();
+                instrument.setupArguments(engine->getArguments());
+                engine->getArguments()->validate();
+                engine->calculate();
+                const Instrument::results* results =
+                    dynamic_cast<const Instrument::results*>(
+                                                       engine->getResults());
+                QL_REQUIRE(results != 0,
+                           "no results returned from pricing engine");
+                NPVs_[i] = results->value;
+                errorEstimates_[i] = results->errorEstimate;
+                additionalResults_[i] = results->additionalResults;
+            }
+        } catch (std::exception& e) {
+            NPVs_[i] = errorEstimates_[i] = Null<Real>();
+            additionalResults_[i].clear();
+            errors_[i] = e.what();
+        } catch (...) {
+            NPVs_[i] = errorEstimates_[i] = Null<Real>();
+            additionalResults_[i].clear();
+            errors_[i] = "unknown error";
+        }
+    }
+
+}
+
@@ -0,0 +1,159 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliovaluation.hpp
+    \brief valuation of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_valuation_hpp
+#define quantlib_portfolio_valuation_hpp
+
+#include <ql/instrument.hpp>
+#include <boost/function.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Valuation of a portfolio of instruments
+    /*! This class prices a number of instruments and returns their
+        results in a single call, using multiple threads if the
+        library was compiled with OpenMP support.
+
+        Pricing engines can't be shared between threads, since they
+        store their arguments and results. Therefore, instruments to
+        be priced in parallel are added together with the index of
+        an engine factory, previously registered with addEngine();
+        each thread creates its own engines through the factories,
+        and the instruments are priced without using (nor modifying)
+        the engines set to them. Instruments added without a factory
+        are priced through their own engines, in the calling thread.
+
+        The instruments are priced in the following order:
+        - first, instruments without a factory are priced;
+        - then, for each registered factory, the first instrument
+          using it is priced in the calling thread;
+        - finally, the remaining instruments are priced in parallel.
+        The first two steps also perform the lazy calculations of
+        the term structures, models and other market data used by
+        the instruments (e.g., the bootstrap of piecewise curves);
+        after them, such data are usually accessed in read-only mode
+        and can be safely shared between threads.
+
+        When the library is compiled with QL_ENABLE_THREAD_SESSIONS,
+        the worker threads are bound to the session of the thread
+        calling calculate(), so that they use its evaluation date
+        and settings.
+
+        Errors are not propagated; the error message raised by an
+        instrument is returned by the errors() method and the
+        corresponding results are set to null.
+
+        \warning Market data must not be modified, nor notifications
+                 sent, while calculate() is running. Objects that
+                 are modified during pricing must not be shared
+                 between instruments priced in parallel; in
+                 particular, this is the case of coupon pricers,
+                 which must be set separately for each instrument.
+                 Finally, market data must be fully calculated by
+                 the first two steps above; this might not be the
+                 case if the first instrument priced by an engine
+                 doesn't use all the data used by the others.
+
+        \test the results of a parallel valuation are checked against
+              those obtained by pricing each instrument serially.
+    */
+    class PortfolioValuation {
+      public:
+        typedef boost::function0<boost::shared_ptr<PricingEngine> >
+                                                              engine_factory;
+        /*! A null or zero number of threads selects all the
+            available threads.
+        */
+        explicit PortfolioValuation(Size threads = Null<Size>());
+        //! \name Portfolio composition
+        //@{
+        //! registers an engine factory and returns its index
+        Size addEngine(const engine_factory& factory);
+        //! adds an instrument priced by its own engine
+        void add(const boost::shared_ptr<Instrument>& instrument);
+        //! adds an instrument priced by engines from the given factory
+        void add(const boost::shared_ptr<Instrument>& instrument,
+                 Size engine);
+        Size size() const;
+        //@}
+        //! \name Calculations
+        //@{
+        //! prices the instruments
+        /*! \note The first instrument using each factory is priced
+                  serially in the calling thread (see above); the
+                  speed-up is therefore limited for portfolios with
+                  few instruments per factory.
+        */
+        void calculate();
+        //! net present values of the instruments
+        const std::vector<Real>& NPVs() const;
+        //! error estimates on the NPVs, null if not available
+        const std::vector<Real>& errorEstimates() const;
+        //! additional results returned by the engines
+        const std::vector<std::map<std::string,boost::any> >&
+        additionalResults() const;
+        //! error messages; empty for instruments priced successfully
+        const std::vector<std::string>& errors() const;
+        //@}
+      private:
+        typedef std::vector<boost::shared_ptr<PricingEngine> > engines;
+        void price(Size i, const engines& threadEngines);
+        Size threads_;
+        std::vector<engine_factory> factories_;
+        std::vector<boost::shared_ptr<Instrument> > instruments_;
+        std::vector<Size> engineIndex_;
+        std::vector<Real> NPVs_, errorEstimates_;
+        std::vector<std::map<std::string,boost::any> > additionalResults_;
+        std::vector<std::string> errors_;
+    };
+
+
+    // inline definitions
+
+    inline Size PortfolioValuation::size() const {
+        return instruments_.size();
+    }
+
+    inline const std::vector<Real>& PortfolioValuation::NPVs() const {
+        return NPVs_;
+    }
+
+    inline const std::vector<Real>&
+    PortfolioValuation::errorEstimates() const {
+        return errorEstimates_;
+    }
+
+    inline const std::vector<std::map<std::string,boost::any> >&
+    PortfolioValuation::additionalResults() const {
+        return additionalResults_;
+    }
+
+    inline const std::vector<std::string>& PortfolioValuation::errors() const {
+        return errors_;
+    }
+
+}
+
+
+#endif
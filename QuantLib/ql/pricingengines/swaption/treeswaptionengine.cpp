@@ -80,7 +80,7 @@ namespace QuantLib {
         } else {
             std::vector<Time> times = swaption.mandatoryTimes();
             TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            lattice = tree(timeGrid);
         }
 
         std::vector<Time> stoppingTimes(arguments_.exercise->dates().size());
@@ -40,6 +40,10 @@ namespace QuantLib {
                  \f$ t \geq 0 \f$.
 
         \test calculations are checked against cached results
+
+        \test results obtained with a lattice reused across swaptions
+              are checked against those of a new engine, also after
+              changes of the model and of the term structure.
     */
     class TreeSwaptionEngine
     : public LatticeShortRateModelEngine<Swaption::arguments,
@@ -74,6 +74,9 @@ namespace QuantLib {
 
         Real operator()(Real phi)      const;
 
+        // logarithm of the integrand without the strike-dependent term
+        std::complex<Real> exponent(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -173,6 +176,37 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        return std::exp(exponent(phi)
+                        + std::complex<Real>(0.0, phi*(dd_-sx_))
+                        ).imag()/phi;
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -182,57 +216,27 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : 0.0;
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : 0.0;
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                    + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                    + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                    + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                    + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -278,11 +282,9 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -330,6 +332,14 @@ namespace QuantLib {
         return evaluations_;
     }
 
+    void AnalyticHestonEngine::update() {
+        // the model might have changed
+        nodeValues_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
     void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -401,6 +411,68 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        if (!integration_->isAdaptiveIntegration()) {
+            const Real kappa = model_->kappa(), theta = model_->theta();
+            const Real sigma = model_->sigma(), v0 = model_->v0();
+            const Real rho = model_->rho();
+
+            std::map<Time, NodeValues>::iterator cached =
+                nodeValues_.find(term);
+            if (cached == nodeValues_.end()) {
+                const Real c_inf = std::min(10.0, std::max(0.0001,
+                        std::sqrt(1.0-square<Real>()(rho))/sigma))
+                        *(v0 + kappa*theta*term);
+
+                NodeValues& values = nodeValues_[term];
+                integration_->nodes(c_inf, values.phi, values.weights);
+                const Size n = values.phi.size();
+                values.f1.resize(n);
+                values.f2.resize(n);
+
+                // strike and ratio only enter the strike-dependent term
+                const Fj_Helper f1(kappa, theta, sigma, v0, spotPrice, rho,
+                                   this, cpxLog_, term, 1.0, 1.0, 1);
+                const Fj_Helper f2(kappa, theta, sigma, v0, spotPrice, rho,
+                                   this, cpxLog_, term, 1.0, 1.0, 2);
+                for (Size i=0; i<n; ++i) {
+                    values.f1[i] = std::exp(f1.exponent(values.phi[i]));
+                    values.f2[i] = std::exp(f2.exponent(values.phi[i]));
+                }
+                evaluations_ = 2*n;
+                cached = nodeValues_.find(term);
+            } else {
+                evaluations_ = 0;
+            }
+
+            const NodeValues& values = cached->second;
+            const Real dd = std::log(spotPrice*dividendDiscount
+                                     /(strikePrice*riskFreeDiscount));
+            Real p1 = 0.0, p2 = 0.0;
+            for (Size i=0; i<values.phi.size(); ++i) {
+                const Real phi = values.phi[i];
+                const Real c = std::cos(phi*dd), s = std::sin(phi*dd);
+                const Real w = values.weights[i]/phi;
+                p1 += w*(values.f1[i].real()*s + values.f1[i].imag()*c);
+                p2 += w*(values.f2[i].real()*s + values.f2[i].imag()*c);
+            }
+            p1 /= M_PI;
+            p2 /= M_PI;
+
+            switch (payoff->optionType()) {
+              case Option::Call:
+                results_.value = spotPrice*dividendDiscount*(p1+0.5)
+                               - strikePrice*riskFreeDiscount*(p2+0.5);
+                break;
+              case Option::Put:
+                results_.value = spotPrice*dividendDiscount*(p1-0.5)
+                               - strikePrice*riskFreeDiscount*(p2-0.5);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+            return;
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -512,6 +584,39 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::Integration::nodes(
+                                             Real c_inf,
+                                             std::vector<Real>& phi,
+                                             std::vector<Real>& weights) const {
+        QL_REQUIRE(gaussianQuadrature_,
+                   "integration nodes not available for adaptive "
+                   "integration algorithms");
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+        phi.clear();
+        weights.clear();
+        // same order as GaussianQuadrature, which matters for the
+        // log branch correction
+        for (Integer i = x.size()-1; i >= 0; --i) {
+            switch (intAlgo_) {
+              case GaussLaguerre:
+                phi.push_back(x[i]);
+                weights.push_back(w[i]);
+                break;
+              case GaussLegendre:
+              case GaussChebyshev:
+              case GaussChebyshev2nd:
+                if ((x[i]+1.0)*c_inf > QL_EPSILON) {
+                    phi.push_back(-std::log(0.5*x[i]+0.5)/c_inf);
+                    weights.push_back(w[i]/((x[i]+1.0)*c_inf));
+                }
+                break;
+              default:
+                QL_FAIL("unknwon integration algorithm");
+            }
+        }
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
             || intAlgo_ == GaussKronrod
@@ -33,6 +33,7 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -69,11 +70,23 @@ namespace QuantLib {
         J. Gatheral, The Volatility Surface: A Practitioner's Guide,
         Wiley Finance
 
+        Caching detail:
+        with non-adaptive integrations, the characteristic function
+        is evaluated at the same nodes for any strike; its values at
+        the nodes are stored for each maturity and reused for all the
+        options with that maturity priced by the same engine, until
+        the model is changed.  Sharing an engine between options on
+        a grid of strikes (e.g., among the helpers of a model
+        calibration) avoids most of the evaluations.
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        \test the results obtained through the cached characteristic
+              function are checked against those of a new engine.
     */
     class AnalyticHestonEngine
         : public GenericModelEngine<HestonModel,
@@ -102,7 +115,10 @@ namespace QuantLib {
                              ComplexLogFormula cpxLog, const Integration& itg);
 
 
+        void update();
         void calculate() const;
+        //! characteristic-function evaluations in the last calculation
+        /*! It is null if cached values were used. */
         Size numberOfEvaluations() const;
 
         static void doCalculation(Real riskFreeDiscount,
@@ -128,12 +144,16 @@ namespace QuantLib {
       private:
         class Fj_Helper;
 
+        // characteristic function at the integration nodes
+        struct NodeValues {
+            std::vector<Real> phi, weights;
+            std::vector<std::complex<Real> > f1, f2;
+        };
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
-
-
-
+        mutable std::map<Time, NodeValues> nodeValues_;
     };
 
 
@@ -163,6 +183,14 @@ namespace QuantLib {
         Real calculate(Real c_inf,
                        const boost::function1<Real, Real>& f) const;
 
+        /*! For non-adaptive integrations, returns the nodes and
+            weights such that calculate(c_inf, f) is the sum of
+            weights[i]*f(phi[i]).
+        */
+        void nodes(Real c_inf,
+                   std::vector<Real>& phi,
+                   std::vector<Real>& weights) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
 
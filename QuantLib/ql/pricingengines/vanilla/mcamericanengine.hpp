@@ -61,7 +61,8 @@ namespace QuantLib {
              BigNatural seed,
              Size polynomOrder,
              LsmBasisSystem::PolynomType polynomType,
-             Size nCalibrationSamples = Null<Size>());
+             Size nCalibrationSamples = Null<Size>(),
+             Size nThreads = Null<Size>());
 
         void calculate() const;
         
@@ -116,6 +117,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withPolynomOrder(Size polynomOrer);
         MakeMCAmericanEngine& withBasisSystem(LsmBasisSystem::PolynomType);
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
+        MakeMCAmericanEngine& withThreads(Size threads = 0);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -128,6 +130,7 @@ namespace QuantLib {
         BigNatural seed_;
         Size polynomOrder_;
         LsmBasisSystem::PolynomType polynomType_;
+        Size threads_;
     };
 
     template <class RNG, class S> inline
@@ -138,14 +141,15 @@ namespace QuantLib {
         Size requiredSamples, Real requiredTolerance,
         Size maxSamples,BigNatural seed,
         Size polynomOrder, LsmBasisSystem::PolynomType polynomType,
-        Size nCalibrationSamples)
+        Size nCalibrationSamples, Size nThreads)
     : MCLongstaffSchwartzEngine<VanillaOption::engine,
                                 SingleVariate,RNG,S>(
                                          process, timeSteps, timeStepsPerYear,
                                          false, antitheticVariate,
                                          controlVariate, requiredSamples,
                                          requiredTolerance, maxSamples,
-                                         seed, nCalibrationSamples),
+                                         seed, nCalibrationSamples,
+                                         nThreads),
       polynomOrder_(polynomOrder),
       polynomType_(polynomType) {}
 
@@ -252,7 +256,8 @@ namespace QuantLib {
       calibrationSamples_(2048),
       tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2),
-      polynomType_ (LsmBasisSystem::Monomial) {}
+      polynomType_ (LsmBasisSystem::Monomial),
+      threads_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
@@ -339,6 +344,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCAmericanEngine<RNG,S>&
+    MakeMCAmericanEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
 
     template <class RNG, class S>
     inline
@@ -359,7 +371,8 @@ namespace QuantLib {
                                      seed_,
                                      polynomOrder_,
                                      polynomType_,
-                                     calibrationSamples_));
+                                     calibrationSamples_,
+                                     threads_));
     }
 
 }
@@ -65,7 +65,8 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size nThreads = Null<Size>());
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
@@ -102,8 +103,9 @@ namespace QuantLib {
                           Size requiredSamples,
                           Real requiredTolerance,
                           Size maxSamples,
-                          BigNatural seed)
-    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate),
+                          BigNatural seed,
+                          Size nThreads)
+    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate, nThreads),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -72,6 +72,7 @@ namespace QuantLib {
         Real kappa() const { return kappa_; }
         Real theta() const { return theta_; }
         Real sigma() const { return sigma_; }
+        Discretization discretization() const { return discretization_; }
 
         const Handle<Quote>& s0() const;
         const Handle<YieldTermStructure>& dividendYield() const;
@@ -32,10 +32,49 @@
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/parallel.hpp>
+#include <map>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // counts the notifications sent by an observable
+        class NotificationCounter : public Observer {
+          public:
+            explicit NotificationCounter(
+                              const boost::shared_ptr<Observable>& o)
+            : notifications_(0) {
+                registerWith(o);
+            }
+            void update() { ++notifications_; }
+            Size notifications() const { return notifications_; }
+            void reset() { notifications_ = 0; }
+          private:
+            Size notifications_;
+        };
+
+    }
+
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the curve is recalculated after a successful bootstrap
+        (e.g., because a quote changed) and its interpolation is
+        local, each pillar only depends on the previous ones. In this
+        case, the leading pillars whose quote and date did not change
+        and whose helpers were not notified by anything but their
+        quotes (e.g., by a discount curve) are kept without repricing
+        their instruments, and the bootstrap restarts from the first
+        pillar that changed; as in the first bootstrap, previous
+        values are used as initial guesses.
+
+        This requires the curve to call curveNotified() whenever it
+        is notified. All pillars are bootstrapped again if the curve
+        was notified by anything but its helpers (e.g., by jump
+        quotes or by a change of evaluation date), if the
+        notifications were deferred by an ObservableBatchUpdate
+        (since the changes they collapse cannot be told apart) or if
+        the curve doesn't call curveNotified() at all.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -44,8 +83,22 @@ namespace QuantLib {
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        //! to be called by the curve whenever it is notified
+        void curveNotified();
+        //! \name Inspectors
+        //@{
+        //! wall-clock time taken by the last bootstrap, in seconds
+        Real elapsedTime() const { return elapsedTime_; }
+        /*! number of pillars solved by the last bootstrap; with a
+            global interpolation, the count includes all iterations.
+        */
+        Size solvedPillars() const { return solvedPillars_; }
+        //@}
       private:
         void initialize() const;
+        bool onlyQuotesChanged() const;
+        bool isUnchanged(Size pillar) const;
+        void storeInputs() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
@@ -54,6 +107,21 @@ namespace QuantLib {
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        // inputs of each helper at the last successful bootstrap
+        struct Inputs {
+            boost::shared_ptr<detail::NotificationCounter>
+                                        helperNotifications,
+                                        quoteNotifications;
+            Real quote;
+            Date date;
+            Time time;
+        };
+        mutable std::map<const typename Traits::helper*, Inputs> inputs_;
+        // notifications received by the curve since the last bootstrap
+        mutable Size curveNotifications_;
+        mutable bool batchedNotifications_;
+        mutable Real elapsedTime_;
+        mutable Size solvedPillars_;
     };
 
 
@@ -61,20 +129,41 @@ namespace QuantLib {
 
     template <class Curve>
     IterativeBootstrap<Curve>::IterativeBootstrap()
-        : ts_(0), initialized_(false), validCurve_(false) {}
+        : ts_(0), initialized_(false), validCurve_(false),
+          curveNotifications_(0), batchedNotifications_(false),
+          elapsedTime_(0.0), solvedPillars_(0) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
 
         ts_ = ts;
         n_ = ts_->instruments_.size();
-        for (Size j=0; j<n_; ++j)
-            ts_->registerWith(ts_->instruments_[j]);
+        for (Size j=0; j<n_; ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            ts_->registerWith(helper);
+            Inputs& inputs = inputs_[helper.get()];
+            inputs.helperNotifications =
+                boost::shared_ptr<detail::NotificationCounter>(
+                                   new detail::NotificationCounter(helper));
+            inputs.quoteNotifications =
+                boost::shared_ptr<detail::NotificationCounter>(
+                           new detail::NotificationCounter(helper->quote()));
+        }
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
     }
 
+    template <class Curve>
+    void IterativeBootstrap<Curve>::curveNotified() {
+        ++curveNotifications_;
+        // during a batch update, notifications are collected and
+        // sent with updates still disabled
+        if (!ObservableSettings::instance().updatesEnabled())
+            batchedNotifications_ = true;
+    }
+
     template <class Curve>
     void IterativeBootstrap<Curve>::initialize() const {
         // ensure helpers are sorted
@@ -130,6 +219,7 @@ namespace QuantLib {
     template <class Curve>
     void IterativeBootstrap<Curve>::calculate() const {
 
+        Real startTime = wallClockTime();
         // we might have to call initialize even if the curve is initialized
         // and not moving, just because helpers might be date relative and change
         // with evaluation date change.
@@ -158,11 +248,25 @@ namespace QuantLib {
 
         Size maxIterations = Traits::maxIterations()-1;
 
+        // with a local interpolation, the leading pillars whose
+        // inputs did not change need not be bootstrapped again
+        bool checkPillars = validCurve_ && !Interpolator::global
+                         && onlyQuotesChanged();
+        solvedPillars_ = 0;
+
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
             for (Size i=1; i<=alive_; ++i) { // pillar loop
 
+                if (checkPillars) {
+                    if (isUnchanged(i))
+                        continue;
+                    // later pillars depend on this one
+                    checkPillars = false;
+                }
+                ++solvedPillars_;
+
                 bool validData = validCurve_ || iteration>0;
 
                 // bracket root and calculate guess
@@ -228,7 +332,61 @@ namespace QuantLib {
                        " iterations; last improvement " << change <<
                        ", required accuracy " << accuracy);
         }
+        storeInputs();
         validCurve_ = true;
+        elapsedTime_ = wallClockTime() - startTime;
+    }
+
+    template <class Curve>
+    bool IterativeBootstrap<Curve>::onlyQuotesChanged() const {
+        if (batchedNotifications_)
+            return false;
+        // each notification from a helper reaches the curve once;
+        // any other notification comes from curve-level data
+        Size helperNotifications = 0;
+        typename std::map<const typename Traits::helper*,
+                          Inputs>::const_iterator i;
+        for (i=inputs_.begin(); i!=inputs_.end(); ++i)
+            helperNotifications += i->second.helperNotifications
+                                                    ->notifications();
+        return helperNotifications > 0
+            && curveNotifications_ == helperNotifications;
+    }
+
+    template <class Curve>
+    bool IterativeBootstrap<Curve>::isUnchanged(Size i) const {
+        const boost::shared_ptr<typename Traits::helper>& helper =
+                                                     errors_[i]->helper();
+        const Inputs& inputs = inputs_[helper.get()];
+        // a quote change is also forwarded by the helper; any other
+        // notification comes from the rest of its market data
+        if (inputs.helperNotifications->notifications() >
+            inputs.quoteNotifications->notifications())
+            return false;
+        return inputs.date == ts_->dates_[i]
+            && inputs.time == ts_->times_[i]
+            && inputs.quote == helper->quote()->value();
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::storeInputs() const {
+        for (Size i=1; i<=alive_; ++i) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                     errors_[i]->helper();
+            Inputs& inputs = inputs_[helper.get()];
+            inputs.quote = helper->quote()->value();
+            inputs.date = ts_->dates_[i];
+            inputs.time = ts_->times_[i];
+        }
+        // expired helpers still notify the curve
+        typename std::map<const typename Traits::helper*,
+                          Inputs>::iterator j;
+        for (j=inputs_.begin(); j!=inputs_.end(); ++j) {
+            j->second.helperNotifications->reset();
+            j->second.quoteNotifications->reset();
+        }
+        curveNotifications_ = 0;
+        batchedNotifications_ = false;
     }
 
 }
@@ -91,6 +91,8 @@ namespace QuantLib {
                        bool forcePositive = true);
         void setup(Curve* ts);
         void calculate() const;
+        //! does nothing; the bootstrap is always performed in full
+        void curveNotified() {}
 
       private:
         mutable bool validCurve_;
@@ -98,4 +98,38 @@ namespace QuantLib {
                                     alpha, beta, nu, rho);
     }
 
+
+    SabrVolatilityEvaluator::SabrVolatilityEvaluator(Rate forward,
+                                                     Time expiryTime,
+                                                     Real alpha,
+                                                     Real beta,
+                                                     Real nu,
+                                                     Real rho,
+                                                     Real shift)
+    : forward_(forward), shiftedForward_(forward+shift),
+      expiryTime_(expiryTime),
+      alpha_(alpha), beta_(beta), nu_(nu), rho_(rho), shift_(shift) {
+        QL_REQUIRE(shiftedForward_>0.0,
+                   "at the money forward rate"
+                   << (shift_ != 0.0 ? " plus shift" : "")
+                   << " must be positive: " << io::rate(shiftedForward_)
+                   << " not allowed");
+        QL_REQUIRE(expiryTime>=0.0, "expiry time must be non-negative: "
+                                   << expiryTime << " not allowed");
+        validateSabrParameters(alpha, beta, nu, rho);
+
+        // the products are grouped as in unsafeSabrVolatility so
+        // that the results are the same
+        oneMinusBeta_ = 1.0-beta;
+        oneMinusBeta2_ = oneMinusBeta_*oneMinusBeta_;
+        nuOverAlpha_ = nu/alpha;
+        twoRho_ = 2.0*rho;
+        oneMinusRho_ = 1.0-rho;
+        halfRho_ = 0.5*rho;
+        threeRho2MinusTwo_ = 3.0*rho*rho-2.0;
+        dTerm1_ = oneMinusBeta2_*alpha*alpha;
+        dTerm2_ = 0.25*rho*beta*nu*alpha;
+        dTerm3_ = (2.0-3.0*rho*rho)*(nu*nu/24.0);
+    }
+
 }
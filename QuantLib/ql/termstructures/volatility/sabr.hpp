@@ -26,7 +26,8 @@
 #ifndef quantlib_sabr_hpp
 #define quantlib_sabr_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/comparison.hpp>
+#include <cmath>
 
 namespace QuantLib {
 
@@ -51,6 +52,91 @@ namespace QuantLib {
                                 Real nu,
                                 Real rho);
 
+    //! %SABR volatility on a given smile
+    /*! The terms of the Hagan formula that depend only on forward,
+        expiry and %SABR parameters are computed once at construction,
+        so that the smile can be evaluated on many strikes at a
+        fraction of the cost of repeated calls to sabrVolatility().
+        With a null shift, the results are the same as those of
+        unsafeSabrVolatility(); a non-null shift gives the shifted
+        %SABR model, in which forward and strikes are displaced by
+        the same amount.
+
+        Forward, expiry and parameters are validated at construction;
+        strikes are not validated, and the displaced strikes must be
+        positive.
+    */
+    class SabrVolatilityEvaluator {
+      public:
+        SabrVolatilityEvaluator(Rate forward,
+                                Time expiryTime,
+                                Real alpha,
+                                Real beta,
+                                Real nu,
+                                Real rho,
+                                Real shift = 0.0);
+        //! volatility at the given strike
+        Volatility operator()(Rate strike) const;
+        //! volatilities at the strikes in the given range
+        template <class I1, class I2>
+        void operator()(I1 strikesBegin, I1 strikesEnd,
+                        I2 volatilities) const {
+            for (; strikesBegin != strikesEnd; ++strikesBegin, ++volatilities)
+                *volatilities = (*this)(*strikesBegin);
+        }
+        //! \name Inspectors
+        //@{
+        Rate forward() const { return forward_; }
+        Time expiryTime() const { return expiryTime_; }
+        Real alpha() const { return alpha_; }
+        Real beta() const { return beta_; }
+        Real nu() const { return nu_; }
+        Real rho() const { return rho_; }
+        Real shift() const { return shift_; }
+        //@}
+      private:
+        Rate forward_, shiftedForward_;
+        Time expiryTime_;
+        Real alpha_, beta_, nu_, rho_, shift_;
+        // strike-independent terms of the Hagan formula
+        Real oneMinusBeta_, oneMinusBeta2_, nuOverAlpha_, twoRho_,
+             oneMinusRho_, halfRho_, threeRho2MinusTwo_;
+        Real dTerm1_, dTerm2_, dTerm3_;
+    };
+
+
+    // inline definitions
+
+    inline Volatility SabrVolatilityEvaluator::operator()(Rate strike) const {
+        // same operations as unsafeSabrVolatility, with the
+        // strike-independent terms taken from the data members
+        const Rate k = strike + shift_;
+        const Real A = std::pow(shiftedForward_*k, oneMinusBeta_);
+        const Real sqrtA = std::sqrt(A);
+        Real logM;
+        if (!close(shiftedForward_, k))
+            logM = std::log(shiftedForward_/k);
+        else {
+            const Real epsilon = (shiftedForward_-k)/k;
+            logM = epsilon - .5 * epsilon * epsilon ;
+        }
+        const Real z = nuOverAlpha_*sqrtA*logM;
+        const Real B = 1.0-twoRho_*z+z*z;
+        const Real C = oneMinusBeta2_*logM*logM;
+        const Real tmp = (std::sqrt(B)+z-rho_)/oneMinusRho_;
+        const Real xx = std::log(tmp);
+        const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+        const Real d = 1.0 + expiryTime_ *
+            (dTerm1_/(24.0*A) + dTerm2_/sqrtA + dTerm3_);
+
+        Real multiplier;
+        if (std::fabs(z*z)>QL_EPSILON * 10.0)
+            multiplier = z/xx;
+        else
+            multiplier = 1.0 - halfRho_*z - threeRho2MinusTwo_*z*z/12.0;
+        return (alpha_/D)*multiplier*d;
+    }
+
 }
 
 #endif
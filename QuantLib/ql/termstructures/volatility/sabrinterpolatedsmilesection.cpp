@@ -117,11 +117,16 @@ namespace QuantLib {
         // avoid iterator invalidation
         createInterpolation();
         sabrInterpolation_->update();
+        evaluator_ = boost::shared_ptr<SabrVolatilityEvaluator>(new
+            SabrVolatilityEvaluator(forwardValue_, exerciseTime(),
+                                    sabrInterpolation_->alpha(),
+                                    sabrInterpolation_->beta(),
+                                    sabrInterpolation_->nu(),
+                                    sabrInterpolation_->rho()));
     }
 
     Real SabrInterpolatedSmileSection::varianceImpl(Real strike) const {
-        calculate();
-        Real v = (*sabrInterpolation_)(strike, true);
+        Real v = volatilityImpl(strike);
         return v*v*exerciseTime();
     }
 
@@ -105,6 +105,8 @@ namespace QuantLib {
         //! Creates the mutable SABRInterpolation
         void createInterpolation() const;
         mutable boost::shared_ptr<SABRInterpolation> sabrInterpolation_;
+        //! Calibrated smile, evaluated without further validation
+        mutable boost::shared_ptr<SabrVolatilityEvaluator> evaluator_;
 
         //! Market data
         const Handle<Quote> forward_;
@@ -137,7 +139,9 @@ namespace QuantLib {
 
     inline Real SabrInterpolatedSmileSection::volatilityImpl(Rate strike) const {
         calculate();
-        return (*sabrInterpolation_)(strike, true);
+        QL_REQUIRE(strike>0.0, "strike must be positive: " <<
+                               io::rate(strike) << " not allowed");
+        return (*evaluator_)(strike);
     }
 
     inline Real SabrInterpolatedSmileSection::alpha() const {
@@ -25,44 +25,42 @@ namespace QuantLib {
 
     SabrSmileSection::SabrSmileSection(Time timeToExpiry,
                                        Rate forward,
-                                       const std::vector<Real>& sabrParams)
-    : SmileSection(timeToExpiry), forward_(forward) {
-
-        alpha_ = sabrParams[0];
-        beta_ = sabrParams[1];
-        nu_ = sabrParams[2];
-        rho_ = sabrParams[3];
-
-        QL_REQUIRE(forward_>0.0, "at the money forward rate must be "
-                   "positive: " << io::rate(forward_) << " not allowed");
-        validateSabrParameters(alpha_, beta_, nu_, rho_);
-    }
+                                       const std::vector<Real>& sabrParams,
+                                       Real shift)
+    : SmileSection(timeToExpiry),
+      alpha_(sabrParams[0]), beta_(sabrParams[1]),
+      nu_(sabrParams[2]), rho_(sabrParams[3]),
+      forward_(forward), shift_(shift),
+      evaluator_(forward_, exerciseTime(), alpha_, beta_, nu_, rho_,
+                 shift_) {}
 
     SabrSmileSection::SabrSmileSection(const Date& d,
                                        Rate forward,
                                        const std::vector<Real>& sabrParams,
-                                       const DayCounter& dc)
-    : SmileSection(d, dc), forward_(forward) {
+                                       const DayCounter& dc,
+                                       Real shift)
+    : SmileSection(d, dc),
+      alpha_(sabrParams[0]), beta_(sabrParams[1]),
+      nu_(sabrParams[2]), rho_(sabrParams[3]),
+      forward_(forward), shift_(shift),
+      evaluator_(forward_, exerciseTime(), alpha_, beta_, nu_, rho_,
+                 shift_) {}
 
-        alpha_ = sabrParams[0];
-        beta_ = sabrParams[1];
-        nu_ = sabrParams[2];
-        rho_ = sabrParams[3];
-
-        QL_REQUIRE(forward_>0.0, "at the money forward rate must be "
-                   "positive: " << io::rate(forward_) << " not allowed");
-        validateSabrParameters(alpha_, beta_, nu_, rho_);
+    void SabrSmileSection::update() {
+        SmileSection::update();
+        // the exercise time might have changed
+        evaluator_ = SabrVolatilityEvaluator(forward_, exerciseTime(),
+                                             alpha_, beta_, nu_, rho_,
+                                             shift_);
     }
 
-     Real SabrSmileSection::varianceImpl(Rate strike) const {
-        Volatility vol = unsafeSabrVolatility(strike, forward_,
-            exerciseTime(), alpha_, beta_, nu_, rho_);
+    Real SabrSmileSection::varianceImpl(Rate strike) const {
+        Volatility vol = evaluator_(strike);
         return vol*vol*exerciseTime();
-     }
+    }
 
-     Real SabrSmileSection::volatilityImpl(Rate strike) const {
-        return unsafeSabrVolatility(strike, forward_,
-            exerciseTime(), alpha_, beta_, nu_, rho_);
-     }
+    Real SabrSmileSection::volatilityImpl(Rate strike) const {
+        return evaluator_(strike);
+    }
 
 }
@@ -25,28 +25,43 @@
 #define quantlib_sabr_smile_section_hpp
 
 #include <ql/termstructures/volatility/smilesection.hpp>
+#include <ql/termstructures/volatility/sabr.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    //! %SABR smile section
+    /*! A non-null shift gives a shifted %SABR smile, which allows
+        strikes down to minus the shift.
+    */
     class SabrSmileSection : public SmileSection {
       public:
         SabrSmileSection(Time timeToExpiry,
                          Rate forward,
-                         const std::vector<Real>& sabrParameters);
+                         const std::vector<Real>& sabrParameters,
+                         Real shift = 0.0);
         SabrSmileSection(const Date& d,
                          Rate forward,
                          const std::vector<Real>& sabrParameters,
-                         const DayCounter& dc = Actual365Fixed());
-        Real minStrike () const { return 0.0; }
+                         const DayCounter& dc = Actual365Fixed(),
+                         Real shift = 0.0);
+        Real minStrike () const { return 0.0 - shift_; }
         Real maxStrike () const { return QL_MAX_REAL; }
         Real atmLevel() const { return forward_; }
+        void update();
+        //! volatilities at the strikes in the given range
+        template <class I1, class I2>
+        void volatilities(I1 strikesBegin, I1 strikesEnd,
+                          I2 volatilities) const {
+            evaluator_(strikesBegin, strikesEnd, volatilities);
+        }
       protected:
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
       private:
-        Real alpha_, beta_, nu_, rho_, forward_;
+        Real alpha_, beta_, nu_, rho_, forward_, shift_;
+        SabrVolatilityEvaluator evaluator_;
     };
 
 
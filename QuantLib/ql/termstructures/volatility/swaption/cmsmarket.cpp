@@ -111,6 +111,22 @@ namespace QuantLib {
      }
 
     void CmsMarket::performCalculations() const {
+        // numeric pricers can evaluate the forward CMS coupons
+        // concurrently before the legs are priced
+        for (Size j=0; j<nSwapIndexes_; ++j) {
+            shared_ptr<NumericHaganPricer> pricer =
+                boost::dynamic_pointer_cast<NumericHaganPricer>(pricers_[j]);
+            if (pricer) {
+                Leg cmsCoupons;
+                for (Size i=0; i<nExercise_; ++i) {
+                    const Leg& cmsLeg = fwdSwaps_[i][j]->leg(0);
+                    cmsCoupons.insert(cmsCoupons.end(),
+                                      cmsLeg.begin(), cmsLeg.end());
+                }
+                pricer->precalculate(cmsCoupons);
+            }
+        }
+
         for (Size j=0; j<nSwapIndexes_; ++j) {
           Real mktPrevPart = 0.0, mdlPrevPart = 0.0;
           for (Size i=0; i<nExercise_; ++i) {
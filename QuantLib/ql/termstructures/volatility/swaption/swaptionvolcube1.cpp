@@ -23,6 +23,8 @@
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/quote.hpp>
+#include <ql/utilities/parallel.hpp>
+#include <numeric>
 
 #ifndef SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL
     #define SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL 15.0e-4
@@ -58,7 +60,9 @@ namespace QuantLib {
                              vegaWeightedSmileFit),
       parametersGuessQuotes_(parametersGuess),
       isParameterFixed_(isParameterFixed), isAtmCalibrated_(isAtmCalibrated),
-      endCriteria_(endCriteria), optMethod_(optMethod)
+      endCriteria_(endCriteria), optMethod_(optMethod),
+      threads_(Null<Size>()), warmStart_(false), maxVolatilityChange_(0.0),
+      smileVersions_(nSwapTenors_, 0)
     {
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -111,7 +115,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_, sparseNodes_,
+                                            sparseDiagnostics_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -119,13 +124,30 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_,
+                                               denseDiagnostics_);
             denseParameters_.updateInterpolators();
         }
+
+        for (Size k=0; k<nSwapTenors_; ++k)
+            ++smileVersions_[k];
     }
 
     SwaptionVolCube1::Cube
     SwaptionVolCube1::sabrCalibration(const Cube& marketVolCube) const {
+        std::vector<NodeCalibration> nodes;
+        CalibrationDiagnostics diagnostics;
+        return sabrCalibration(marketVolCube, nodes, diagnostics);
+    }
+
+    SwaptionVolCube1::Cube
+    SwaptionVolCube1::sabrCalibration(
+                                const Cube& marketVolCube,
+                                std::vector<NodeCalibration>& nodes,
+                                CalibrationDiagnostics& diagnostics) const {
+
+        const Real startTime = wallClockTime();
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -142,46 +164,93 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
+        // previous results on a different grid cannot be reused
+        const Size nSwapLengths = swapLengths.size();
+        const Size nNodes = optionTimes.size()*nSwapLengths;
+        if (nodes.size() != nNodes)
+            nodes = std::vector<NodeCalibration>(nNodes);
+        CalibrationDiagnostics results;
+
+        // the inputs are collected serially, since they come from
+        // term structures and quotes
+        std::vector<NodeCalibration> current(nNodes);
+        std::vector<std::vector<Real> > starts(nNodes);
         for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                for (Size i=0; i<nStrikes_; i++){
-                    strikes[i] = atmForward+strikeSpreads_[i];
-                    volatilities[i] = tmpMarketVolCube[i][j][k];
+            for (Size k=0; k<nSwapLengths; k++) {
+                const Size n = j*nSwapLengths+k;
+                NodeCalibration& node = current[n];
+                node.optionTime = optionTimes[j];
+                node.forward = atmStrike(optionDates[j], swapTenors[k]);
+                node.volatilities.resize(nStrikes_);
+                for (Size i=0; i<nStrikes_; i++)
+                    node.volatilities[i] = tmpMarketVolCube[i][j][k];
+                node.guess = parametersGuess_.operator()(optionTimes[j],
+                                                         swapLengths[k]);
+
+                const NodeCalibration& previous = nodes[n];
+                if (previous.calibrated && previous.hasSameInputs(node)) {
+                    node = previous;
+                    ++results.skippedNodes;
+                    continue;
+                }
+
+                starts[n] = node.guess;
+                if (warmStart_ && previous.calibrated) {
+                    Volatility change = 0.0;
+                    for (Size i=0; i<nStrikes_; i++)
+                        change = std::max(change,
+                                          std::fabs(node.volatilities[i] -
+                                                    previous.volatilities[i]));
+                    if (change <= maxVolatilityChange_) {
+                        for (Size p=0; p<4; p++) {
+                            if (!isParameterFixed_[p])
+                                starts[n][p] = previous.result[p];
+                        }
+                        ++results.warmStartedNodes;
+                    }
                 }
+                ++results.calibratedNodes;
+            }
+        }
+
+        // Errors are kept by node so that, as in a serial
+        // calibration, the first failing node is reported.
+        std::vector<std::string> failures(nNodes);
+        std::vector<char> failed(nNodes, false);
+        const long m = nNodes;
+        #if defined(_OPENMP)
+        const Size threads = (threads_ == Null<Size>() || optMethod_) ?
+                             1 : parallelThreads(threads_);
+        #pragma omp parallel for num_threads(threads) schedule(dynamic)
+        #endif
+        for (long l=0; l<m; ++l) {
+            if (current[l].calibrated)
+                continue;
+            try {
+                calibrateNode(current[l], starts[l]);
+            } catch (std::exception& e) {
+                failed[l] = true;
+                failures[l] = e.what();
+            } catch (...) {
+                failed[l] = true;
+                failures[l] = "unknown error";
+            }
+        }
 
-                const std::vector<Real>& guess = parametersGuess_.operator()(
-                    optionTimes[j], swapLengths[k]);
-
-                const boost::shared_ptr<SABRInterpolation> sabrInterpolation =
-                    boost::shared_ptr<SABRInterpolation>(new
-                        SABRInterpolation(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
-                                          isParameterFixed_[0],
-                                          isParameterFixed_[1],
-                                          isParameterFixed_[2],
-                                          isParameterFixed_[3],
-                                          vegaWeightedSmileFit_,
-                                          endCriteria_,
-                                          optMethod_));
-                sabrInterpolation->update();
-
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<nSwapLengths; k++) {
+                const Size n = j*nSwapLengths+k;
+                QL_REQUIRE(!failed[n], failures[n]);
+
+                const std::vector<Real>& result = current[n].result;
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
+                errors     [j][k] = result[5];
+                maxErrors  [j][k] = result[6];
+                endCriteria[j][k] = result[7];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -209,6 +278,11 @@ namespace QuantLib {
                           "   nu = " << nus[j][k]   << "\n" <<
                           "   rho = " << rhos[j][k]
                           );
+
+                results.maxRmsError = std::max(results.maxRmsError,
+                                               errors[j][k]);
+                results.maxError = std::max(results.maxError,
+                                            maxErrors[j][k]);
             }
         }
         Cube sabrParametersCube(optionDates, swapTenors,
@@ -222,9 +296,89 @@ namespace QuantLib {
         sabrParametersCube.setLayer(6, maxErrors);
         sabrParametersCube.setLayer(7, endCriteria);
 
+        // only successful calibrations are kept for the next run
+        nodes.swap(current);
+        results.calibrationTime = wallClockTime() - startTime;
+        diagnostics = results;
+
         return sabrParametersCube;
 
     }
+
+    void SwaptionVolCube1::calibrateNode(
+                                     NodeCalibration& node,
+                                     const std::vector<Real>& start) const {
+
+        std::vector<Real> strikes(strikeSpreads_.size());
+        for (Size i=0; i<nStrikes_; i++)
+            strikes[i] = node.forward+strikeSpreads_[i];
+
+        SABRInterpolation sabrInterpolation(strikes.begin(), strikes.end(),
+                                            node.volatilities.begin(),
+                                            node.optionTime, node.forward,
+                                            start[0], start[1],
+                                            start[2], start[3],
+                                            isParameterFixed_[0],
+                                            isParameterFixed_[1],
+                                            isParameterFixed_[2],
+                                            isParameterFixed_[3],
+                                            vegaWeightedSmileFit_,
+                                            endCriteria_,
+                                            optMethod_);
+        sabrInterpolation.update();
+
+        node.result.resize(8);
+        node.result[0] = sabrInterpolation.alpha();
+        node.result[1] = sabrInterpolation.beta();
+        node.result[2] = sabrInterpolation.nu();
+        node.result[3] = sabrInterpolation.rho();
+        node.result[4] = node.forward;
+        node.result[5] = sabrInterpolation.rmsError();
+        node.result[6] = sabrInterpolation.maxError();
+        node.result[7] = sabrInterpolation.endCriteria();
+        node.calibrated = true;
+    }
+
+    bool SwaptionVolCube1::NodeCalibration::hasSameInputs(
+                                      const NodeCalibration& other) const {
+        return optionTime == other.optionTime &&
+               forward == other.forward &&
+               volatilities == other.volatilities &&
+               guess == other.guess;
+    }
+
+    void SwaptionVolCube1::enableParallelCalibration(Size threads) {
+        threads_ = (threads == Null<Size>() ? 0 : threads);
+    }
+
+    void SwaptionVolCube1::disableParallelCalibration() {
+        threads_ = Null<Size>();
+    }
+
+    void SwaptionVolCube1::enableWarmStart(Volatility maxVolatilityChange) {
+        QL_REQUIRE(maxVolatilityChange >= 0.0,
+                   "negative maximum volatility change ("
+                   << maxVolatilityChange << ") given");
+        warmStart_ = true;
+        maxVolatilityChange_ = maxVolatilityChange;
+    }
+
+    void SwaptionVolCube1::disableWarmStart() {
+        warmStart_ = false;
+    }
+
+    const SwaptionVolCube1::CalibrationDiagnostics&
+    SwaptionVolCube1::sparseCalibrationDiagnostics() const {
+        calculate();
+        return sparseDiagnostics_;
+    }
+
+    const SwaptionVolCube1::CalibrationDiagnostics&
+    SwaptionVolCube1::denseCalibrationDiagnostics() const {
+        calculate();
+        return denseDiagnostics_;
+    }
+
     void SwaptionVolCube1::sabrCalibrationSection(
                                             const Cube& marketVolCube,
                                             Cube& parametersCube,
@@ -568,8 +722,25 @@ namespace QuantLib {
         return volCubeAtmCalibrated_.browse();
     }
 
+    Size SwaptionVolCube1::smileVersion(const Period& swapTenor) const {
+        calculate();
+        Size k = std::find(swapTenors_.begin(), swapTenors_.end(),
+                           swapTenor) - swapTenors_.begin();
+        if (k != nSwapTenors_)
+            return smileVersions_[k];
+        // versions never decrease, so their sum changes with any of them
+        return std::accumulate(smileVersions_.begin(), smileVersions_.end(),
+                               Size(0));
+    }
+
     void SwaptionVolCube1::recalibration(Real beta,
                                          const Period& swapTenor){
+        Size k = std::find(swapTenors_.begin(), swapTenors_.end(),
+                           swapTenor) - swapTenors_.begin();
+        QL_REQUIRE(k != nSwapTenors_, "swap tenor not found");
+        // the smiles change even if the calibration fails midway
+        ++smileVersions_[k];
+
         Matrix newBetaGuess(nOptionTenors_, nSwapTenors_, beta);
         parametersGuess_.setLayer(1, newBetaGuess);
         parametersGuess_.updateInterpolators();
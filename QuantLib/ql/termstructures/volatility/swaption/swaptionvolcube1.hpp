@@ -122,6 +122,58 @@ namespace QuantLib {
         Matrix denseSabrParameters() const;
         Matrix marketVolCube() const;
         Matrix volCubeAtmCalibrated() const;
+        /*! Version of the smiles for the given swap tenor. It
+            changes whenever the cube is recalculated or the smiles
+            for the tenor are recalibrated, so that results depending
+            only on such smiles can be stored and reused until then.
+            Smiles for swap tenors not in the cube depend on all the
+            calibrated tenors.
+        */
+        Size smileVersion(const Period& swapTenor) const;
+        //@}
+        /*! \name Calibration settings
+
+            Nodes whose forward, option time, market volatilities
+            and parameter guesses did not change since their last
+            successful calibration keep their SABR parameters and are
+            not calibrated again.  The settings below take effect at
+            the next recalculation of the cube.
+        */
+        //@{
+        /*! Calibrates the nodes concurrently.  A null or zero number
+            of threads selects all the available ones; see
+            parallelThreads().  Optimization methods keep state while
+            minimizing and cannot be shared among threads; therefore,
+            nodes are still calibrated serially when a custom method
+            was passed to the constructor.
+        */
+        void enableParallelCalibration(Size threads = 0);
+        void disableParallelCalibration();
+        /*! Starts the calibration of a node from its previous SABR
+            parameters if none of its market volatilities moved by
+            more than the given amount; the parameter guesses are used
+            otherwise.  Fixed parameters always take their guessed
+            value.
+        */
+        void enableWarmStart(Volatility maxVolatilityChange = 0.005);
+        void disableWarmStart();
+        //@}
+        //! \name Calibration diagnostics
+        //@{
+        struct CalibrationDiagnostics {
+            CalibrationDiagnostics()
+            : calibratedNodes(0), skippedNodes(0), warmStartedNodes(0),
+              maxRmsError(0.0), maxError(0.0), calibrationTime(0.0) {}
+            Size calibratedNodes, skippedNodes, warmStartedNodes;
+            //! largest rms and maximum errors among the nodes
+            Real maxRmsError, maxError;
+            //! wall-clock time in seconds
+            Real calibrationTime;
+        };
+        //! diagnostics of the last calibration of the market-quoted nodes
+        const CalibrationDiagnostics& sparseCalibrationDiagnostics() const;
+        //! diagnostics of the last calibration of the ATM-calibrated cube
+        const CalibrationDiagnostics& denseCalibrationDiagnostics() const;
         //@}
         void sabrCalibrationSection(const Cube& marketVolCube,
                                     Cube& parametersCube,
@@ -140,6 +192,19 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        struct NodeCalibration {
+            NodeCalibration() : calibrated(false) {}
+            bool hasSameInputs(const NodeCalibration& other) const;
+            bool calibrated;
+            Time optionTime;
+            Rate forward;
+            std::vector<Real> volatilities, guess, result;
+        };
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             std::vector<NodeCalibration>& nodes,
+                             CalibrationDiagnostics& diagnostics) const;
+        void calibrateNode(NodeCalibration& node,
+                           const std::vector<Real>& start) const;
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
         mutable Cube sparseParameters_;
@@ -153,6 +218,12 @@ namespace QuantLib {
         const boost::shared_ptr<EndCriteria> endCriteria_;
         Real maxErrorTolerance_;
         const boost::shared_ptr<OptimizationMethod> optMethod_;
+        Size threads_;
+        bool warmStart_;
+        Volatility maxVolatilityChange_;
+        mutable std::vector<NodeCalibration> sparseNodes_, denseNodes_;
+        mutable CalibrationDiagnostics sparseDiagnostics_, denseDiagnostics_;
+        mutable std::vector<Size> smileVersions_;
     };
 
 }
@@ -72,6 +72,7 @@ namespace QuantLib {
         const std::vector<DiscountFactor>& discounts() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        using YieldTermStructure::discounts;
       protected:
         InterpolatedDiscountCurve(
             const DayCounter&,
@@ -94,6 +95,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* out, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -165,6 +167,15 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(const Time* t,
+                                                     DiscountFactor* out,
+                                                     Size n) const {
+        // no virtual calls
+        for (Size i=0; i<n; ++i)
+            out[i] = InterpolatedDiscountCurve<T>::discountImpl(t[i]);
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
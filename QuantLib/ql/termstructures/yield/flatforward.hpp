@@ -84,6 +84,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* out, Size n) const;
         //@}
 
         Handle<Quote> forward_;
@@ -104,6 +105,14 @@ namespace QuantLib {
         return rate_.discountFactor(t);
     }
   
+    inline void FlatForward::discountsImpl(const Time* t,
+                                           DiscountFactor* out,
+                                           Size n) const {
+        calculate();
+        for (Size i=0; i<n; ++i)
+            out[i] = rate_.discountFactor(t[i]);
+    }
+
     inline void FlatForward::performCalculations() const {
         rate_ = InterestRate(forward_->value(), dayCounter(),
                              compounding_, frequency_);
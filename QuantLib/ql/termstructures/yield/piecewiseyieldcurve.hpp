@@ -53,6 +53,9 @@ namespace QuantLib {
         - the correctness of the returned values is tested by
           checking them against the original inputs.
         - the observability of the term structure is tested.
+        - the results of a bootstrap restarted after a quote change
+          are checked against a full bootstrap, as are the results
+          after changes in jumps and in batches of quotes.
     */
     template <class Traits, class Interpolator,
               template <class> class Bootstrap = IterativeBootstrap>
@@ -167,6 +170,17 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap statistics
+        /*! These methods refer to the bootstrap that yielded the
+            current curve and are only available with bootstrappers
+            providing them, such as IterativeBootstrap.
+        */
+        //@{
+        //! wall-clock time taken by the bootstrap, in seconds
+        Real bootstrapTime() const;
+        //! number of pillars solved by the bootstrap
+        Size bootstrappedPillars() const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -178,6 +192,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* out, Size n) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -226,9 +241,25 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline Real PiecewiseYieldCurve<C,I,B>::bootstrapTime() const {
+        calculate();
+        return bootstrap_.elapsedTime();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline Size PiecewiseYieldCurve<C,I,B>::bootstrappedPillars() const {
+        calculate();
+        return bootstrap_.solvedPillars();
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
+        // lets the bootstrapper tell curve-level changes from
+        // changes in the helpers
+        bootstrap_.curveNotified();
+
         // it dispatches notifications only if (!calculated_ && !frozen_)
         LazyObject::update();
 
@@ -247,6 +278,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::discountsImpl(const Time* t,
+                                                          DiscountFactor* out,
+                                                          Size n) const {
+        calculate();
+        base_curve::discountsImpl(t, out, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
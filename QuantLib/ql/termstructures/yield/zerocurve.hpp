@@ -73,6 +73,7 @@ namespace QuantLib {
         const std::vector<Rate>& zeroRates() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        using YieldTermStructure::zeroRates;
       protected:
         InterpolatedZeroCurve(
             const DayCounter&,
@@ -96,6 +97,10 @@ namespace QuantLib {
         //@{
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t, DiscountFactor* out, Size n) const;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize();
@@ -160,6 +165,21 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(const Time* t,
+                                                 DiscountFactor* out,
+                                                 Size n) const {
+        // same as ZeroYieldStructure::discountImpl, without virtual calls
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0) {
+                out[i] = 1.0;
+            } else {
+                Rate r = InterpolatedZeroCurve<T>::zeroYieldImpl(t[i]);
+                out[i] = DiscountFactor(std::exp(-r*t[i]));
+            }
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
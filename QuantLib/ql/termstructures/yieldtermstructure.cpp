@@ -21,6 +21,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -93,6 +94,10 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -105,8 +110,39 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
+        return jumpEffect;
+    }
+
+    void YieldTermStructure::discounts(const Time* t,
+                                       DiscountFactor* out,
+                                       Size n,
+                                       bool extrapolate) const {
+        if (n == 0)
+            return;
+
+        // the range check passes for all times if it passes for
+        // the extremes
+        Time tMin = t[0], tMax = t[0];
+        for (Size i=1; i<n; ++i) {
+            tMin = std::min(tMin, t[i]);
+            tMax = std::max(tMax, t[i]);
+        }
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+
+        discountsImpl(t, out, n);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<n; ++i)
+                out[i] *= jumpEffect(t[i]);
+        }
+    }
 
+    void YieldTermStructure::discountsImpl(const Time* t,
+                                           DiscountFactor* out,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            out[i] = discountImpl(t[i]);
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
@@ -139,6 +175,28 @@ namespace QuantLib {
                                          t);
     }
 
+    void YieldTermStructure::zeroRates(const Time* t,
+                                       Rate* out,
+                                       Size n,
+                                       Compounding comp,
+                                       Frequency freq,
+                                       bool extrapolate) const {
+        if (n == 0)
+            return;
+        std::vector<Time> times(t, t+n);
+        for (Size i=0; i<n; ++i) {
+            if (times[i]==0.0)
+                times[i] = dt;
+        }
+        discounts(&times[0], out, n, extrapolate);
+        for (Size i=0; i<n; ++i) {
+            Real compound = 1.0/out[i];
+            out[i] = InterestRate::impliedRate(compound,
+                                               dayCounter(), comp, freq,
+                                               times[i]);
+        }
+    }
+
     InterestRate YieldTermStructure::forwardRate(const Date& d1,
                                                  const Date& d2,
                                                  const DayCounter& dayCounter,
@@ -184,4 +242,33 @@ namespace QuantLib {
                                          t2-t1);
     }
 
+    void YieldTermStructure::forwardRates(const Time* t1,
+                                          const Time* t2,
+                                          Rate* out,
+                                          Size n,
+                                          Compounding comp,
+                                          Frequency freq,
+                                          bool extrapolate) const {
+        if (n == 0)
+            return;
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(t2[i]>=t1[i],
+                       "t2 (" << t2[i] << ") < t1 (" << t1[i] << ")");
+
+        std::vector<DiscountFactor> d2(n);
+        discounts(t1, out, n, extrapolate);
+        discounts(t2, &d2[0], n, extrapolate);
+        for (Size i=0; i<n; ++i) {
+            if (t2[i]==t1[i]) {
+                // instantaneous forward
+                out[i] = forwardRate(t1[i], t2[i], comp, freq, extrapolate);
+            } else {
+                Real compound = out[i]/d2[i];
+                out[i] = InterestRate::impliedRate(compound,
+                                                   dayCounter(), comp, freq,
+                                                   t2[i]-t1[i]);
+            }
+        }
+    }
+
 }
@@ -39,7 +39,10 @@ namespace QuantLib {
 
         \ingroup yieldtermstructures
 
-        \test observability against evaluation date changes is checked.
+        \test
+        - observability against evaluation date changes is checked.
+        - the results of bulk queries are checked against those of
+          the corresponding single queries.
     */
     class YieldTermStructure : public TermStructure {
       public:
@@ -79,6 +82,38 @@ namespace QuantLib {
                                 bool extrapolate = false) const;
         //@}
 
+        /*! \name Bulk queries
+
+            These methods return the same results as the corresponding
+            single-time methods for each of the \c n passed times, but
+            the range check, the lazy recalculation of the curve and
+            the virtual dispatch are performed once for all of them.
+            Derived classes can provide faster implementations by
+            overriding discountsImpl().
+        */
+        //@{
+        //! discount factors for the times in <tt>[t, t+n)</tt>
+        void discounts(const Time* t,
+                       DiscountFactor* out,
+                       Size n,
+                       bool extrapolate = false) const;
+        //! zero rates for the times in <tt>[t, t+n)</tt>
+        void zeroRates(const Time* t,
+                       Rate* out,
+                       Size n,
+                       Compounding comp,
+                       Frequency freq = Annual,
+                       bool extrapolate = false) const;
+        //! forward rates between the times in <tt>t1</tt> and <tt>t2</tt>
+        void forwardRates(const Time* t1,
+                          const Time* t2,
+                          Rate* out,
+                          Size n,
+                          Compounding comp,
+                          Frequency freq = Annual,
+                          bool extrapolate = false) const;
+        //@}
+
         /*! \name Zero-yield rates
 
             These methods return the implied zero-yield rate for a
@@ -167,10 +202,23 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factor calculation for a number of times; the
+            default implementation calls discountImpl() for each of
+            them.
+
+            \warning classes overriding this method must make sure
+                     that their results are consistent with those of
+                     discountImpl(), including when the latter is
+                     overridden in further derived classes.
+        */
+        virtual void discountsImpl(const Time* t,
+                                   DiscountFactor* out,
+                                   Size n) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -21,9 +21,201 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+    || defined(QL_ENABLE_THREAD_SESSIONS)
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#endif
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        Integer bitCount(boost::uint32_t x) {
+            x = x - ((x >> 1) & 0x55555555);
+            x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+            x = (x + (x >> 4)) & 0x0F0F0F0F;
+            return Integer((x * 0x01010101) >> 24);
+        }
+
+        // business days preceding the j-th date of a block
+        template <class Block>
+        Integer businessDaysBefore(const Block& block, Size j) {
+            const boost::uint32_t mask =
+                (boost::uint32_t(1) << (j%32)) - 1;
+            return block.before[j/32] + bitCount(block.days[j/32] & mask);
+        }
+
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+            || defined(QL_ENABLE_THREAD_SESSIONS)
+        boost::mutex cacheMutex;
+        #endif
+    }
+
+    Calendar::Impl::Impl() : cache_(0), generation_(1) {}
+
+    Calendar::Impl::Impl(const Impl& other)
+    : addedHolidays(other.addedHolidays),
+      removedHolidays(other.removedHolidays),
+      dependencies_(other.dependencies_), cache_(0),
+      generation_(other.generation_) {}
+
+    Calendar::Impl& Calendar::Impl::operator=(const Impl& other) {
+        if (this != &other) {
+            addedHolidays = other.addedHolidays;
+            removedHolidays = other.removedHolidays;
+            dependencies_ = other.dependencies_;
+            clearCache();
+        }
+        return *this;
+    }
+
+    Calendar::Impl::~Impl() {
+        releaseCache();
+    }
+
+    void Calendar::Impl::clearCache() {
+        ++generation_;
+        // holidays are not changed while other threads use the
+        // calendar, so the blocks can be released
+        releaseCache();
+    }
+
+    void Calendar::Impl::releaseCache() {
+        Slot* slots = cache_;
+        if (slots != 0) {
+            for (Size b=0; b<Size(blocks); ++b)
+                delete static_cast<Block*>(slots[b]);
+            delete[] slots;
+            cache_ = 0;
+        }
+        for (Size k=0; k<replaced_.size(); ++k)
+            delete replaced_[k];
+        replaced_.clear();
+    }
+
+    #if BOOST_VERSION < 105300
+    const Calendar::Impl::Block* Calendar::Impl::cachedBlock(Size b) const {
+        // without atomics, blocks are read under the lock
+        const Block* block = 0;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+            || defined(QL_ENABLE_THREAD_SESSIONS)
+        boost::lock_guard<boost::mutex> lock(cacheMutex);
+        #endif
+        #if defined(_OPENMP)
+        #pragma omp critical(ql_calendar_cache)
+        #endif
+        {
+            if (cache_ != 0 && b < Size(blocks))
+                block = cache_[b];
+        }
+        if (block == 0 || block->generation != generation())
+            return 0;
+        return block;
+    }
+    #endif
+
+    const Calendar::Impl::Block& Calendar::Impl::fill(Size b) const {
+        QL_REQUIRE(b < blocks, "date out of cached range");
+
+        // the block is computed aside (this might fill the blocks of
+        // other calendars, too) and only published under the lock
+        const unsigned long g = generation();
+        Block block;
+        block.generation = g;
+        std::fill(block.days, block.days+16, boost::uint32_t(0));
+        businessDays(b, block.days);
+
+        const Date first(BigInteger(firstSerial + b*daysPerBlock));
+        const Date last(std::min<BigInteger>(first.serialNumber()
+                                             + daysPerBlock - 1,
+                                             lastSerial));
+        std::set<Date>::const_iterator i;
+        for (i = addedHolidays.lower_bound(first);
+             i != addedHolidays.end() && *i <= last; ++i) {
+            const Size j = *i - first;
+            block.days[j/32] &= ~(boost::uint32_t(1) << (j%32));
+        }
+        for (i = removedHolidays.lower_bound(first);
+             i != removedHolidays.end() && *i <= last; ++i) {
+            const Size j = *i - first;
+            block.days[j/32] |= boost::uint32_t(1) << (j%32);
+        }
+
+        Integer total = 0;
+        for (Size k=0; k<16; ++k) {
+            block.before[k] = total;
+            total += bitCount(block.days[k]);
+        }
+        block.total = total;
+
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+            || defined(QL_ENABLE_THREAD_SESSIONS)
+        boost::lock_guard<boost::mutex> lock(cacheMutex);
+        #endif
+        const Block* result = 0;
+        #if defined(_OPENMP)
+        #pragma omp critical(ql_calendar_cache)
+        #endif
+        {
+            Slot* slots = cache_;
+            if (slots == 0) {
+                slots = new Slot[blocks];
+                for (Size k=0; k<Size(blocks); ++k)
+                    slots[k] = 0;
+                // release: readers must see the slots initialized
+                #if BOOST_VERSION >= 105300
+                cache_.store(slots, boost::memory_order_release);
+                #else
+                cache_ = slots;
+                #endif
+            }
+            Block* cached = slots[b];
+            if (cached != 0 && cached->generation == g) {
+                // filled by another thread in the meantime
+                result = cached;
+            } else {
+                Block* filled = new Block(block);
+                if (cached != 0)
+                    replaced_.push_back(cached);
+                // release: readers must see the block filled
+                #if BOOST_VERSION >= 105300
+                slots[b].store(filled, boost::memory_order_release);
+                #else
+                slots[b] = filled;
+                #endif
+                result = filled;
+            }
+        }
+        return *result;
+    }
+
+    void Calendar::Impl::businessDays(Size b, boost::uint32_t* days) const {
+        const BigInteger first = firstSerial + b*daysPerBlock;
+        const Size n = std::min<BigInteger>(daysPerBlock,
+                                            lastSerial - first + 1);
+        for (Size j=0; j<n; ++j) {
+            if (isBusinessDay(Date(first + BigInteger(j))))
+                days[j/32] |= boost::uint32_t(1) << (j%32);
+        }
+    }
+
+    bool Calendar::uncachedIsBusinessDay(const Date& d) const {
+        if (d >= Date::minDate() && d <= Date::maxDate()) {
+            const Size i = Size(d.serialNumber() - Impl::firstSerial);
+            const Size j = i % Impl::daysPerBlock;
+            const Impl::Block& b = impl_->block(i / Impl::daysPerBlock);
+            return (b.days[j/32] >> (j%32)) & 1;
+        }
+        // null dates are not cached
+        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
+            return false;
+        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
+            return true;
+        return impl_->isBusinessDay(d);
+    }
+
     void Calendar::addHoliday(const Date& d) {
         // if d was a genuine holiday previously removed, revert the change
         impl_->removedHolidays.erase(d);
@@ -31,6 +223,8 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        // joint calendars built on this one will notice, too
+        impl_->clearCache();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -40,6 +234,8 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        // joint calendars built on this one will notice, too
+        impl_->clearCache();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -122,23 +318,20 @@ namespace QuantLib {
                                              bool includeLast) const {
         BigInteger wd = 0;
         if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(from))
-                    ++wd;
-            }
+            // business days in [d1,d2], counted from the cached blocks
+            const Date d1 = std::min(from, to), d2 = std::max(from, to);
+            const Size i1 = Size(d1.serialNumber() - Impl::firstSerial),
+                       i2 = Size(d2.serialNumber() - Impl::firstSerial);
+            const Size b1 = i1 / Impl::daysPerBlock,
+                       b2 = i2 / Impl::daysPerBlock;
+            for (Size b=b1; b<b2; ++b)
+                wd += impl_->block(b).total;
+            wd += businessDaysBefore(impl_->block(b2),
+                                     i2 % Impl::daysPerBlock);
+            wd -= businessDaysBefore(impl_->block(b1),
+                                     i1 % Impl::daysPerBlock);
+            if (isBusinessDay(d2))
+                ++wd;
 
             if (isBusinessDay(from) && !includeFirst)
                 wd--;
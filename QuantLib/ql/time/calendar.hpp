@@ -29,6 +29,11 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105300
+#include <boost/atomic.hpp>
+#endif
 #include <set>
 #include <vector>
 #include <string>
@@ -45,6 +50,20 @@ namespace QuantLib {
         The Bridge pattern is used to provide the base behavior of the
         calendar, namely, to determine whether a date is a business day.
 
+        Business days are cached by the implementation as a bitmap,
+        which is filled lazily in blocks of consecutive dates; this
+        makes isBusinessDay() (and therefore adjust() and advance())
+        a lookup and businessDaysBetween() a matter of counting bits.
+        The cache of a calendar (and of the joint calendars built
+        on it) is discarded when a holiday is added or removed.
+
+        \warning Blocks are allocated when first needed, filled
+                 under a lock and published with release semantics
+                 (or, with Boost versions before 1.53, read under the
+                 lock) so a calendar can be queried by different
+                 threads; however, adding or removing holidays while
+                 the calendar is in use by other threads is not safe.
+
         A calendar should be defined for specific exchange holiday schedule
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
@@ -53,18 +72,92 @@ namespace QuantLib {
 
         \test the methods for adding and removing holidays are tested
               by inspecting the calendar before and after their
-              invocation.
+              invocation; the cached results are checked after such
+              changes and against a day-by-day calculation.
     */
     class Calendar {
       protected:
         //! abstract base class for calendar implementations
         class Impl {
           public:
-            virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            //! cached business days in a block of consecutive dates
+            /*! Bit i%32 of days[i/32] is set if the i-th date of the
+                block is a business day; before[i/32] is the number
+                of business days in the block preceding such word.
+            */
+            struct Block {
+                Block() : generation(0) {}
+                unsigned long generation; // zero if never filled
+                boost::uint32_t days[16];
+                Integer before[16];
+                Integer total;
+            };
+            enum { daysPerBlock = 512,
+                   firstSerial = 367,     // Jan 1st, 1901
+                   lastSerial = 109574,   // Dec 31st, 2199
+                   blocks = (lastSerial-firstSerial+daysPerBlock)
+                            / daysPerBlock };
+            Impl();
+            Impl(const Impl&);
+            Impl& operator=(const Impl&);
+            virtual ~Impl();
+            //! business days in the given block, updated if needed
+            /*! Blocks are numbered from the minimum allowed date,
+                and take added and removed holidays into account.
+            */
+            const Block& block(Size b) const;
+            //! version of the business days of this calendar
+            /*! It changes whenever holidays are added to or removed
+                from this calendar or any calendar it depends on.
+            */
+            unsigned long generation() const;
+            //! discards the cached business days of this calendar
+            void clearCache();
+          protected:
+            /*! Sets the bits corresponding to the business days of
+                the given block according to the calendar rules,
+                i.e., without taking added or removed holidays into
+                account; the bits are cleared on input. The default
+                implementation calls isBusinessDay() for each date,
+                but it can be overridden by implementations that can
+                compose the bits more efficiently.
+            */
+            virtual void businessDays(Size b, boost::uint32_t* days) const;
+            //! cached business days of another calendar
+            static const Block& block(const Calendar& c, Size b) {
+                return c.impl_->block(b);
+            }
+            //! declares that the business days depend on another calendar
+            void dependOn(const Calendar& c) {
+                dependencies_.push_back(c.impl_);
+            }
+          private:
+            friend class Calendar;
+            //! the given block if cached and up to date, null otherwise
+            const Block* cachedBlock(Size b) const;
+            const Block& fill(Size b) const;
+            void releaseCache();
+            #if BOOST_VERSION >= 105300
+            typedef boost::atomic<Block*> Slot;
+            #else
+            typedef Block* Slot;
+            #endif
+            std::vector<boost::shared_ptr<Impl> > dependencies_;
+            // the slots are allocated when the first block is filled.
+            // Published blocks are never modified; when refilled, they
+            // are replaced and kept until the cache is cleared, since
+            // other threads might still be reading them.
+            #if BOOST_VERSION >= 105300
+            mutable boost::atomic<Slot*> cache_;
+            #else
+            mutable Slot* cache_;
+            #endif
+            mutable std::vector<Block*> replaced_;
+            unsigned long generation_;
         };
         boost::shared_ptr<Impl> impl_;
       public:
@@ -143,6 +236,8 @@ namespace QuantLib {
                                        bool includeFirst = true,
                                        bool includeLast = false) const;
         //@}
+      private:
+        bool uncachedIsBusinessDay(const Date& d) const;
 
       protected:
         //! partial calendar implementation
@@ -192,12 +287,42 @@ namespace QuantLib {
         return impl_->name();
     }
 
+    inline unsigned long Calendar::Impl::generation() const {
+        // generations start at 1 and never decrease, so the sum
+        // changes whenever any of them does
+        unsigned long g = generation_;
+        for (Size i=0; i<dependencies_.size(); ++i)
+            g += dependencies_[i]->generation();
+        return g;
+    }
+
+    #if BOOST_VERSION >= 105300
+    inline const Calendar::Impl::Block*
+    Calendar::Impl::cachedBlock(Size b) const {
+        // the acquire loads pair with the release stores in fill()
+        const Slot* slots = cache_.load(boost::memory_order_acquire);
+        if (slots == 0 || b >= Size(blocks))
+            return 0;
+        const Block* block = slots[b].load(boost::memory_order_acquire);
+        if (block == 0 || block->generation != generation())
+            return 0;
+        return block;
+    }
+    #endif
+
+    inline const Calendar::Impl::Block& Calendar::Impl::block(Size b) const {
+        if (const Block* cached = cachedBlock(b))
+            return *cached;
+        return fill(b);
+    }
+
     inline bool Calendar::isBusinessDay(const Date& d) const {
-        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
-            return false;
-        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
-            return true;
-        return impl_->isBusinessDay(d);
+        // negative offsets (i.e., null dates) wrap to invalid blocks
+        const Size i = Size(d.serialNumber() - Impl::firstSerial);
+        const Size j = i % Impl::daysPerBlock;
+        if (const Impl::Block* b = impl_->cachedBlock(i/Impl::daysPerBlock))
+            return (b->days[j/32] >> (j%32)) & 1;
+        return uncachedIsBusinessDay(d);
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
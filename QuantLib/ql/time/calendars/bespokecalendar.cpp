@@ -39,6 +39,8 @@ namespace QuantLib {
 
     void BespokeCalendar::Impl::addWeekend(Weekday w) {
         weekend_.insert(w);
+        // the cached business days are no longer valid
+        clearCache();
     }
 
 
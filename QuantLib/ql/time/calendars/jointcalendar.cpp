@@ -20,6 +20,7 @@
 
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace QuantLib {
@@ -30,6 +31,8 @@ namespace QuantLib {
     : rule_(r), calendars_(2) {
         calendars_[0] = c1;
         calendars_[1] = c2;
+        for (Size i=0; i<calendars_.size(); ++i)
+            dependOn(calendars_[i]);
     }
 
     JointCalendar::Impl::Impl(const Calendar& c1,
@@ -40,6 +43,8 @@ namespace QuantLib {
         calendars_[0] = c1;
         calendars_[1] = c2;
         calendars_[2] = c3;
+        for (Size i=0; i<calendars_.size(); ++i)
+            dependOn(calendars_[i]);
     }
 
     JointCalendar::Impl::Impl(const Calendar& c1,
@@ -52,6 +57,8 @@ namespace QuantLib {
         calendars_[1] = c2;
         calendars_[2] = c3;
         calendars_[3] = c4;
+        for (Size i=0; i<calendars_.size(); ++i)
+            dependOn(calendars_[i]);
     }
 
     std::string JointCalendar::Impl::name() const {
@@ -114,6 +121,30 @@ namespace QuantLib {
         }
     }
 
+    void JointCalendar::Impl::businessDays(Size b,
+                                           boost::uint32_t* days) const {
+        std::vector<Calendar>::const_iterator i;
+        switch (rule_) {
+          case JoinHolidays:
+            std::fill(days, days+16, ~boost::uint32_t(0));
+            for (i=calendars_.begin(); i!=calendars_.end(); ++i) {
+                const Block& other = block(*i, b);
+                for (Size k=0; k<16; ++k)
+                    days[k] &= other.days[k];
+            }
+            break;
+          case JoinBusinessDays:
+            for (i=calendars_.begin(); i!=calendars_.end(); ++i) {
+                const Block& other = block(*i, b);
+                for (Size k=0; k<16; ++k)
+                    days[k] |= other.days[k];
+            }
+            break;
+          default:
+            QL_FAIL("unknown joint calendar rule");
+        }
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
@@ -45,6 +45,8 @@ namespace QuantLib {
     /*! Depending on the chosen rule, this calendar has a set of
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
+        Its cached business days are obtained by combining bitwise
+        those of the given calendars.
 
         \ingroup calendars
 
@@ -65,6 +67,8 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+          protected:
+            void businessDays(Size block, boost::uint32_t* days) const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
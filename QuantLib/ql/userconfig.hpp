@@ -77,4 +77,30 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to have singletons return different instances for
+   different sessions, the session being bound to the current thread
+   by means of the ThreadSession class; no sessionId() function is
+   needed. This allows, e.g., different threads to use different
+   evaluation dates. It requires the Boost.Thread headers and can't be
+   defined together with QL_ENABLE_SESSIONS. */
+#ifndef QL_ENABLE_THREAD_SESSIONS
+//#   define QL_ENABLE_THREAD_SESSIONS
+#endif
+
+/* Define this to make the observer pattern thread-safe; registration
+   and notification can then be performed concurrently from different
+   threads. This requires the Boost.Thread headers and degrades
+   performance in single-threaded code. */
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+//#   define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#endif
+
+/* Define this to delegate matrix products, inverses and decompositions
+   to an external BLAS/LAPACK library (e.g., OpenBLAS or MKL) which
+   must then be linked to the library and to client code. This requires
+   QL_REAL to be double. */
+#ifndef QL_USE_LAPACK
+//#   define QL_USE_LAPACK
+#endif
+
 #endif
@@ -7,6 +7,7 @@
 #include <ql/utilities/disposable.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <ql/utilities/parallel.hpp>
 #include <ql/utilities/steppingiterator.hpp>
 #include <ql/utilities/tracing.hpp>
 #include <ql/utilities/vectors.hpp>
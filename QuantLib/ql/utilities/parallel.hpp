@@ -0,0 +1,151 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallel.hpp
+    \brief support for multi-threaded calculations
+*/
+
+#ifndef quantlib_parallel_hpp
+#define quantlib_parallel_hpp
+
+#include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#endif
+#include <algorithm>
+#include <string>
+
+namespace QuantLib {
+
+    //! number of threads to be used by a parallel calculation
+    /*! Parallel calculations are implemented by means of OpenMP;
+        if the library is not compiled with OpenMP support, they are
+        performed serially and this function always returns 1.
+
+        A null or zero value for the requested number of threads
+        selects all the available threads.
+    */
+    inline Size parallelThreads(Size requested = Null<Size>()) {
+        #if defined(_OPENMP)
+        if (requested == Null<Size>() || requested == 0)
+            return std::max<Size>(omp_get_max_threads(), 1);
+        return requested;
+        #else
+        (void)requested;
+        return 1;
+        #endif
+    }
+
+    //! elapsed wall-clock time in seconds
+    /*! The time is measured from an arbitrary origin, so only the
+        difference between two readings is meaningful. It is the
+        time to use when timing parallel calculations, since the
+        processor time adds up the time spent by all threads.
+    */
+    inline Real wallClockTime() {
+        #if defined(_OPENMP)
+        return omp_get_wtime();
+        #else
+        using namespace boost::posix_time;
+        static const ptime origin = microsec_clock::universal_time();
+        return (microsec_clock::universal_time() - origin)
+            .total_microseconds() * 1.0e-6;
+        #endif
+    }
+
+    //! scoped setting of the number of threads
+    /*! Sets the number of threads used by the parallel regions
+        started by the current thread without an explicit number of
+        threads; the previous setting is restored when the guard goes
+        out of scope. A null or zero value selects all the available
+        threads. It has no effect without OpenMP support.
+    */
+    class ParallelThreadsGuard {
+      public:
+        explicit ParallelThreadsGuard(Size threads) {
+            #if defined(_OPENMP)
+            previous_ = omp_get_max_threads();
+            omp_set_num_threads(int(parallelThreads(threads)));
+            #else
+            (void)threads;
+            #endif
+        }
+        ~ParallelThreadsGuard() {
+            #if defined(_OPENMP)
+            omp_set_num_threads(previous_);
+            #endif
+        }
+      private:
+        #if defined(_OPENMP)
+        int previous_;
+        #endif
+    };
+
+    //! errors raised in a parallel region
+    /*! Exceptions must not escape an OpenMP parallel region. Tasks
+        should catch them and record them in an instance of this
+        class; the thread that started the parallel region can then
+        rethrow the first recorded error once the region is over.
+
+        \code
+        ParallelErrors errors;
+        #pragma omp parallel for
+        for (long i=0; i<n; ++i) {
+            try {
+                ...
+            } catch (std::exception& e) {
+                errors.record(e.what());
+            } catch (...) {
+                errors.record("unknown error");
+            }
+        }
+        errors.rethrow();
+        \endcode
+    */
+    class ParallelErrors {
+      public:
+        ParallelErrors() : failed_(false) {}
+        void record(const std::string& message) {
+            #if defined(_OPENMP)
+            #pragma omp critical(ql_parallel_errors)
+            #endif
+            {
+                if (!failed_) {
+                    failed_ = true;
+                    message_ = message;
+                }
+            }
+        }
+        bool failed() const { return failed_; }
+        //! throws if any error was recorded
+        void rethrow() const {
+            QL_REQUIRE(!failed_, message_);
+        }
+      private:
+        bool failed_;
+        std::string message_;
+    };
+
+}
+
+
+#endif
@@ -175,9 +175,118 @@ void ArrayTest::testConstruction() {
     }
 }
 
+namespace {
+
+    Disposable<Array> disposableSum(const Array& a, const Array& b) {
+        return a + b;
+    }
+
+    void checkElements(const std::string& tag, const Array& calculated,
+                       const std::vector<Real>& expected) {
+        if (calculated.size() != expected.size()) {
+            BOOST_ERROR(tag << ": array not of the required size"
+                        << "\n    required:  " << expected.size()
+                        << "\n    resulting: " << calculated.size());
+            return;
+        }
+        for (Size i=0; i<expected.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > 1.0e-12)
+                BOOST_ERROR(tag << ": " << io::ordinal(i+1)
+                            << " element not with required value"
+                            << "\n    required:  " << expected[i]
+                            << "\n    resulting: " << calculated[i]);
+        }
+    }
+
+}
+
+void ArrayTest::testExpressions() {
+
+    BOOST_MESSAGE("Testing array expressions...");
+
+    Size size = 7;
+    Array a(size, 1.0, 0.5), b(size, 3.0, -0.25), c(size, 2.0);
+    Real x = 1.5;
+    std::vector<Real> expected(size);
+    Size i;
+
+    Array r = a + b*c - x/a;
+    for (i=0; i<size; ++i)
+        expected[i] = a[i] + b[i]*c[i] - x/a[i];
+    checkElements("a + b*c - x/a", r, expected);
+
+    r = -(a - x) * (2.0 + b) / c;
+    for (i=0; i<size; ++i)
+        expected[i] = -(a[i] - x) * (2.0 + b[i]) / c[i];
+    checkElements("-(a - x) * (2 + b) / c", r, expected);
+
+    r = Sqrt(Abs(b)) + Exp(Log(a)*x) - (+c);
+    for (i=0; i<size; ++i)
+        expected[i] = std::sqrt(std::fabs(b[i]))
+                    + std::exp(std::log(a[i])*x) - c[i];
+    checkElements("Sqrt(Abs(b)) + Exp(Log(a)*x) - c", r, expected);
+
+    // the assigned array appears in the expression
+    std::vector<Real> previous(r.begin(), r.end());
+    r = r*r + r;
+    for (i=0; i<size; ++i)
+        expected[i] = previous[i]*previous[i] + previous[i];
+    checkElements("r = r*r + r", r, expected);
+
+    // compound assignment
+    previous.assign(r.begin(), r.end());
+    r -= a*b;
+    for (i=0; i<size; ++i)
+        expected[i] = previous[i] - a[i]*b[i];
+    checkElements("r -= a*b", r, expected);
+
+    // assignment to an array of a different size
+    Array s(2);
+    s = a*x;
+    for (i=0; i<size; ++i)
+        expected[i] = a[i]*x;
+    checkElements("s = a*x", s, expected);
+
+    // expressions returned as disposable arrays
+    Array d = disposableSum(a, b);
+    for (i=0; i<size; ++i)
+        expected[i] = a[i] + b[i];
+    checkElements("disposable a + b", d, expected);
+
+    // expressions passed as arrays
+    Real dot = DotProduct(a + b, c);
+    Real expectedDot = 0.0;
+    for (i=0; i<size; ++i)
+        expectedDot += (a[i] + b[i])*c[i];
+    if (std::fabs(dot - expectedDot) > 1.0e-12)
+        BOOST_ERROR("wrong dot product of expression"
+                    << "\n    required:  " << expectedDot
+                    << "\n    resulting: " << dot);
+
+    // size checks
+    Array e(size+1);
+    bool thrown = false;
+    try {
+        Array f = a + b*e;
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        BOOST_ERROR("arrays with different sizes combined without errors");
+    thrown = false;
+    try {
+        e += a;
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        BOOST_ERROR("arrays with different sizes added without errors");
+}
+
 test_suite* ArrayTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("array tests");
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testExpressions));
     return suite;
 }
 
@@ -0,0 +1,391 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmarkkernels.hpp"
+#include "utilities.hpp"
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/fdamericanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/marketmodels/models/flatvol.hpp>
+#include <ql/models/marketmodels/correlations/expcorrelations.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
+#include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/settings.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    // the results of the calculations are accumulated here, so
+    // that the compiler can't optimize them away
+    volatile Real sink = 0.0;
+
+    // moves a quote back and forth to trigger recalculations
+    class QuoteBumper {
+      public:
+        QuoteBumper(const boost::shared_ptr<SimpleQuote>& quote, Real shift)
+        : quote_(quote), shift_(shift) {}
+        void operator()() {
+            quote_->setValue(quote_->value() + shift_);
+            shift_ = -shift_;
+        }
+      private:
+        boost::shared_ptr<SimpleQuote> quote_;
+        Real shift_;
+    };
+
+
+    class CurveBootstrap : public BenchmarkKernel {
+      public:
+        CurveBootstrap()
+        : quote_(new SimpleQuote(0.0315)), bump_(quote_, 0.0001) {
+            Date today = Settings::instance().evaluationDate();
+            Calendar calendar = TARGET();
+            boost::shared_ptr<IborIndex> euribor(new Euribor6M);
+
+            std::vector<boost::shared_ptr<RateHelper> > helpers;
+            Integer depositMonths[] = { 1, 2, 3, 6, 9 };
+            Rate depositRates[] = { 0.0315, 0.0320, 0.0325, 0.0335, 0.0340 };
+            for (Size i=0; i<LENGTH(depositMonths); ++i) {
+                boost::shared_ptr<Quote> quote = (i == 0) ? quote_ :
+                    boost::shared_ptr<Quote>(new SimpleQuote(depositRates[i]));
+                helpers.push_back(boost::shared_ptr<RateHelper>(
+                    new DepositRateHelper(Handle<Quote>(quote),
+                                          depositMonths[i]*Months, 2,
+                                          calendar, ModifiedFollowing,
+                                          true, Actual360())));
+            }
+            for (Integer years=1; years<=30; ++years) {
+                boost::shared_ptr<Quote> quote(
+                                     new SimpleQuote(0.035 + 0.0005*years));
+                helpers.push_back(boost::shared_ptr<RateHelper>(
+                    new SwapRateHelper(Handle<Quote>(quote),
+                                       years*Years, calendar, Annual,
+                                       Unadjusted, Thirty360(), euribor)));
+            }
+            curve_ = boost::shared_ptr<YieldTermStructure>(
+                new PiecewiseYieldCurve<Discount,LogLinear>(
+                                         today, helpers, Actual365Fixed()));
+            maturity_ = curve_->maxDate();
+        }
+        std::string name() const { return "CurveBootstrap"; }
+        Size operations() const { return 1; }
+        void run() {
+            bump_();
+            sink = sink + curve_->discount(maturity_);
+        }
+      private:
+        boost::shared_ptr<SimpleQuote> quote_;
+        QuoteBumper bump_;
+        boost::shared_ptr<YieldTermStructure> curve_;
+        Date maturity_;
+    };
+
+
+    class SwapNPV : public BenchmarkKernel {
+      public:
+        SwapNPV() : rate_(new SimpleQuote(0.04)), bump_(rate_, 0.0001) {
+            RelinkableHandle<YieldTermStructure> curve;
+            curve.linkTo(flatRate(Settings::instance().evaluationDate(),
+                                  rate_, Actual365Fixed()));
+            boost::shared_ptr<IborIndex> euribor(new Euribor6M(curve));
+            for (Integer years=1; years<=20; ++years) {
+                swaps_.push_back(MakeVanillaSwap(years*Years, euribor, 0.04)
+                                 .withDiscountingTermStructure(curve));
+            }
+        }
+        std::string name() const { return "SwapNPV"; }
+        Size operations() const { return swaps_.size(); }
+        void run() {
+            bump_();
+            for (Size i=0; i<swaps_.size(); ++i)
+                sink = sink + swaps_[i]->NPV();
+        }
+      private:
+        boost::shared_ptr<SimpleQuote> rate_;
+        QuoteBumper bump_;
+        std::vector<boost::shared_ptr<VanillaSwap> > swaps_;
+    };
+
+
+    class BlackFormula : public BenchmarkKernel {
+      public:
+        std::string name() const { return "BlackFormula"; }
+        Size operations() const { return 100000; }
+        void run() {
+            Real sum = 0.0;
+            for (Size i=0; i<operations(); ++i) {
+                Real strike = 50.0 + (i % 100);
+                sum += blackFormula(Option::Call, strike, 100.0,
+                                    0.2*std::sqrt(1.0 + (i % 10)), 0.95);
+            }
+            sink = sink + sum;
+        }
+    };
+
+
+    class HestonAnalytic : public BenchmarkKernel {
+      public:
+        HestonAnalytic() : s0_(new SimpleQuote(100.0)), bump_(s0_, 0.01) {
+            Date today = Settings::instance().evaluationDate();
+            DayCounter dc = Actual365Fixed();
+            Handle<YieldTermStructure> rTS(flatRate(today, 0.03, dc));
+            Handle<YieldTermStructure> qTS(flatRate(today, 0.01, dc));
+            boost::shared_ptr<HestonModel> model(new HestonModel(
+                boost::shared_ptr<HestonProcess>(
+                    new HestonProcess(rTS, qTS, Handle<Quote>(s0_),
+                                      0.04, 1.5, 0.04, 0.5, -0.7))));
+            boost::shared_ptr<PricingEngine> engine(
+                                           new AnalyticHestonEngine(model));
+            for (Size i=0; i<10; ++i) {
+                Date maturity = today + Period(3*(i+1), Months);
+                for (Real strike=70.0; strike<=130.0; strike+=10.0) {
+                    boost::shared_ptr<VanillaOption> option(new VanillaOption(
+                        boost::shared_ptr<StrikedTypePayoff>(
+                             new PlainVanillaPayoff(Option::Call, strike)),
+                        boost::shared_ptr<Exercise>(
+                                         new EuropeanExercise(maturity))));
+                    option->setPricingEngine(engine);
+                    options_.push_back(option);
+                }
+            }
+        }
+        std::string name() const { return "HestonAnalytic"; }
+        Size operations() const { return options_.size(); }
+        void run() {
+            bump_();
+            for (Size i=0; i<options_.size(); ++i)
+                sink = sink + options_[i]->NPV();
+        }
+      private:
+        boost::shared_ptr<SimpleQuote> s0_;
+        QuoteBumper bump_;
+        std::vector<boost::shared_ptr<VanillaOption> > options_;
+    };
+
+
+    class FdAmerican : public BenchmarkKernel {
+      public:
+        FdAmerican() : s0_(new SimpleQuote(100.0)), bump_(s0_, 0.01) {
+            Date today = Settings::instance().evaluationDate();
+            DayCounter dc = Actual365Fixed();
+            boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+                new BlackScholesMertonProcess(
+                    Handle<Quote>(s0_),
+                    Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+                    Handle<YieldTermStructure>(flatRate(today, 0.04, dc)),
+                    Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+            option_ = boost::shared_ptr<VanillaOption>(new VanillaOption(
+                boost::shared_ptr<StrikedTypePayoff>(
+                                  new PlainVanillaPayoff(Option::Put, 100.0)),
+                boost::shared_ptr<Exercise>(
+                          new AmericanExercise(today, today + 1*Years))));
+            option_->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FDAmericanEngine<CrankNicolson>(process, 400, 400)));
+        }
+        std::string name() const { return "FdAmerican"; }
+        Size operations() const { return 1; }
+        void run() {
+            bump_();
+            sink = sink + option_->NPV();
+        }
+      private:
+        boost::shared_ptr<SimpleQuote> s0_;
+        QuoteBumper bump_;
+        boost::shared_ptr<VanillaOption> option_;
+    };
+
+
+    template <class Evolver>
+    class LmmPath : public BenchmarkKernel {
+      public:
+        LmmPath(const std::string& name, Volatility vol)
+        : name_(name) {
+            const Size n = 20;
+            std::vector<Time> rateTimes(n+1);
+            for (Size i=0; i<=n; ++i)
+                rateTimes[i] = 0.5*(i+1);
+            EvolutionDescription evolution(rateTimes);
+            std::vector<Rate> forwards(n, 0.04);
+            std::vector<Volatility> vols(n, vol);
+            std::vector<Spread> displacements(n, 0.0);
+            boost::shared_ptr<PiecewiseConstantCorrelation> correlations(
+                             new ExponentialForwardCorrelation(rateTimes));
+            boost::shared_ptr<MarketModel> model(
+                new FlatVol(vols, correlations, evolution, 3,
+                            forwards, displacements));
+            evolver_ = boost::shared_ptr<MarketModelEvolver>(
+                new Evolver(model, MTBrownianGeneratorFactory(42),
+                            terminalMeasure(evolution)));
+            steps_ = evolution.numberOfSteps();
+        }
+        std::string name() const { return name_; }
+        Size operations() const { return 1000; }
+        void run() {
+            for (Size i=0; i<operations(); ++i) {
+                Real weight = evolver_->startNewPath();
+                for (Size j=0; j<steps_; ++j)
+                    weight *= evolver_->advanceStep();
+                sink = sink + weight*evolver_->currentState().forwardRates()
+                                                                     .back();
+            }
+        }
+      private:
+        std::string name_;
+        boost::shared_ptr<MarketModelEvolver> evolver_;
+        Size steps_;
+    };
+
+
+    // same paths as LmmPath<LogNormalFwdRatePc>, evolved in batches
+    class LmmPathBatch : public BenchmarkKernel {
+      public:
+        LmmPathBatch() {
+            const Size n = 20;
+            std::vector<Time> rateTimes(n+1);
+            for (Size i=0; i<=n; ++i)
+                rateTimes[i] = 0.5*(i+1);
+            EvolutionDescription evolution(rateTimes);
+            std::vector<Rate> forwards(n, 0.04);
+            std::vector<Volatility> vols(n, 0.20);
+            std::vector<Spread> displacements(n, 0.0);
+            boost::shared_ptr<PiecewiseConstantCorrelation> correlations(
+                             new ExponentialForwardCorrelation(rateTimes));
+            boost::shared_ptr<MarketModel> model(
+                new FlatVol(vols, correlations, evolution, 3,
+                            forwards, displacements));
+            evolver_ = boost::shared_ptr<LogNormalFwdRatePc>(
+                new LogNormalFwdRatePc(model, MTBrownianGeneratorFactory(42),
+                                       terminalMeasure(evolution)));
+            steps_ = evolution.numberOfSteps();
+        }
+        std::string name() const { return "LmmPathBatch"; }
+        Size operations() const { return 1000; }
+        void run() {
+            const Size batchSize = 250;
+            for (Size i=0; i<operations(); i+=batchSize) {
+                evolver_->startNewPaths(batchSize, weights_);
+                for (Size j=0; j<steps_; ++j) {
+                    evolver_->advanceSteps(stepWeights_);
+                    for (Size p=0; p<batchSize; ++p)
+                        weights_[p] *= stepWeights_[p];
+                }
+                const Matrix& forwards = evolver_->currentForwards();
+                for (Size p=0; p<batchSize; ++p)
+                    sink = sink + weights_[p]*forwards[forwards.rows()-1][p];
+            }
+        }
+      private:
+        boost::shared_ptr<LogNormalFwdRatePc> evolver_;
+        Size steps_;
+        std::vector<Real> weights_, stepWeights_;
+    };
+
+
+    class LmmDrifts : public BenchmarkKernel {
+      public:
+        LmmDrifts() : forwards_(120, 256), drifts_(120, 256) {
+            const Size n = 120, factors = 5;
+            std::vector<Time> rateTimes(n+1);
+            for (Size i=0; i<=n; ++i)
+                rateTimes[i] = 0.25*(i+1);
+            EvolutionDescription evolution(rateTimes);
+            std::vector<Rate> forwards(n, 0.04);
+            std::vector<Volatility> vols(n, 0.20);
+            std::vector<Spread> displacements(n, 0.0);
+            boost::shared_ptr<PiecewiseConstantCorrelation> correlations(
+                             new ExponentialForwardCorrelation(rateTimes));
+            FlatVol model(vols, correlations, evolution, factors,
+                          forwards, displacements);
+            calculator_ = boost::shared_ptr<LMMDriftCalculator>(
+                new LMMDriftCalculator(model.pseudoRoot(0), displacements,
+                                       evolution.rateTaus(), n, 0));
+            for (Size i=0; i<n; ++i)
+                for (Size j=0; j<forwards_.columns(); ++j)
+                    forwards_[i][j] = 0.03 + 0.0001*((i+j)%50);
+        }
+        std::string name() const { return "LmmDrifts"; }
+        Size operations() const { return 100*forwards_.columns(); }
+        void run() {
+            for (Size i=0; i<100; ++i)
+                calculator_->compute(forwards_, drifts_);
+            sink = sink + drifts_[0][0];
+        }
+      private:
+        boost::shared_ptr<LMMDriftCalculator> calculator_;
+        Matrix forwards_, drifts_;
+    };
+
+
+    class SobolGeneration : public BenchmarkKernel {
+      public:
+        SobolGeneration() : rsg_(50, 42) {}
+        std::string name() const { return "SobolGeneration"; }
+        Size operations() const { return 20000; }
+        void run() {
+            Real sum = 0.0;
+            for (Size i=0; i<operations(); ++i)
+                sum += rsg_.nextSequence().value.back();
+            sink = sink + sum;
+        }
+      private:
+        SobolRsg rsg_;
+    };
+
+}
+
+
+std::vector<boost::shared_ptr<BenchmarkKernel> > benchmarkKernels() {
+    std::vector<boost::shared_ptr<BenchmarkKernel> > kernels;
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new CurveBootstrap));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new SwapNPV));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new BlackFormula));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new HestonAnalytic));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new FdAmerican));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(
+             new LmmPath<LogNormalFwdRatePc>("LmmPath", 0.20)));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(
+             new LmmPath<LogNormalFwdRateIpc>("LmmPathIpc", 0.20)));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(
+             new LmmPath<NormalFwdRatePc>("LmmPathNormal", 0.008)));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new LmmPathBatch));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new LmmDrifts));
+    kernels.push_back(boost::shared_ptr<BenchmarkKernel>(new SobolGeneration));
+    return kernels;
+}
+
@@ -0,0 +1,46 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 Kishore Rathi
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#ifndef quantlib_benchmark_kernels_hpp
+#define quantlib_benchmark_kernels_hpp
+
+#include <ql/types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+/* Micro-benchmarks of single library kernels.  Each kernel sets up
+   its market data and instruments when constructed; run() performs a
+   fixed amount of work, invalidating cached results when needed so
+   that the calculation is actually repeated.
+*/
+
+class BenchmarkKernel {
+  public:
+    virtual ~BenchmarkKernel() {}
+    virtual std::string name() const = 0;
+    //! number of elementary operations (prices, draws...) per run
+    virtual QuantLib::Size operations() const = 0;
+    virtual void run() = 0;
+};
+
+std::vector<boost::shared_ptr<BenchmarkKernel> > benchmarkKernels();
+
+
+#endif
@@ -224,10 +224,85 @@ void BermudanSwaptionTest::testCachedValues() {
                     << "expected:   " << otmValue);
 }
 
+void BermudanSwaptionTest::testCachedLattice() {
+
+    BOOST_MESSAGE("Testing reuse of the lattice by tree swaption engine...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                       0.04875825,
+                                       Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+    swaps.push_back(vars.makeSwap(0.8*atmRate));
+    swaps.push_back(vars.makeSwap(atmRate));
+    swaps.push_back(vars.makeSwap(1.2*atmRate));
+
+    boost::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     0.048696, 0.0058904));
+    std::vector<Date> exerciseDates;
+    const Leg& leg = swaps[1]->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    // the swaptions have the same mandatory times and share the lattice
+    boost::shared_ptr<PricingEngine> sharedEngine(
+                                            new TreeSwaptionEngine(model, 50));
+    std::vector<boost::shared_ptr<Swaption> > swaptions;
+    for (Size i=0; i<swaps.size(); i++) {
+        swaptions.push_back(boost::shared_ptr<Swaption>(
+                                             new Swaption(swaps[i], exercise)));
+        swaptions.back()->setPricingEngine(sharedEngine);
+    }
+
+    Real tolerance = 1.0e-10;
+
+    // the lattice must be rebuilt when the model or the curve change
+    for (Size n=0; n<3; n++) {
+        if (n == 1) {
+            Array params = model->params();
+            params[0] *= 1.5;
+            params[1] *= 1.2;
+            model->setParams(params);
+        } else if (n == 2) {
+            vars.termStructure.linkTo(flatRate(vars.settlement, 0.055,
+                                               Actual365Fixed()));
+        }
+
+        for (Size i=0; i<swaptions.size(); i++) {
+            Real calculated = swaptions[i]->NPV();
+
+            Swaption swaption(swaps[i], exercise);
+            swaption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                           new TreeSwaptionEngine(model, 50)));
+            Real expected = swaption.NPV();
+
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption value "
+                            "with shared lattice:\n"
+                            << "    calculated: " << calculated << "\n"
+                            << "    expected:   " << expected);
+        }
+    }
+}
+
 
 test_suite* BermudanSwaptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedLattice));
     return suite;
 }
 
@@ -28,6 +28,7 @@
 class BermudanSwaptionTest {
   public:
     static void testCachedValues();
+    static void testCachedLattice();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -39,6 +39,31 @@
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    // weekends and the 13th of each month are holidays
+    class TestCalendar : public Calendar {
+      private:
+        class Impl : public Calendar::WesternImpl {
+          public:
+            std::string name() const { return "test"; }
+            bool isBusinessDay(const Date& d) const {
+                return !isWeekend(d.weekday()) && d.dayOfMonth() != 13;
+            }
+        };
+      public:
+        TestCalendar() {
+            impl_ = boost::shared_ptr<Calendar::Impl>(new Impl);
+        }
+    };
+
+    bool isTestBusinessDay(const Date& d) {
+        return d.weekday() != Saturday && d.weekday() != Sunday
+            && d.dayOfMonth() != 13;
+    }
+
+}
+
 void CalendarTest::testModifiedCalendars() {
 
     BOOST_MESSAGE("Testing calendar modification...");
@@ -1109,6 +1134,98 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+void CalendarTest::testCachedBusinessDays() {
+
+    BOOST_MESSAGE("Testing cached business days...");
+
+    TestCalendar calendar;
+
+    // over the whole range of dates...
+    BigInteger count = 0;
+    Date first = Date::minDate(), last = Date::maxDate();
+    for (Date d = first; ; ++d) {
+        bool expected = isTestBusinessDay(d);
+        if (calendar.isBusinessDay(d) != expected)
+            BOOST_FAIL(d << " erroneously detected as "
+                       << (expected ? "holiday" : "business day"));
+        if (expected)
+            ++count;
+        if (d == last)
+            break;
+    }
+    BigInteger calculated = calendar.businessDaysBetween(first, last,
+                                                         true, true);
+    if (calculated != count)
+        BOOST_ERROR("wrong number of business days between "
+                    << first << " and " << last << ":"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << count);
+
+    // ...between a few pairs of dates...
+    Date start(12, January, 1995);
+    for (Integer i=0; i<40; ++i) {
+        Date from = start + (i*397)%1500, to = start + (i*1019)%9000;
+        BigInteger expected = 0;
+        for (Date d = std::min(from,to); d < std::max(from,to); ++d) {
+            if (isTestBusinessDay(d))
+                ++expected;
+        }
+        if (isTestBusinessDay(std::max(from,to)))
+            ++expected;
+        if (isTestBusinessDay(to))
+            --expected;
+        if (from > to)
+            expected = -expected;
+        calculated = calendar.businessDaysBetween(from, to);
+        if (calculated != expected)
+            BOOST_ERROR("wrong number of business days between "
+                        << from << " and " << to << ":"
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    // ...for joint calendars...
+    Calendar c1 = TARGET(), c2 = UnitedKingdom();
+    Calendar jointH = JointCalendar(c1, c2, JoinHolidays),
+             jointB = JointCalendar(c1, c2, JoinBusinessDays);
+    for (Date d = Date(1,January,1990); d < Date(1,January,2030); ++d) {
+        bool b1 = c1.isBusinessDay(d), b2 = c2.isBusinessDay(d);
+        if (jointH.isBusinessDay(d) != (b1 && b2))
+            BOOST_FAIL(d << " erroneously detected as "
+                       << (b1 && b2 ? "holiday" : "business day")
+                       << " by " << jointH.name());
+        if (jointB.isBusinessDay(d) != (b1 || b2))
+            BOOST_FAIL(d << " erroneously detected as "
+                       << (b1 || b2 ? "holiday" : "business day")
+                       << " by " << jointB.name());
+    }
+
+    // ...and after modifying the underlying calendars.
+    Date d1(26, April, 2004);   // business day for both calendars
+    Date d2(3, May, 2004);      // Early May Bank Holiday in the UK
+    c2.addHoliday(d1);
+    if (jointH.isBusinessDay(d1))
+        BOOST_ERROR(d1 << " (holiday added to " << c2.name()
+                    << ") not detected by " << jointH.name());
+    if (!jointB.isBusinessDay(d1))
+        BOOST_ERROR(d1 << " erroneously detected as holiday by "
+                    << jointB.name());
+    c2.removeHoliday(d1);
+    c2.removeHoliday(d2);
+    if (!jointH.isBusinessDay(d1))
+        BOOST_ERROR(d1 << " (holiday removed from " << c2.name()
+                    << ") erroneously detected as holiday by "
+                    << jointH.name());
+    if (!jointH.isBusinessDay(d2))
+        BOOST_ERROR(d2 << " (holiday removed from " << c2.name()
+                    << ") erroneously detected as holiday by "
+                    << jointH.name());
+    c2.addHoliday(d2);
+    if (jointH.isBusinessDay(d2))
+        BOOST_ERROR(d2 << " (holiday restored in " << c2.name()
+                    << ") not detected by " << jointH.name());
+}
+
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -1141,6 +1258,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testCachedBusinessDays));
 
     return suite;
 }
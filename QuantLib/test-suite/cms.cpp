@@ -37,6 +37,7 @@
 #include <ql/time/schedule.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/instruments/makecms.hpp>
+#include <ql/termstructures/volatility/swaption/cmsmarket.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -477,10 +478,231 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testCachedPricing() {
+
+    BOOST_MESSAGE("Testing cached and parallel numeric Hagan pricing...");
+
+    CommonVars vars;
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    // the coupons of the shorter swap are also in the longer one
+    shared_ptr<Swap> shortCms = MakeCms(5*Years, swapIndex,
+                                        vars.iborIndex, 0.0, 10*Days);
+    shared_ptr<Swap> longCms = MakeCms(10*Years, swapIndex,
+                                       vars.iborIndex, 0.0, 10*Days);
+    const Size shortCoupons = shortCms->leg(0).size();
+    const Size longCoupons = longCms->leg(0).size();
+
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+    Real tol = 1.0e-14;
+
+    for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+        shared_ptr<NumericHaganPricer> plainPricer(new
+            NumericHaganPricer(vars.SabrVolCube1, vars.yieldCurveModels[j],
+                               zeroMeanRev));
+        setCouponPricer(shortCms->leg(0), plainPricer);
+        Real expectedShort = shortCms->NPV();
+        setCouponPricer(longCms->leg(0), plainPricer);
+        Real expectedLong = longCms->NPV();
+
+        shared_ptr<NumericHaganPricer> cachedPricer(new
+            NumericHaganPricer(vars.SabrVolCube1, vars.yieldCurveModels[j],
+                               zeroMeanRev));
+        cachedPricer->enableCaching();
+        setCouponPricer(longCms->leg(0), cachedPricer);
+        Real calculatedLong = longCms->NPV();
+        setCouponPricer(shortCms->leg(0), cachedPricer);
+        Real calculatedShort = shortCms->NPV();
+
+        if (std::fabs(calculatedLong-expectedLong) > tol ||
+            std::fabs(calculatedShort-expectedShort) > tol)
+            BOOST_ERROR("failed to reproduce uncached prices"
+                        << "\n    yield curve model: "
+                        << vars.yieldCurveModels[j]
+                        << std::setprecision(16)
+                        << "\n    short swap:  " << calculatedShort
+                        << "\n    expected:    " << expectedShort
+                        << "\n    long swap:   " << calculatedLong
+                        << "\n    expected:    " << expectedLong);
+        // each swaplet needs a call and a put
+        if (cachedPricer->cacheMisses() != 2*longCoupons ||
+            cachedPricer->cacheHits() != 2*shortCoupons)
+            BOOST_ERROR("unexpected cache usage"
+                        << "\n    yield curve model: "
+                        << vars.yieldCurveModels[j]
+                        << "\n    misses:   " << cachedPricer->cacheMisses()
+                        << "\n    expected: " << 2*longCoupons
+                        << "\n    hits:     " << cachedPricer->cacheHits()
+                        << "\n    expected: " << 2*shortCoupons);
+
+        // a change of smile must discard the stored integrals
+        plainPricer->setSwaptionVolatility(vars.atmVol);
+        cachedPricer->setSwaptionVolatility(vars.atmVol);
+        calculatedShort = shortCms->NPV();
+        setCouponPricer(shortCms->leg(0), plainPricer);
+        expectedShort = shortCms->NPV();
+        if (std::fabs(calculatedShort-expectedShort) > tol)
+            BOOST_ERROR("cached prices not updated after smile change"
+                        << "\n    yield curve model: "
+                        << vars.yieldCurveModels[j]
+                        << std::setprecision(16)
+                        << "\n    calculated: " << calculatedShort
+                        << "\n    expected:   " << expectedShort);
+        plainPricer->setSwaptionVolatility(vars.SabrVolCube1);
+
+        shared_ptr<NumericHaganPricer> parallelPricer(new
+            NumericHaganPricer(vars.SabrVolCube1, vars.yieldCurveModels[j],
+                               zeroMeanRev));
+        parallelPricer->enableParallelPricing(2);
+        setCouponPricer(longCms->leg(0), parallelPricer);
+        parallelPricer->precalculate(longCms->leg(0));
+        Size misses = parallelPricer->cacheMisses();
+        calculatedLong = longCms->NPV();
+        if (std::fabs(calculatedLong-expectedLong) > tol)
+            BOOST_ERROR("failed to reproduce prices in parallel"
+                        << "\n    yield curve model: "
+                        << vars.yieldCurveModels[j]
+                        << std::setprecision(16)
+                        << "\n    calculated: " << calculatedLong
+                        << "\n    expected:   " << expectedLong);
+        if (misses != 2*longCoupons ||
+            parallelPricer->cacheMisses() != misses ||
+            parallelPricer->cacheHits() != 2*longCoupons)
+            BOOST_ERROR("coupons not precalculated"
+                        << "\n    yield curve model: "
+                        << vars.yieldCurveModels[j]
+                        << "\n    precalculated: " << misses
+                        << "\n    misses:        "
+                        << parallelPricer->cacheMisses()
+                        << "\n    hits:          "
+                        << parallelPricer->cacheHits()
+                        << "\n    expected:      " << 2*longCoupons);
+    }
+}
+
+void CmsTest::testCachedCmsMarketRepricing() {
+
+    BOOST_MESSAGE("Testing cached pricing during CMS-market repricing...");
+
+    CommonVars vars;
+
+    std::vector<shared_ptr<SwapIndex> > swapIndexes(2);
+    swapIndexes[0] = shared_ptr<SwapIndex>(new
+        EuriborSwapIsdaFixA(2*Years, vars.termStructure));
+    swapIndexes[1] = shared_ptr<SwapIndex>(new
+        EuriborSwapIsdaFixA(10*Years, vars.termStructure));
+    std::vector<Period> swapLengths;
+    swapLengths.push_back(2*Years);
+    swapLengths.push_back(5*Years);
+    std::vector<std::vector<Handle<Quote> > > bidAskSpreads(
+                                    swapLengths.size(),
+                                    std::vector<Handle<Quote> >(4));
+    for (Size i=0; i<swapLengths.size(); ++i)
+        for (Size j=0; j<4; ++j)
+            bidAskSpreads[i][j] =
+                Handle<Quote>(shared_ptr<Quote>(new SimpleQuote(0.0)));
+
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+    std::vector<shared_ptr<NumericHaganPricer> > cachedPricers(2);
+    std::vector<shared_ptr<HaganPricer> > pricers(2), plainPricers(2);
+    for (Size j=0; j<2; ++j) {
+        cachedPricers[j] = shared_ptr<NumericHaganPricer>(new
+            NumericHaganPricer(vars.SabrVolCube1, GFunctionFactory::Standard,
+                               zeroMeanRev));
+        cachedPricers[j]->enableCaching();
+        pricers[j] = cachedPricers[j];
+        plainPricers[j] = shared_ptr<HaganPricer>(new
+            NumericHaganPricer(vars.SabrVolCube1, GFunctionFactory::Standard,
+                               zeroMeanRev));
+    }
+    CmsMarket cachedMarket(swapLengths, swapIndexes, vars.iborIndex,
+                           bidAskSpreads, pricers, vars.termStructure);
+    CmsMarket plainMarket(swapLengths, swapIndexes, vars.iborIndex,
+                          bidAskSpreads, plainPricers, vars.termStructure);
+
+    std::vector<Size> hits(2), misses(2);
+    for (Size j=0; j<2; ++j) {
+        hits[j] = cachedPricers[j]->cacheHits();
+        misses[j] = cachedPricers[j]->cacheMisses();
+    }
+
+    // repricing with the same smile and mean reversion, as a
+    // calibration does for the tenors that are not moved...
+    cachedMarket.reprice(vars.SabrVolCube1, 0.0);
+    for (Size j=0; j<2; ++j) {
+        if (cachedPricers[j]->cacheMisses() != misses[j] ||
+            cachedPricers[j]->cacheHits() <= hits[j])
+            BOOST_ERROR("stored integrals not reused for unchanged smile"
+                        << "\n    swap index: " << swapIndexes[j]->name()
+                        << "\n    misses:     "
+                        << cachedPricers[j]->cacheMisses()
+                        << " (previously " << misses[j] << ")"
+                        << "\n    hits:       "
+                        << cachedPricers[j]->cacheHits()
+                        << " (previously " << hits[j] << ")");
+        hits[j] = cachedPricers[j]->cacheHits();
+    }
+
+    // ...recalibrating the smiles of a single tenor...
+    shared_ptr<SwaptionVolCube1> cube =
+        boost::dynamic_pointer_cast<SwaptionVolCube1>(*vars.SabrVolCube1);
+    cube->recalibration(0.6, 2*Years);
+    cachedMarket.reprice(vars.SabrVolCube1, 0.0);
+    if (cachedPricers[0]->cacheMisses() == misses[0])
+        BOOST_ERROR("stored integrals reused after smile change"
+                    << "\n    swap index: " << swapIndexes[0]->name());
+    if (cachedPricers[1]->cacheMisses() != misses[1] ||
+        cachedPricers[1]->cacheHits() <= hits[1])
+        BOOST_ERROR("stored integrals not reused for unchanged smile"
+                    << "\n    swap index: " << swapIndexes[1]->name()
+                    << "\n    misses:     "
+                    << cachedPricers[1]->cacheMisses()
+                    << " (previously " << misses[1] << ")"
+                    << "\n    hits:       "
+                    << cachedPricers[1]->cacheHits()
+                    << " (previously " << hits[1] << ")");
+
+    // ...and moving the mean reversion back and forth.
+    cachedMarket.reprice(vars.SabrVolCube1, 0.01);
+    for (Size j=0; j<2; ++j)
+        misses[j] = cachedPricers[j]->cacheMisses();
+    cachedMarket.reprice(vars.SabrVolCube1, 0.0);
+    for (Size j=0; j<2; ++j) {
+        if (cachedPricers[j]->cacheMisses() != misses[j])
+            BOOST_ERROR("stored integrals not reused for previous "
+                        "mean reversion"
+                        << "\n    swap index: " << swapIndexes[j]->name()
+                        << "\n    misses:     "
+                        << cachedPricers[j]->cacheMisses()
+                        << " (previously " << misses[j] << ")");
+    }
+
+    plainMarket.reprice(vars.SabrVolCube1, 0.0);
+    const Matrix& calculated = cachedMarket.impliedCmsSpreads();
+    const Matrix& expected = plainMarket.impliedCmsSpreads();
+    Real tol = 1.0e-14;
+    for (Size i=0; i<swapLengths.size(); ++i) {
+        for (Size j=0; j<2; ++j) {
+            if (std::fabs(calculated[i][j]-expected[i][j]) > tol)
+                BOOST_ERROR("failed to reproduce uncached spreads"
+                            << "\n    swap index:  "
+                            << swapIndexes[j]->name()
+                            << "\n    swap length: " << swapLengths[i]
+                            << std::setprecision(16)
+                            << "\n    calculated:  " << calculated[i][j]
+                            << "\n    expected:    " << expected[i][j]);
+        }
+    }
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCachedPricing));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCachedCmsMarketRepricing));
     return suite;
 }
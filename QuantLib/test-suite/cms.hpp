@@ -30,6 +30,8 @@ class CmsTest {
     static void testFairRate();
     static void testParity();
     static void testCmsSwap();
+    static void testCachedPricing();
+    static void testCachedCmsMarketRepricing();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -24,7 +24,9 @@
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/bivariatenormaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -367,10 +369,74 @@ void DistributionTest::testInverseCumulativePoisson() {
     }
 }
 
+void DistributionTest::testNormalRanges() {
+
+    BOOST_MESSAGE("Testing normal distributions on ranges of values...");
+
+    // the range versions must return the same values as the scalar ones
+    Size n = 2000;
+    std::vector<Real> x(n), u(n), calculated(n);
+    for (Size i=0; i<n; i++) {
+        x[i] = -40.0 + 80.0*i/(n-1.0);
+        // uniform values covering both tails down to 1e-12
+        u[i] = (i%2 == 0) ? (i+1.0)/(n+1.0)
+                          : std::pow(10.0, -12.0*i/n);
+    }
+    u.back() = 1.0-1.0e-12;
+
+    ErrorFunction erf;
+    erf(&x[0], &x[0]+n, &calculated[0]);
+    for (Size i=0; i<n; i++) {
+        if (calculated[i] != erf(x[i]))
+            BOOST_FAIL("ErrorFunction mismatch at x = " << x[i] << ":\n"
+                       << std::setprecision(17)
+                       << "    range:  " << calculated[i] << "\n"
+                       << "    scalar: " << erf(x[i]));
+    }
+
+    CumulativeNormalDistribution cdf(average, sigma);
+    cdf(&x[0], &x[0]+n, &calculated[0]);
+    for (Size i=0; i<n; i++) {
+        if (calculated[i] != cdf(x[i]))
+            BOOST_FAIL("CumulativeNormalDistribution mismatch at x = "
+                       << x[i] << ":\n"
+                       << std::setprecision(17)
+                       << "    range:  " << calculated[i] << "\n"
+                       << "    scalar: " << cdf(x[i]));
+    }
+
+    InverseCumulativeNormal invCdf(average, sigma);
+    invCdf(&u[0], &u[0]+n, &calculated[0]);
+    for (Size i=0; i<n; i++) {
+        if (calculated[i] != invCdf(u[i]))
+            BOOST_FAIL("InverseCumulativeNormal mismatch at x = "
+                       << u[i] << ":\n"
+                       << std::setprecision(17)
+                       << "    range:  " << calculated[i] << "\n"
+                       << "    scalar: " << invCdf(u[i]));
+    }
+
+    // the same holds when going through a sequence generator
+    Size dimension = 37;
+    LowDiscrepancy::ursg_type sobol(dimension, 42);
+    LowDiscrepancy::rsg_type rsg(sobol);
+    for (Size j=0; j<1000; j++) {
+        const std::vector<Real>& uniform = sobol.nextSequence().value;
+        const std::vector<Real>& normal = rsg.nextSequence().value;
+        for (Size i=0; i<dimension; i++) {
+            if (normal[i] != InverseCumulativeNormal::standard_value(
+                                                                 uniform[i]))
+                BOOST_FAIL("InverseCumulativeRsg mismatch in "
+                           << io::ordinal(j+1) << " sequence");
+        }
+    }
+}
+
 
 test_suite* DistributionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormal));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormalRanges));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariate));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testPoisson));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testCumulativePoisson));
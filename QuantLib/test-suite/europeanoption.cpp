@@ -1298,6 +1298,86 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testParallelMcEngines() {
+
+    BOOST_MESSAGE("Testing reproducibility of parallel "
+                  "Monte Carlo European engines...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+         new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                       Handle<YieldTermStructure>(qTS),
+                                       Handle<YieldTermStructure>(rTS),
+                                       Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(today+360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                        new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    Size samples = 10000, threads[] = { 1, 2, 5 };
+
+    // pseudo-random numbers: results independent of the thread count
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(4)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withAntitheticVariate()
+                            .withThreads(threads[0]));
+    Real reference = option.NPV();
+    Real error = option.errorEstimate();
+    if (std::fabs(reference-expected) > 4.0*error)
+        BOOST_ERROR("parallel pseudo-random engine out of tolerance:"
+                    << "\n    calculated: " << reference
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+
+    for (Size i=1; i<LENGTH(threads); ++i) {
+        option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                                .withSteps(4)
+                                .withSamples(samples)
+                                .withSeed(42)
+                                .withAntitheticVariate()
+                                .withThreads(threads[i]));
+        Real calculated = option.NPV();
+        if (std::fabs(calculated-reference) > 1.0e-12)
+            BOOST_ERROR("results depend on the number of threads:"
+                        << "\n    threads:    " << threads[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    with one thread: " << reference);
+    }
+
+    // low-discrepancy numbers: results equal to the serial ones
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                            .withSteps(4)
+                            .withSamples(samples));
+    Real serial = option.NPV();
+    for (Size i=0; i<LENGTH(threads); ++i) {
+        option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                                .withSteps(4)
+                                .withSamples(samples)
+                                .withThreads(threads[i]));
+        Real calculated = option.NPV();
+        if (std::fabs(calculated-serial) > 1.0e-12)
+            BOOST_ERROR("parallel and serial low-discrepancy results differ:"
+                        << "\n    threads:  " << threads[i]
+                        << "\n    parallel: " << calculated
+                        << "\n    serial:   " << serial);
+    }
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_MESSAGE("Testing FFT European engines "
@@ -1570,6 +1650,7 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testParallelMcEngines));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
@@ -39,6 +39,9 @@
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/ilu0preconditioner.hpp>
+#include <ql/math/matrixutilities/compressedrowmatrix.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
@@ -1310,6 +1313,256 @@ void FdmLinearOpTest::testSparseMatrixZeroAssignment() {
 #endif
 }
 
+void FdmLinearOpTest::testParallelSchemes() {
+
+    BOOST_MESSAGE("Testing multi-threaded splitting schemes...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+
+    Size dims[] = {200, 100};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>( 3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>( 0.000, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(index, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    boost::shared_ptr<FdmLinearOpComposite> hestonOp(
+                                   new FdmHestonOp(mesher, hestonProcess));
+
+    Array payoff(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        payoff[iter.index()] =
+            std::max(std::exp(mesher->location(iter,0))-100, 0.0);
+    }
+
+    FdmBoundaryConditionSet bcSet;
+    bcSet.push_back(boost::shared_ptr<FdmDirichletBoundary>(
+        new FdmDirichletBoundary(mesher, 0.0, 0,
+                                 FdmDirichletBoundary::Upper)));
+
+    FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                FdmSchemeDesc::CraigSneyd(),
+                                FdmSchemeDesc::ModifiedCraigSneyd(),
+                                FdmSchemeDesc::Hundsdorfer() };
+    Size threads[] = { 0, 3 };
+
+    for (Size i=0; i<LENGTH(schemes); ++i) {
+        Array expected = payoff;
+        FdmBackwardSolver(hestonOp, bcSet,
+                          boost::shared_ptr<FdmStepConditionComposite>(),
+                          schemes[i]).rollback(expected, 1.0, 0.0, 20, 1);
+
+        for (Size j=0; j<LENGTH(threads); ++j) {
+            Array calculated = payoff;
+            FdmBackwardSolver(hestonOp, bcSet,
+                              boost::shared_ptr<FdmStepConditionComposite>(),
+                              schemes[i].withThreads(threads[j]))
+                .rollback(calculated, 1.0, 0.0, 20, 1);
+
+            for (Size k=0; k<calculated.size(); ++k) {
+                if (calculated[k] != expected[k])
+                    BOOST_FAIL("failed to reproduce serial results"
+                               << "\n    scheme:     " << i
+                               << "\n    threads:    " << threads[j]
+                               << "\n    index:      " << k
+                               << std::setprecision(16)
+                               << "\n    serial:     " << expected[k]
+                               << "\n    calculated: " << calculated[k]);
+            }
+        }
+    }
+}
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+namespace {
+
+    boost::shared_ptr<FdmLinearOpComposite> smallHestonOp() {
+        Size dims[] = {41, 21};
+        const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+        boost::shared_ptr<FdmLinearOpLayout> index(
+                                                new FdmLinearOpLayout(dim));
+
+        std::vector<std::pair<Real, Real> > boundaries;
+        boundaries.push_back(std::pair<Real, Real>( 3.8, 4.905274778));
+        boundaries.push_back(std::pair<Real, Real>( 0.000, 1.0));
+
+        boost::shared_ptr<FdmMesher> mesher(
+            new UniformGridMesher(index, boundaries));
+
+        Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+        Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+        Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+        boost::shared_ptr<HestonProcess> hestonProcess(
+            new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+        boost::shared_ptr<FdmLinearOpComposite> hestonOp(
+                                     new FdmHestonOp(mesher, hestonProcess));
+        hestonOp->setTime(0.0, 0.1);
+        return hestonOp;
+    }
+
+}
+#endif
+
+void FdmLinearOpTest::testCompressedRowMatrix() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_MESSAGE("Testing compressed-row sparse matrix...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+
+    const boost::shared_ptr<FdmLinearOpComposite> hestonOp = smallHestonOp();
+    const SparseMatrix a = hestonOp->toMatrix();
+    const CompressedRowMatrix m = hestonOp->toCompressedRowMatrix();
+
+    if (m.rows() != a.size1() || m.columns() != a.size2())
+        BOOST_FAIL("wrong size of compressed-row matrix"
+                   << "\n    expected:   " << a.size1() << "x" << a.size2()
+                   << "\n    calculated: " << m.rows() << "x" << m.columns());
+
+    for (Size i=0; i < m.rows(); ++i) {
+        for (Size j=0; j < m.columns(); ++j) {
+            if (std::fabs(m(i,j) - a(i,j)) > 1e-10*(1.0+std::fabs(a(i,j))))
+                BOOST_FAIL("wrong element (" << i << ", " << j << ")"
+                           << "\n    expected:   " << a(i,j)
+                           << "\n    calculated: " << m(i,j));
+        }
+    }
+
+    Array x(m.columns());
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < x.size(); ++i)
+        x[i] = rng.next().value;
+
+    const Array expected = prod(a, x);
+    const Array fromUblas = prod(CompressedRowMatrix(a), x);
+    const Array calculated = prod(m, x);
+    for (Size i=0; i < x.size(); ++i) {
+        const Real tol = 1e-10*(1.0+std::fabs(expected[i]));
+        if (std::fabs(calculated[i] - expected[i]) > tol
+            || std::fabs(fromUblas[i] - expected[i]) > tol)
+            BOOST_FAIL("wrong product of compressed-row matrix and array"
+                       << "\n    index:       " << i
+                       << "\n    expected:    " << expected[i]
+                       << "\n    calculated:  " << calculated[i]
+                       << "\n    from uBLAS:  " << fromUblas[i]);
+    }
+
+    const Real dt = 0.1;
+    const CompressedRowMatrix b = identityPlus(1.0, -dt, m);
+    const Array bx = prod(b, x);
+    const Array ex = x - dt*prod(m, x);
+    for (Size i=0; i < x.size(); ++i) {
+        if (std::fabs(bx[i] - ex[i]) > 1e-10*(1.0+std::fabs(ex[i])))
+            BOOST_FAIL("wrong product of implicit-step matrix and array"
+                       << "\n    index:       " << i
+                       << "\n    expected:    " << ex[i]
+                       << "\n    calculated:  " << bx[i]);
+    }
+#endif
+}
+
+void FdmLinearOpTest::testGMRES() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_MESSAGE("Testing GMRES with Heston operator...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+
+    const boost::shared_ptr<FdmLinearOpComposite> hestonOp = smallHestonOp();
+
+    const Real dt = 0.1;
+    const CompressedRowMatrix a =
+        identityPlus(1.0, -dt, hestonOp->toCompressedRowMatrix());
+    const Size n = a.rows();
+
+    const ILU0Preconditioner ilu(a);
+
+    boost::function<Disposable<Array>(const Array&)> matmult(
+        boost::bind(&CompressedRowMatrix::apply, &a, _1));
+    boost::function<Disposable<Array>(const Array&)> precond(
+        boost::bind(&ILU0Preconditioner::apply, &ilu, _1));
+
+    Array b(n);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    std::vector<Array> solutions;
+    std::vector<std::string> methods;
+
+    const GMRESResult result = GMRES(matmult, n, tol, precond).solve(b);
+    solutions.push_back(result.x);
+    methods.push_back("preconditioned GMRES");
+
+    const Size restart = 10;
+    const GMRESResult restarted =
+        GMRES(matmult, restart, tol).solveWithRestart(n, b);
+    solutions.push_back(restarted.x);
+    methods.push_back("restarted GMRES");
+
+    solutions.push_back(BiCGstab(matmult, n, tol, precond).solve(b).x);
+    methods.push_back("BiCGstab with ILU(0) preconditioner");
+
+    for (Size k=0; k < solutions.size(); ++k) {
+        const Array r = b - prod(a, solutions[k]);
+        const Real error = std::sqrt(DotProduct(r, r)/DotProduct(b, b));
+        if (error > tol) {
+            BOOST_FAIL("Error calculating the inverse using "
+                       << methods[k] <<
+                       "\n tolerance:  " << tol <<
+                       "\n error:      " << error);
+        }
+    }
+
+    if (restarted.errors.size() <= restart+1)
+        BOOST_FAIL("restarted GMRES converged without restarts"
+                   << "\n iterations:  " << restarted.errors.size()-1);
+
+    // implicit Euler steps with the two solvers
+    Array biCGstabStep = b, gmresStep = b;
+    ImplicitEulerScheme biCGstabScheme(hestonOp,
+                                       ImplicitEulerScheme::bc_set(), 1e-10,
+                                       ImplicitEulerScheme::BiCGstab);
+    ImplicitEulerScheme gmresScheme(hestonOp,
+                                    ImplicitEulerScheme::bc_set(), 1e-10,
+                                    ImplicitEulerScheme::GMRES);
+    biCGstabScheme.setStep(dt);
+    gmresScheme.setStep(dt);
+    biCGstabScheme.step(biCGstabStep, dt);
+    gmresScheme.step(gmresStep, dt);
+
+    for (Size i=0; i < n; ++i) {
+        if (std::fabs(biCGstabStep[i] - gmresStep[i]) > 1e-8)
+            BOOST_FAIL("implicit step with GMRES differs from BiCGstab"
+                       << "\n index:     " << i
+                       << "\n BiCGstab:  " << biCGstabStep[i]
+                       << "\n GMRES:     " << gmresStep[i]);
+    }
+#endif
+}
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1336,6 +1589,10 @@ test_suite* FdmLinearOpTest::suite() {
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testParallelSchemes));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCompressedRowMatrix));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
 
     return suite;
     
@@ -43,6 +43,9 @@ public:
     static void testCrankNicolsonWithDamping();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
+    static void testParallelSchemes();
+    static void testCompressedRowMatrix();
+    static void testGMRES();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -36,6 +36,7 @@
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -1210,6 +1211,158 @@ void HestonModelTest::testAlanLewisReferencePrices() {
     }
 }
 
+void HestonModelTest::testCachedCharacteristicFunction() {
+    BOOST_MESSAGE("Testing Heston engine with cached characteristic "
+                  "function...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = ActualActual();
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.03, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+            riskFreeTS, dividendTS, s0, 0.07, 2.0, 0.04, 0.55, -0.8))));
+
+    const Real strikes[] = { 60.0, 80.0, 95.0, 100.0, 105.0, 120.0, 150.0 };
+    const Integer maturities[] = { 3, 12, 60 };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    // the engine is shared by all the options
+    boost::shared_ptr<AnalyticHestonEngine> engine(
+        new AnalyticHestonEngine(
+            model, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLaguerre(128)));
+
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    for (Size i=0; i < LENGTH(maturities); ++i) {
+        boost::shared_ptr<Exercise> exercise(
+            new EuropeanExercise(settlementDate
+                                 + Period(maturities[i], Months)));
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            for (Size k=0; k < LENGTH(types); ++k) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                    new PlainVanillaPayoff(types[k], strikes[j]));
+                options.push_back(boost::shared_ptr<VanillaOption>(
+                                        new VanillaOption(payoff, exercise)));
+                options.back()->setPricingEngine(engine);
+            }
+        }
+    }
+
+    const Real tolerance = 1.0e-10;
+
+    // the second set of parameters checks that the cache is refreshed
+    Array params = model->params();
+    for (Size n=0; n<2; ++n) {
+        if (n == 1) {
+            params[0] *= 1.2;
+            params[2] *= 0.8;
+            model->setParams(params);
+        }
+
+        for (Size i=0; i<options.size(); ++i) {
+            Real calculated = options[i]->NPV();
+            Size evaluations = engine->numberOfEvaluations();
+
+            // characteristic function evaluated anew by a new engine
+            boost::shared_ptr<StrikedTypePayoff> payoff =
+                boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                     options[i]->payoff());
+            VanillaOption option(payoff, options[i]->exercise());
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new AnalyticHestonEngine(
+                    model, AnalyticHestonEngine::Gatheral,
+                    AnalyticHestonEngine::Integration::gaussLaguerre(128))));
+            Real expected = option.NPV();
+
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce option price"
+                            << "\n    strike:     " << payoff->strike()
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+
+            // only the first option for each maturity evaluates it
+            bool firstForMaturity = (i % (2*LENGTH(strikes)) == 0);
+            if (firstForMaturity != (evaluations != 0))
+                BOOST_ERROR("unexpected number of evaluations ("
+                            << evaluations << ") for option " << i);
+        }
+    }
+}
+
+void HestonModelTest::testFFTEngine() {
+    BOOST_MESSAGE("Testing FFT Heston engine against analytic engine...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = ActualActual();
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.03, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+            riskFreeTS, dividendTS, s0, 0.07, 2.0, 0.04, 0.55, -0.8))));
+
+    boost::shared_ptr<PricingEngine> analyticEngine(
+                                        new AnalyticHestonEngine(model, 192));
+    boost::shared_ptr<FFTEngine> fftEngine(new FFTHestonEngine(model));
+
+    const Real strikes[] = { 70.0, 85.0, 95.0, 100.0, 105.0, 115.0, 130.0 };
+    const Integer maturities[] = { 6, 12, 24 };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    std::vector<boost::shared_ptr<Instrument> > options;
+    for (Size i=0; i < LENGTH(maturities); ++i) {
+        boost::shared_ptr<Exercise> exercise(
+            new EuropeanExercise(settlementDate
+                                 + Period(maturities[i], Months)));
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            for (Size k=0; k < LENGTH(types); ++k) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                    new PlainVanillaPayoff(types[k], strikes[j]));
+                options.push_back(boost::shared_ptr<Instrument>(
+                                        new VanillaOption(payoff, exercise)));
+            }
+        }
+    }
+
+    const Real tolerance = 1.0e-2;
+
+    // the second set of parameters checks that the results are
+    // recalculated when the model changes
+    Array params = model->params();
+    for (Size n=0; n<2; ++n) {
+        if (n == 1) {
+            params[2] *= 1.5;
+            model->setParams(params);
+        }
+
+        fftEngine->precalculate(options);
+        for (Size i=0; i<options.size(); ++i) {
+            options[i]->setPricingEngine(fftEngine);
+            Real calculated = options[i]->NPV();
+            options[i]->setPricingEngine(analyticEngine);
+            Real expected = options[i]->NPV();
+
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce analytic option price"
+                            << "\n    option:     " << i
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* HestonModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -1232,6 +1385,9 @@ test_suite* HestonModelTest::suite() {
                     &HestonModelTest::testDAXCalibrationOfTimeDependentModel));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAlanLewisReferencePrices));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testCachedCharacteristicFunction));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFFTEngine));
 
     return suite;
 }
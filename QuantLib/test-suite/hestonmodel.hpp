@@ -40,6 +40,8 @@ class HestonModelTest {
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
     static void testAlanLewisReferencePrices();
+    static void testCachedCharacteristicFunction();
+    static void testFFTEngine();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -20,11 +20,34 @@
 #include "instruments.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/portfoliovaluation.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/binomialengine.hpp>
+#include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <boost/bind.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    boost::shared_ptr<PricingEngine> makeAnalyticEngine(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& p) {
+        return boost::shared_ptr<PricingEngine>(
+                                            new AnalyticEuropeanEngine(p));
+    }
+
+    boost::shared_ptr<PricingEngine> makeBinomialEngine(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& p) {
+        return boost::shared_ptr<PricingEngine>(
+                  new BinomialVanillaEngine<CoxRossRubinstein>(p, 201));
+    }
+
+}
+
 void InstrumentTest::testObservable() {
 
     BOOST_MESSAGE("Testing observability of instruments...");
@@ -61,9 +84,106 @@ void InstrumentTest::testObservable() {
 }
 
 
+void InstrumentTest::testPortfolioValuation() {
+
+    BOOST_MESSAGE("Testing portfolio valuation...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, May, 2013);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+                   new BlackScholesMertonProcess(spot, qTS, rTS, volTS));
+
+    PortfolioValuation portfolio(3);
+    Size analytic = portfolio.addEngine(
+                                  boost::bind(&makeAnalyticEngine, process));
+    Size binomial = portfolio.addEngine(
+                                  boost::bind(&makeBinomialEngine, process));
+
+    std::vector<boost::shared_ptr<Instrument> > instruments;
+    std::vector<boost::shared_ptr<PricingEngine> > engines;
+    for (Size i=0; i<40; i++) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+            new PlainVanillaPayoff(i%2 == 0 ? Option::Call : Option::Put,
+                                   80.0 + i));
+        Date maturity = today + (i%3 == 0 ? -1 : 1)*Period(i+1, Months);
+        boost::shared_ptr<Instrument> option;
+        if (i%4 == 1) {
+            boost::shared_ptr<Exercise> exercise(
+                  new AmericanExercise(std::min(today, maturity), maturity));
+            option = boost::shared_ptr<Instrument>(
+                                     new VanillaOption(payoff, exercise));
+            portfolio.add(option, binomial);
+            engines.push_back(makeBinomialEngine(process));
+        } else {
+            boost::shared_ptr<Exercise> exercise(
+                                            new EuropeanExercise(maturity));
+            option = boost::shared_ptr<Instrument>(
+                                     new VanillaOption(payoff, exercise));
+            portfolio.add(option, analytic);
+            engines.push_back(makeAnalyticEngine(process));
+        }
+        instruments.push_back(option);
+    }
+
+    // an instrument priced by its own engine...
+    boost::shared_ptr<Instrument> stock(new Stock(spot));
+    portfolio.add(stock);
+    instruments.push_back(stock);
+    engines.push_back(boost::shared_ptr<PricingEngine>());
+
+    // ...and one that fails
+    boost::shared_ptr<Instrument> failing(new VanillaOption(
+        boost::shared_ptr<StrikedTypePayoff>(
+                               new PlainVanillaPayoff(Option::Call, 100.0)),
+        boost::shared_ptr<Exercise>(
+                         new AmericanExercise(today, today + 1*Years))));
+    portfolio.add(failing, analytic);
+    Size failed = instruments.size();
+    instruments.push_back(failing);
+    engines.push_back(makeAnalyticEngine(process));
+
+    portfolio.calculate();
+
+    if (portfolio.NPVs().size() != instruments.size())
+        BOOST_FAIL("wrong number of results: " << portfolio.NPVs().size()
+                   << " instead of " << instruments.size());
+
+    for (Size i=0; i<instruments.size(); i++) {
+        if (i == failed) {
+            if (portfolio.errors()[i].empty())
+                BOOST_ERROR("no error reported for failing instrument");
+            if (portfolio.NPVs()[i] != Null<Real>())
+                BOOST_ERROR("non-null NPV returned for failing instrument");
+            continue;
+        }
+        if (!portfolio.errors()[i].empty())
+            BOOST_FAIL("error pricing " << io::ordinal(i+1)
+                       << " instrument: " << portfolio.errors()[i]);
+        if (engines[i])
+            instruments[i]->setPricingEngine(engines[i]);
+        Real expected = instruments[i]->NPV();
+        if (portfolio.NPVs()[i] != expected)
+            BOOST_ERROR("failed to reproduce NPV of " << io::ordinal(i+1)
+                        << " instrument:"
+                        << std::setprecision(12)
+                        << "\n    portfolio:  " << portfolio.NPVs()[i]
+                        << "\n    instrument: " << expected);
+    }
+}
+
+
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioValuation));
     return suite;
 }
 
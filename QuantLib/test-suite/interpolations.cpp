@@ -30,9 +30,13 @@
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
+#include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/math/interpolations/kernelinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/interpolations/gridlocator.hpp>
 #include <ql/math/integrals/simpsonintegral.hpp>
 #include <ql/math/kernelfunctions.hpp>
 #include <ql/math/functional.hpp>
@@ -1327,6 +1331,69 @@ void InterpolationTest::testSabrInterpolation(){
 }
 
 
+void InterpolationTest::testSabrVolatilityEvaluator() {
+
+    BOOST_MESSAGE("Testing Sabr volatility evaluation on multiple strikes...");
+
+    Real tolerance = 1.0e-14;
+    Time expiry = 2.0;
+    Real forward = 0.04;
+    // the last set has rho close to zero and nu small, so that the
+    // expansion around z=0 is used near the money
+    Real parameters[][4] = { { 0.05, 0.5, 0.40, -0.30 },
+                             { 0.20, 0.0, 0.80,  0.50 },
+                             { 0.02, 1.0, 0.30, -0.70 },
+                             { 0.03, 0.7, 1.0e-9, 0.0 } };
+    Real shifts[] = { 0.0, 0.02 };
+
+    std::vector<Rate> strikes;
+    for (Size i=0; i<=40; i++)
+        strikes.push_back(0.005*(i+1));
+    strikes.push_back(forward);
+    strikes.push_back(forward*(1.0+1.0e-10));
+
+    for (Size i=0; i<LENGTH(parameters); i++) {
+        Real alpha = parameters[i][0], beta = parameters[i][1],
+             nu = parameters[i][2], rho = parameters[i][3];
+        std::vector<Real> sabrParameters(parameters[i], parameters[i]+4);
+        for (Size j=0; j<LENGTH(shifts); j++) {
+            Real shift = shifts[j];
+            SabrVolatilityEvaluator sabr(forward, expiry, alpha, beta,
+                                         nu, rho, shift);
+            SabrSmileSection smile(expiry, forward, sabrParameters, shift);
+            std::vector<Volatility> vols(strikes.size()),
+                                    smileVols(strikes.size());
+            sabr(strikes.begin(), strikes.end(), vols.begin());
+            smile.volatilities(strikes.begin(), strikes.end(),
+                               smileVols.begin());
+            for (Size k=0; k<strikes.size(); k++) {
+                Volatility expected =
+                    unsafeSabrVolatility(strikes[k]+shift, forward+shift,
+                                         expiry, alpha, beta, nu, rho);
+                Volatility single = sabr(strikes[k]);
+                Volatility section = smile.volatility(strikes[k]);
+                if (std::fabs(vols[k]-expected) > tolerance ||
+                    std::fabs(single-expected) > tolerance ||
+                    std::fabs(smileVols[k]-expected) > tolerance ||
+                    std::fabs(section-expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce Sabr volatility:"
+                                << "\n    alpha:       " << alpha
+                                << "\n    beta:        " << beta
+                                << "\n    nu:          " << nu
+                                << "\n    rho:         " << rho
+                                << "\n    shift:       " << shift
+                                << "\n    strike:      " << strikes[k]
+                                << "\n    expected:    " << expected
+                                << "\n    evaluator:   " << single
+                                << "\n    multiple:    " << vols[k]
+                                << "\n    smile:       " << section
+                                << "\n    smile (multiple): "
+                                << smileVols[k]);
+            }
+        }
+    }
+}
+
 void InterpolationTest::testKernelInterpolation() {
 
     BOOST_MESSAGE("Testing kernel 1D interpolation...");
@@ -1688,6 +1755,191 @@ void InterpolationTest::testRichardsonExtrapolation() {
     }
 }
 
+namespace {
+
+    Size referenceLocate(const std::vector<Real>& x, Real t) {
+        if (t < x.front())
+            return 0;
+        else if (t > x.back())
+            return x.size()-2;
+        else
+            return std::upper_bound(x.begin(),x.end()-1,t)-x.begin()-1;
+    }
+
+    void checkLocator(const std::string& grid,
+                      const std::vector<Real>& x) {
+        typedef std::vector<Real>::const_iterator iterator;
+        detail::GridLocator<iterator> locator;
+        locator.reset(x.begin(), x.end());
+
+        // queries: nodes, midpoints and points outside the range,
+        // in increasing, decreasing and scrambled order
+        std::vector<Real> t;
+        t.push_back(x.front()-1.0);
+        for (Size i=0; i<x.size(); ++i) {
+            t.push_back(x[i]);
+            if (i+1 < x.size()) {
+                t.push_back(0.5*(x[i]+x[i+1]));
+                t.push_back(x[i+1]-1.0e-12);
+            }
+        }
+        t.push_back(x.back()+1.0);
+        Size n = t.size();
+        std::vector<Real> queries(t);
+        queries.insert(queries.end(), t.rbegin(), t.rend());
+        for (Size i=0; i<n; ++i)
+            queries.push_back(t[(i*37)%n]);
+
+        Size hint = 0;
+        for (Size i=0; i<queries.size(); ++i) {
+            Size expected = referenceLocate(x, queries[i]);
+            Size calculated = locator(x.begin(), x.end(), queries[i]);
+            if (calculated != expected)
+                BOOST_FAIL("failed to locate point on " << grid << " grid:"
+                           << std::setprecision(16)
+                           << "\n    point:      " << queries[i]
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+            calculated = locator(x.begin(), x.end(), queries[i], hint);
+            if (calculated != expected || hint != expected)
+                BOOST_FAIL("failed to locate point on " << grid << " grid "
+                           "with hint:"
+                           << std::setprecision(16)
+                           << "\n    point:      " << queries[i]
+                           << "\n    calculated: " << calculated
+                           << "\n    hint:       " << hint
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+}
+
+void InterpolationTest::testGridLocation() {
+    BOOST_MESSAGE("Testing location of points in interpolation grids...");
+
+    std::vector<Real> x(21);
+    for (Size i=0; i<x.size(); ++i)
+        x[i] = i*0.1;
+    checkLocator("uniform", x);
+
+    for (Size i=0; i<x.size(); ++i)
+        x[i] = (i + 0.2*std::sin(Real(i)))/12.0;
+    checkLocator("nearly uniform", x);
+
+    for (Size i=0; i<x.size(); ++i)
+        x[i] = i*i*0.01;
+    checkLocator("non-uniform", x);
+
+    x.resize(2);
+    checkLocator("two-point", x);
+
+    // a grid modified after the locator was set up
+    typedef std::vector<Real>::const_iterator iterator;
+    x.resize(11);
+    for (Size i=0; i<x.size(); ++i)
+        x[i] = i;
+    detail::GridLocator<iterator> locator;
+    locator.reset(x.begin(), x.end());
+    for (Size i=0; i<x.size(); ++i)
+        x[i] = std::pow(Real(i), 1.5);
+    Size hint = 0;
+    for (Real t=-1.0; t<40.0; t+=0.25) {
+        Size calculated = locator(x.begin(), x.end(), t);
+        Size expected = referenceLocate(x, t);
+        if (calculated != expected ||
+            locator(x.begin(), x.end(), t, hint) != expected)
+            BOOST_FAIL("failed to locate point on modified grid:"
+                       << "\n    point:      " << t
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+}
+
+void InterpolationTest::testMultipleValues() {
+    BOOST_MESSAGE("Testing interpolation on multiple points...");
+
+    Size N = 15;
+    std::vector<Real> x(N), y(N), z(N);
+    for (Size i=0; i<N; ++i) {
+        x[i] = i*i*0.1;
+        y[i] = 1.0 + 0.3*std::sin(x[i]);
+        z[i] = i*0.5;
+    }
+    Matrix f(N, N);
+    for (Size i=0; i<N; ++i)
+        for (Size j=0; j<N; ++j)
+            f[i][j] = y[j] * (1.0 + z[i]);
+
+    std::vector<Interpolation> interpolations;
+    interpolations.push_back(
+                  LinearInterpolation(x.begin(), x.end(), y.begin()));
+    interpolations.push_back(
+                  LogLinearInterpolation(x.begin(), x.end(), y.begin()));
+    interpolations.push_back(
+                  CubicNaturalSpline(x.begin(), x.end(), y.begin()));
+    interpolations.push_back(
+                  MonotonicLogCubicNaturalSpline(x.begin(), x.end(),
+                                                 y.begin()));
+    interpolations.push_back(
+                  ForwardFlatInterpolation(x.begin(), x.end(), y.begin()));
+
+    BilinearInterpolation bilinear(x.begin(), x.end(),
+                                   z.begin(), z.end(), f);
+
+    // increasing points first, then scrambled ones
+    Size M = 250;
+    Real xMax = x.back(), zMax = z.back();
+    std::vector<Real> t(2*M), u(2*M);
+    for (Size k=0; k<M; ++k) {
+        t[k] = xMax*k/(M-1);
+        t[M+k] = xMax*((k*71)%M)/(M-1);
+        u[k] = zMax*((k*13)%M)/(M-1);
+        u[M+k] = zMax*k/(M-1);
+    }
+
+    std::vector<Real> calculated(2*M);
+    for (Size i=0; i<interpolations.size(); ++i) {
+        interpolations[i](&t[0], &calculated[0], t.size());
+        for (Size k=0; k<t.size(); ++k) {
+            Real expected = interpolations[i](t[k]);
+            if (calculated[k] != expected)
+                BOOST_FAIL("failed to reproduce single-point interpolation "
+                           "(" << io::ordinal(i+1) << " interpolation):"
+                           << std::setprecision(16)
+                           << "\n    point:      " << t[k]
+                           << "\n    calculated: " << calculated[k]
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    bilinear(&t[0], &u[0], &calculated[0], t.size());
+    for (Size k=0; k<t.size(); ++k) {
+        Real expected = bilinear(t[k], u[k]);
+        if (calculated[k] != expected)
+            BOOST_FAIL("failed to reproduce single-point "
+                       "bilinear interpolation:"
+                       << std::setprecision(16)
+                       << "\n    point:      (" << t[k] << ", " << u[k] << ")"
+                       << "\n    calculated: " << calculated[k]
+                       << "\n    expected:   " << expected);
+    }
+
+    // extrapolation must be enabled explicitly
+    Real outside[] = { 1.0, xMax + 1.0 };
+    Real results[2];
+    bool failed = false;
+    try {
+        interpolations[0](outside, results, 2);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_ERROR("extrapolation allowed on multiple points");
+    interpolations[0](outside, results, 2, true);
+    if (results[1] != interpolations[0](xMax + 1.0, true))
+        BOOST_ERROR("failed to extrapolate on multiple points");
+}
+
 
 test_suite* InterpolationTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Interpolation tests");
@@ -1711,6 +1963,8 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBackwardFlat));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testForwardFlat));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrInterpolation));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &InterpolationTest::testSabrVolatilityEvaluator));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testKernelInterpolation));
     suite->add(QUANTLIB_TEST_CASE(
                               &InterpolationTest::testKernelInterpolation2D));
@@ -1718,6 +1972,8 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBicubicUpdate));
     suite->add(QUANTLIB_TEST_CASE(
                             &InterpolationTest::testRichardsonExtrapolation));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testGridLocation));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testMultipleValues));
 
     return suite;
 }
@@ -43,11 +43,14 @@ class InterpolationTest {
     static void testBackwardFlat();
     static void testForwardFlat();
     static void testSabrInterpolation();
+    static void testSabrVolatilityEvaluator();
     static void testKernelInterpolation();
     static void testKernelInterpolation2D();
     static void testBicubicDerivatives();
     static void testBicubicUpdate();
     static void testRichardsonExtrapolation();
+    static void testGridLocation();
+    static void testMultipleValues();
 
     static boost::unit_test_framework::test_suite* suite();
 };
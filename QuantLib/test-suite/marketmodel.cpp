@@ -37,6 +37,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/callability/upperboundengine.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmnormaldriftcalculator.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerconstrained.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
@@ -4750,6 +4751,166 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testMultiplePathDriftCalculator() {
+
+    // Test that the drifts computed for several paths at once
+    // reproduce the single-path ones
+
+    BOOST_MESSAGE("Testing drift calculation on multiple paths...");
+
+    setup();
+
+    Real tolerance = 1.0e-16;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Real> rateTaus = evolution.rateTaus();
+    std::vector<Size> numeraires = moneyMarketPlusMeasure(evolution,
+                                                          measureOffset_);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfRates = todaysForwards.size();
+    Size numberOfSteps = evolutionTimes.size();
+
+    // each path shifts the forwards by a different amount
+    Size paths = 7;
+    Matrix forwards(numberOfRates, paths);
+    std::vector<std::vector<Rate> > pathForwards(paths,
+                                          std::vector<Rate>(numberOfRates));
+    for (Size p=0; p<paths; ++p) {
+        for (Size i=0; i<numberOfRates; ++i) {
+            pathForwards[p][i] = todaysForwards[i] + 0.001*p*(i%3);
+            forwards[i][p] = pathForwards[p][i];
+        }
+    }
+
+    Size factors[] = { 3, numberOfRates };
+    std::vector<Real> drifts(numberOfRates), normalDrifts(numberOfRates);
+    for (Size k=0; k<LENGTH(factors); ++k) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, factors[k],
+                            ExponentialCorrelationAbcdVolatility);
+        std::vector<Rate> displacements = marketModel->displacements();
+        for (Size j=0; j<numberOfSteps; ++j) {
+            const Matrix& A = marketModel->pseudoRoot(j);
+            for (Size h=alive[j]; h<numeraires.size(); ++h) {
+                LMMDriftCalculator calculator(A, displacements, rateTaus,
+                                              numeraires[h], alive[j]);
+                LMMNormalDriftCalculator normalCalculator(A, rateTaus,
+                                                          numeraires[h],
+                                                          alive[j]);
+                Matrix multipleDrifts(numberOfRates, paths, 0.0),
+                       multipleNormalDrifts(numberOfRates, paths, 0.0);
+                calculator.compute(forwards, multipleDrifts);
+                normalCalculator.compute(forwards, multipleNormalDrifts);
+                for (Size p=0; p<paths; ++p) {
+                    calculator.compute(pathForwards[p], drifts);
+                    normalCalculator.compute(pathForwards[p], normalDrifts);
+                    for (Size i=alive[j]; i<numberOfRates; ++i) {
+                        Real error =
+                            std::fabs(multipleDrifts[i][p]-drifts[i]);
+                        Real normalError =
+                            std::fabs(multipleNormalDrifts[i][p]
+                                      -normalDrifts[i]);
+                        if (error>tolerance || normalError>tolerance)
+                            BOOST_ERROR(factors[k] << " factors, "
+                                << io::ordinal(j+1) << " step, "
+                                << io::ordinal(h+1) << " numeraire, "
+                                << io::ordinal(p+1) << " path, "
+                                << io::ordinal(i+1) << " drift:"
+                                << "\n    single path:   " << drifts[i]
+                                << "\n    multiple paths:"
+                                << multipleDrifts[i][p]
+                                << "\n    single path (normal):   "
+                                << normalDrifts[i]
+                                << "\n    multiple paths (normal):"
+                                << multipleNormalDrifts[i][p]
+                                << "\n    tolerance:     " << tolerance);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testMultiplePathEvolution() {
+
+    // Test that the paths evolved together by the predictor-corrector
+    // evolver reproduce the ones evolved one at a time
+
+    BOOST_MESSAGE("Testing predictor-corrector evolution "
+                  "of multiple paths...");
+
+    setup();
+
+    Real tolerance = 1.0e-14;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Size> numeraires = moneyMarketPlusMeasure(evolution,
+                                                          measureOffset_);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfSteps = evolutionTimes.size();
+
+    Size paths = 9;
+    Size factors[] = { 3, todaysForwards.size() };
+    for (Size k=0; k<LENGTH(factors); ++k) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, factors[k],
+                            ExponentialCorrelationAbcdVolatility);
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        LogNormalFwdRatePc single(marketModel, generatorFactory, numeraires);
+        LogNormalFwdRatePc multiple(marketModel, generatorFactory,
+                                    numeraires);
+
+        // the single paths are stored step by step
+        std::vector<std::vector<std::vector<Rate> > > singleForwards(
+                          numberOfSteps,
+                          std::vector<std::vector<Rate> >(paths));
+        std::vector<Real> singleWeights(paths);
+        for (Size p=0; p<paths; ++p) {
+            singleWeights[p] = single.startNewPath();
+            for (Size j=0; j<numberOfSteps; ++j) {
+                singleWeights[p] *= single.advanceStep();
+                singleForwards[j][p] = single.currentState().forwardRates();
+            }
+        }
+
+        std::vector<Real> weights, stepWeights;
+        multiple.startNewPaths(paths, weights);
+        for (Size j=0; j<numberOfSteps; ++j) {
+            multiple.advanceSteps(stepWeights);
+            for (Size p=0; p<paths; ++p)
+                weights[p] *= stepWeights[p];
+            const Matrix& forwards = multiple.currentForwards();
+            for (Size p=0; p<paths; ++p) {
+                for (Size i=alive[j]; i<todaysForwards.size(); ++i) {
+                    Real error =
+                        std::fabs(forwards[i][p]-singleForwards[j][p][i]);
+                    if (error>tolerance)
+                        BOOST_ERROR(factors[k] << " factors, "
+                            << io::ordinal(j+1) << " step, "
+                            << io::ordinal(p+1) << " path, "
+                            << io::ordinal(i+1) << " forward:"
+                            << "\n    single path:    "
+                            << singleForwards[j][p][i]
+                            << "\n    multiple paths: " << forwards[i][p]
+                            << "\n    tolerance:      " << tolerance);
+                }
+            }
+        }
+
+        for (Size p=0; p<paths; ++p) {
+            if (weights[p] != singleWeights[p])
+                BOOST_ERROR(factors[k] << " factors, "
+                            << io::ordinal(p+1) << " path:"
+                            << "\n    single-path weight:    "
+                            << singleWeights[p]
+                            << "\n    multiple-path weight:  "
+                            << weights[p]);
+        }
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4878,6 +5039,157 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+void MarketModelTest::testParallelAccountingEngines() {
+
+    BOOST_MESSAGE("Testing parallel simulation in market-model engines...");
+
+    setup();
+
+    const Real tolerance = 1.0e-12;
+
+    Real fixedRate = 0.04;
+    MultiStepSwap payerSwap(rateTimes, accruals, accruals, paymentTimes,
+                            fixedRate, true);
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    CallSpecifiedMultiProduct callableProduct =
+        CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+                                  ExerciseAdapter(nullRebate));
+
+    MultiProductComposite allProducts;
+    allProducts.add(payerSwap);
+    allProducts.add(callableProduct);
+    allProducts.finalize();
+
+    EvolutionDescription evolution = allProducts.evolution();
+    std::vector<Size> numeraires = makeMeasure(allProducts, MoneyMarketPlus);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+
+    // accounting engine; the second batch of paths checks that
+    // the engine moves forward along the sequence
+    Size paths = 3000;
+    AccountingEngine serialEngine(
+        makeMarketModelEvolver(marketModel, numeraires, generatorFactory, Pc),
+        allProducts, initialNumeraireValue);
+    AccountingEngine parallelEngine(
+        makeMarketModelEvolver(marketModel, numeraires, generatorFactory, Pc),
+        allProducts, initialNumeraireValue);
+    parallelEngine.enableParallelSampling(0, 256);
+
+    for (Size batch=0; batch<2; ++batch) {
+        SequenceStatisticsInc serialStats(allProducts.numberOfProducts());
+        SequenceStatisticsInc parallelStats(allProducts.numberOfProducts());
+        serialEngine.multiplePathValues(serialStats, paths);
+        parallelEngine.multiplePathValues(parallelStats, paths);
+
+        std::vector<Real> serial = serialStats.mean();
+        std::vector<Real> parallel = parallelStats.mean();
+        for (Size i=0; i<serial.size(); ++i) {
+            if (std::fabs(serial[i]-parallel[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial results "
+                            "with accounting engine"
+                            << "\n    batch:    " << batch
+                            << "\n    product:  " << i
+                            << std::setprecision(12)
+                            << "\n    serial:   " << serial[i]
+                            << "\n    parallel: " << parallel[i]);
+        }
+    }
+
+    // pathwise accounting engine
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+                                           paymentTimes, todaysForwards);
+    std::vector<Size> mmNumeraires =
+        moneyMarketMeasure(caplets.evolution());
+    boost::shared_ptr<MarketModel> capletModel =
+        makeMarketModel(true, caplets.evolution(), 2,
+                        ExponentialCorrelationAbcdVolatility);
+    Real capletNumeraireValue = todaysDiscounts[mmNumeraires.front()];
+    PathwiseAccountingEngine serialPathwise(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(capletModel, generatorFactory,
+                                      mmNumeraires)),
+        caplets, capletModel, capletNumeraireValue);
+    PathwiseAccountingEngine parallelPathwise(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(capletModel, generatorFactory,
+                                      mmNumeraires)),
+        caplets, capletModel, capletNumeraireValue);
+    parallelPathwise.enableParallelSampling(0, 256);
+
+    Size size = caplets.numberOfProducts()*(todaysForwards.size()+1);
+    SequenceStatisticsInc serialPathwiseStats(size);
+    SequenceStatisticsInc parallelPathwiseStats(size);
+    serialPathwise.multiplePathValues(serialPathwiseStats, paths);
+    parallelPathwise.multiplePathValues(parallelPathwiseStats, paths);
+
+    std::vector<Real> serialDeltas = serialPathwiseStats.mean();
+    std::vector<Real> parallelDeltas = parallelPathwiseStats.mean();
+    for (Size i=0; i<size; ++i) {
+        if (std::fabs(serialDeltas[i]-parallelDeltas[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial results "
+                        "with pathwise accounting engine"
+                        << "\n    value:    " << i
+                        << std::setprecision(12)
+                        << "\n    serial:   " << serialDeltas[i]
+                        << "\n    parallel: " << parallelDeltas[i]);
+    }
+
+    // upper-bound engine
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+    std::vector<boost::shared_ptr<MarketModelEvolver> > serialInner,
+                                                        parallelInner;
+    for (Size s=0; s<isExerciseTime.size(); ++s) {
+        if (isExerciseTime[s]) {
+            SobolBrownianGeneratorFactory innerFactory(
+                                  SobolBrownianGenerator::Diagonal, seed_+s);
+            serialInner.push_back(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       innerFactory, Pc, s));
+            parallelInner.push_back(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       innerFactory, Pc, s));
+        }
+    }
+
+    SobolBrownianGeneratorFactory outerFactory(
+                              SobolBrownianGenerator::Diagonal, seed_+142);
+    UpperBoundEngine serialUpper(
+        makeMarketModelEvolver(marketModel, numeraires, outerFactory, Pc),
+        serialInner, receiverSwap, nullRebate, receiverSwap, nullRebate,
+        naifStrategy, initialNumeraireValue);
+    UpperBoundEngine parallelUpper(
+        makeMarketModelEvolver(marketModel, numeraires, outerFactory, Pc),
+        parallelInner, receiverSwap, nullRebate, receiverSwap, nullRebate,
+        naifStrategy, initialNumeraireValue);
+    parallelUpper.enableParallelSampling(0, 8);
+
+    Statistics serialUpperStats, parallelUpperStats;
+    serialUpper.multiplePathValues(serialUpperStats, 31, 32);
+    parallelUpper.multiplePathValues(parallelUpperStats, 31, 32);
+    if (std::fabs(serialUpperStats.mean()-parallelUpperStats.mean())
+                                                              > tolerance)
+        BOOST_ERROR("failed to reproduce serial results "
+                    "with upper-bound engine"
+                    << std::setprecision(12)
+                    << "\n    serial:   " << serialUpperStats.mean()
+                    << "\n    parallel: " << parallelUpperStats.mean());
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4908,10 +5220,17 @@ test_suite* MarketModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &MarketModelTest::testMultiplePathDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &MarketModelTest::testMultiplePathEvolution));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                       &MarketModelTest::testParallelAccountingEngines));
+
     return suite;
 }
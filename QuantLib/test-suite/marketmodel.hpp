@@ -47,9 +47,12 @@ class MarketModelTest {
     static void testAbcdVolatilityCompare();
     static void testAbcdVolatilityFit();
     static void testDriftCalculator();
+    static void testMultiplePathDriftCalculator();
+    static void testMultiplePathEvolution();
     static void testIsInSubset();
 	static void testAbcdDegenerateCases();
 	static void testCovariance();
+    static void testParallelAccountingEngines();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -24,6 +24,7 @@
 #include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
@@ -469,6 +470,124 @@ void MatricesTest::testOrthogonalProjection() {
 }
 
 
+namespace {
+
+    Matrix randomMatrix(Size rows, Size columns,
+                        MersenneTwisterUniformRng& rng) {
+        Matrix m(rows, columns);
+        for (Matrix::iterator i=m.begin(); i!=m.end(); ++i)
+            *i = rng.next().value - 0.5;
+        return m;
+    }
+
+    Matrix identity(Size n) {
+        Matrix m(n, n, 0.0);
+        for (Size i=0; i<n; ++i)
+            m[i][i] = 1.0;
+        return m;
+    }
+
+}
+
+void MatricesTest::testLargeMatrices() {
+
+    BOOST_MESSAGE("Testing linear algebra on large matrices...");
+
+    MersenneTwisterUniformRng rng(42);
+    Real tol = 1.0e-10;
+
+    // products and transposition
+    Matrix A = randomMatrix(130, 70, rng), B = randomMatrix(70, 90, rng);
+    Matrix C = A*B;
+    for (Size i=0; i<C.rows(); ++i) {
+        for (Size j=0; j<C.columns(); ++j) {
+            Real expected = std::inner_product(A.row_begin(i),
+                                               A.row_end(i),
+                                               B.column_begin(j), 0.0);
+            if (std::fabs(C[i][j]-expected) > 1.0e-13)
+                BOOST_FAIL("wrong matrix product:"
+                           << "\n    row:        " << i
+                           << "\n    column:     " << j
+                           << std::setprecision(16)
+                           << "\n    calculated: " << C[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    Matrix At = transpose(A);
+    for (Size i=0; i<A.rows(); ++i)
+        for (Size j=0; j<A.columns(); ++j)
+            if (At[j][i] != A[i][j])
+                BOOST_FAIL("wrong transposed matrix");
+
+    // a positive-definite correlation matrix...
+    Size n = 100;
+    Matrix S(n, n);
+    for (Size i=0; i<n; ++i)
+        for (Size j=0; j<n; ++j)
+            S[i][j] = 0.2 + 0.8*std::exp(-0.05*std::fabs(Real(i)-Real(j)));
+    Matrix unit = identity(n);
+
+    // ...its inverse...
+    Matrix invS = inverse(S);
+    if (norm(invS*S - unit) > tol)
+        BOOST_FAIL("inverse(S)*S does not recover unit matrix (norm = "
+                   << norm(invS*S - unit) << ")");
+
+    // ...its Cholesky decomposition...
+    Matrix L = CholeskyDecomposition(S);
+    for (Size i=0; i<n; ++i)
+        for (Size j=i+1; j<n; ++j)
+            if (L[i][j] != 0.0)
+                BOOST_FAIL("Cholesky factor not lower triangular");
+    if (norm(L*transpose(L) - S) > tol)
+        BOOST_FAIL("L*L^T does not recover S (norm = "
+                   << norm(L*transpose(L) - S) << ")");
+
+    // ...its eigenvalues and eigenvectors...
+    SymmetricSchurDecomposition dec(S);
+    const Array& eigenValues = dec.eigenvalues();
+    const Matrix& eigenVectors = dec.eigenvectors();
+    for (Size i=0; i<n; ++i) {
+        Array v(eigenVectors.column_begin(i), eigenVectors.column_end(i));
+        if (norm(S*v - eigenValues[i]*v) > tol)
+            BOOST_FAIL("eigenvector definition not satisfied");
+        if (i > 0 && eigenValues[i] > eigenValues[i-1])
+            BOOST_FAIL("eigenvalues not ordered: " << eigenValues);
+        if (v[0] < 0.0)
+            BOOST_FAIL("eigenvector not normalized in sign");
+    }
+    if (norm(transpose(eigenVectors)*eigenVectors - unit) > tol)
+        BOOST_FAIL("eigenvectors not orthonormal");
+
+    // ...and its square root.
+    Matrix sqrtS = pseudoSqrt(S, SalvagingAlgorithm::None);
+    if (norm(sqrtS*transpose(sqrtS) - S) > tol)
+        BOOST_FAIL("matrix square root calculation failed (norm = "
+                   << norm(sqrtS*transpose(sqrtS) - S) << ")");
+
+    // singular values of rectangular matrices
+    Matrix testMatrices[] = { A, At };
+    for (Size k=0; k<LENGTH(testMatrices); ++k) {
+        const Matrix& M = testMatrices[k];
+        SVD svd(M);
+        Matrix U = svd.U(), V = svd.V();
+        Size r = std::min(M.rows(), M.columns());
+        if (norm(transpose(U)*U - identity(r)) > tol)
+            BOOST_FAIL("U not orthogonal");
+        if (norm(transpose(V)*V - identity(r)) > tol)
+            BOOST_FAIL("V not orthogonal");
+        if (norm(U*svd.S()*transpose(V) - M) > tol)
+            BOOST_FAIL("product does not recover original matrix "
+                       "(norm of U*S*V^T-M = "
+                       << norm(U*svd.S()*transpose(V) - M) << ")");
+        const Array& s = svd.singularValues();
+        for (Size i=1; i<s.size(); ++i)
+            if (s[i] > s[i-1])
+                BOOST_FAIL("singular values not ordered: " << s);
+    }
+}
+
 
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
@@ -483,6 +602,7 @@ test_suite* MatricesTest::suite() {
     #if !defined(QL_NO_UBLAS_SUPPORT)
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testDeterminant));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testLargeMatrices));
     #endif
     return suite;
 }
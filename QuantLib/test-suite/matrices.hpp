@@ -37,6 +37,7 @@ class MatricesTest {
     static void testInverse();
     static void testDeterminant();
     static void testOrthogonalProjection();
+    static void testLargeMatrices();
     static boost::unit_test_framework::test_suite* suite();
 };
 
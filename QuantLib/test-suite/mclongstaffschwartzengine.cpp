@@ -294,6 +294,74 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testParallelCalibration() {
+
+    BOOST_MESSAGE("Testing parallel Longstaff-Schwartz calibration...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<YieldTermStructure> riskFreeTS =
+        flatRate(today, 0.06, dayCounter);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(36.0))),
+            Handle<YieldTermStructure>(flatRate(today, 0.0, dayCounter)),
+            Handle<YieldTermStructure>(riskFreeTS),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.2, dayCounter))));
+
+    const TimeGrid grid(1.0, 50);
+    boost::shared_ptr<EarlyExercisePathPricer<Path> > exercisePricer(
+        new AmericanPathPricer(boost::shared_ptr<Payoff>(
+                                   new PlainVanillaPayoff(Option::Put, 40.0)),
+                               3, LsmBasisSystem::Monomial));
+
+    LongstaffSchwartzPathPricer<Path> serial(grid, exercisePricer,
+                                             riskFreeTS);
+    LongstaffSchwartzPathPricer<Path> parallel(grid, exercisePricer,
+                                               riskFreeTS);
+    parallel.enableParallelCalibration();
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    typedef PathGenerator<rsg_type>::sample_type sample_type;
+
+    const Size calibrationSamples = 10000;
+    PathGenerator<rsg_type> calibrationGenerator(
+        process, grid, PseudoRandom::make_sequence_generator(
+                                                    grid.size()-1, 42), false);
+    for (Size i=0; i<calibrationSamples; ++i) {
+        const sample_type& sample = calibrationGenerator.next();
+        serial(sample.value);
+        parallel(sample.value);
+    }
+    serial.calibrate();
+    parallel.calibrate();
+
+    const Size samples = 5000;
+    PathGenerator<rsg_type> generator(
+        process, grid, PseudoRandom::make_sequence_generator(
+                                                    grid.size()-1, 43), false);
+    Real serialPrice = 0.0, parallelPrice = 0.0;
+    for (Size i=0; i<samples; ++i) {
+        const sample_type& sample = generator.next();
+        serialPrice += serial(sample.value);
+        parallelPrice += parallel(sample.value);
+    }
+    serialPrice /= samples;
+    parallelPrice /= samples;
+
+    const Real tolerance = 1.0e-8;
+    if (std::fabs(serialPrice - parallelPrice) > tolerance)
+        BOOST_ERROR("failed to reproduce serial calibration"
+                    << std::setprecision(12)
+                    << "\n    serial:     " << serialPrice
+                    << "\n    parallel:   " << parallelPrice
+                    << "\n    tolerance:  " << tolerance);
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -301,6 +369,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testParallelCalibration));
     return suite;
 }
 
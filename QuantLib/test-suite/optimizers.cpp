@@ -523,11 +523,50 @@ void OptimizersTest::testDifferentialEvolution() {
     }
 }
 
+namespace {
+
+    // log(x) = log(2), only defined for positive x
+    class LogCostFunction : public CostFunction {
+      public:
+        Disposable<Array> values(const Array& x) const {
+            Array retVal(1, std::log(x[0]) - std::log(2.0));
+            return retVal;
+        }
+        Real value(const Array& x) const {
+            Real y = values(x)[0];
+            return y*y;
+        }
+    };
+
+}
+
+void OptimizersTest::testLevenbergMarquardtConstraint() {
+    BOOST_MESSAGE("Testing Levenberg-Marquardt jacobian "
+                  "close to a constraint...");
+
+    LogCostFunction costFunction;
+    PositiveConstraint constraint;
+    // closer to the constraint than the finite-difference epsilon
+    Array initialValue(1, 0.5*costFunction.finiteDifferenceEpsilon());
+    Problem problem(costFunction, constraint, initialValue);
+    LevenbergMarquardt lm(1.0e-8, 1.0e-8, 1.0e-8, true);
+    lm.minimize(problem, EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real calculated = problem.currentValue()[0];
+    Real expected = 2.0;
+    if (std::fabs(calculated - expected) > 1.0e-6)
+        BOOST_ERROR("failed to minimize starting close to the constraint:"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 test_suite* OptimizersTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Optimizers tests");
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::test));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::nestedOptimizationTest));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testDifferentialEvolution));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &OptimizersTest::testLevenbergMarquardtConstraint));
     return suite;
 }
 
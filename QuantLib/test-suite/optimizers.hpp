@@ -30,6 +30,7 @@ class OptimizersTest {
     static void test();
     static void nestedOptimizationTest();
     static void testDifferentialEvolution();
+    static void testLevenbergMarquardtConstraint();
     static boost::unit_test_framework::test_suite* suite();
 };
 
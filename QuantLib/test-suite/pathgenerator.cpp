@@ -20,7 +20,10 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/batchpathgenerator.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
@@ -138,6 +141,73 @@ namespace {
         }
     }
 
+    void checkBatch(const Matrix& calculated, const Path& expected,
+                    Size path, const std::string& tag) {
+        Real tolerance = 1.0e-10;
+        for (Size i=0; i<expected.length(); i++) {
+            Real error = std::fabs(calculated[i][path]-expected[i]);
+            if (error > tolerance*std::max(1.0, std::fabs(expected[i]))) {
+                BOOST_FAIL("using " << tag << " process:\n"
+                           << io::ordinal(path+1) << " path, "
+                           << io::ordinal(i+1) << " point:\n"
+                           << std::setprecision(13)
+                           << "    batch:      " << calculated[i][path] << "\n"
+                           << "    single:     " << expected[i] << "\n"
+                           << "    error:      " << error << "\n"
+                           << "    tolerance:  " << tolerance);
+            }
+        }
+    }
+
+    void testBatch(const boost::shared_ptr<StochasticProcess>& process,
+                   const std::string& tag, bool brownianBridge = false) {
+        typedef PseudoRandom::rsg_type rsg_type;
+
+        BigNatural seed = 42;
+        TimeGrid grid(10.0, 12);
+        Size factors = process->factors();
+        Size assets = process->size();
+        Size paths = 50;
+
+        rsg_type rsg = PseudoRandom::make_sequence_generator(12*factors,
+                                                             seed);
+        BatchPathGenerator<rsg_type> batch(process, grid, rsg,
+                                           brownianBridge);
+        boost::shared_ptr<StochasticProcess1D> process1D =
+            boost::dynamic_pointer_cast<StochasticProcess1D>(process);
+        boost::shared_ptr<PathGenerator<rsg_type> > single;
+        boost::shared_ptr<MultiPathGenerator<rsg_type> > multi;
+        if (process1D)
+            single = boost::shared_ptr<PathGenerator<rsg_type> >(
+                new PathGenerator<rsg_type>(process1D, grid, rsg,
+                                            brownianBridge));
+        else
+            multi = boost::shared_ptr<MultiPathGenerator<rsg_type> >(
+                new MultiPathGenerator<rsg_type>(process, grid, rsg,
+                                                 brownianBridge));
+
+        // two blocks, so that the buffers are reused
+        for (Size k=0; k<2; k++) {
+            std::vector<Matrix> values = batch.next(paths);
+            std::vector<Matrix> antithetic = batch.antithetic();
+            for (Size j=0; j<paths; j++) {
+                if (single) {
+                    checkBatch(values[0], single->next().value, j, tag);
+                    checkBatch(antithetic[0], single->antithetic().value,
+                               j, tag + " (antithetic)");
+                } else {
+                    MultiPath p = multi->next().value;
+                    MultiPath a = multi->antithetic().value;
+                    for (Size i=0; i<assets; i++) {
+                        checkBatch(values[i], p[i], j, tag);
+                        checkBatch(antithetic[i], a[i], j,
+                                   tag + " (antithetic)");
+                    }
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +360,60 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testBatchPathGenerator() {
+
+    BOOST_MESSAGE("Testing batch path generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    boost::shared_ptr<StochasticProcess> bsProcess(
+                                  new BlackScholesMertonProcess(x0,q,r,sigma));
+    testBatch(bsProcess, "Black-Scholes");
+    testBatch(bsProcess, "Black-Scholes (Brownian bridge)", true);
+
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                                          new HullWhiteProcess(r, 0.1, 0.01)),
+              "Hull-White");
+
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                                  new SquareRootProcess(0.1, 0.1, 0.20, 10.0)),
+              "square-root");
+
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponentialMartingale
+    };
+    std::string names[] = {
+        "Heston (partial truncation)",
+        "Heston (full truncation)",
+        "Heston (reflection)",
+        "Heston (QE martingale)"
+    };
+    for (Size i=0; i<LENGTH(schemes); i++) {
+        // a high vol of vol makes sure that the variance hits zero
+        testBatch(boost::shared_ptr<StochasticProcess>(
+                         new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.8,
+                                           -0.7, schemes[i])),
+                  names[i]);
+    }
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBatchPathGenerator));
     return suite;
 }
 
@@ -681,6 +681,135 @@ void PiecewiseYieldCurveTest::testObservability() {
 }
 
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_MESSAGE("Testing bootstrap after a change in a single quote...");
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear> curve_type;
+    boost::shared_ptr<curve_type> curve(
+          new curve_type(vars.settlement, vars.instruments, Actual360()));
+    curve->nodes();
+
+    Size n = vars.deposits+vars.swaps;
+    Size changed[] = { n-1, n/2, 0 };
+
+    for (Size k=0; k<LENGTH(changed); k++) {
+        std::vector<Real> previous = curve->data();
+
+        Size j = changed[k];
+        vars.rates[j]->setValue(vars.rates[j]->value()+0.0010);
+        std::vector<Real> calculated = curve->data();
+
+        if (curve->bootstrappedPillars() != n-j)
+            BOOST_FAIL(curve->bootstrappedPillars() << " pillars solved "
+                       "after change in " << io::ordinal(j+1) << " quote\n"
+                       "    expected: " << n-j);
+        if (curve->bootstrapTime() < 0.0)
+            BOOST_FAIL("negative bootstrap time: "
+                       << curve->bootstrapTime());
+
+        // pillars before the changed one must be left alone...
+        for (Size i=0; i<=j; i++) {
+            if (calculated[i] != previous[i])
+                BOOST_FAIL(io::ordinal(i) << " pillar changed after "
+                           "change in " << io::ordinal(j+1) << " quote:\n"
+                           << std::setprecision(16)
+                           << "    before: " << previous[i] << "\n"
+                           << "    after:  " << calculated[i]);
+        }
+
+        // ...and the result must be the same as a full bootstrap
+        curve_type fullCurve(vars.settlement, vars.instruments, Actual360());
+        std::vector<Real> expected = fullCurve.data();
+        for (Size i=0; i<expected.size(); i++) {
+            if (std::fabs(calculated[i]-expected[i]) > 1.0e-10)
+                BOOST_FAIL(io::ordinal(i) << " pillar after change in "
+                           << io::ordinal(j+1) << " quote:\n"
+                           << std::setprecision(16)
+                           << "    incremental: " << calculated[i] << "\n"
+                           << "    full:        " << expected[i]);
+        }
+    }
+
+    // changes in other market data must cause a full bootstrap
+    boost::shared_ptr<SimpleQuote> discountRate(new SimpleQuote(0.03));
+    Handle<YieldTermStructure> discountCurve(
+                     flatRate(vars.settlement, discountRate, Actual360()));
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+    std::vector<boost::shared_ptr<RateHelper> > helpers(
+                                  vars.instruments.begin(),
+                                  vars.instruments.begin()+vars.deposits);
+    for (Size i=0; i<vars.swaps; i++) {
+        Handle<Quote> r(vars.rates[i+vars.deposits]);
+        helpers.push_back(boost::shared_ptr<RateHelper>(new
+            SwapRateHelper(r, swapData[i].n*swapData[i].units,
+                           vars.calendar, vars.fixedLegFrequency,
+                           vars.fixedLegConvention, vars.fixedLegDayCounter,
+                           euribor6m, Handle<Quote>(), 0*Days,
+                           discountCurve)));
+    }
+    curve_type exogenousCurve(vars.settlement, helpers, Actual360());
+    exogenousCurve.nodes();
+
+    discountRate->setValue(0.04);
+    std::vector<Real> calculated = exogenousCurve.data();
+    curve_type fullCurve(vars.settlement, helpers, Actual360());
+    std::vector<Real> expected = fullCurve.data();
+    for (Size i=0; i<expected.size(); i++) {
+        if (std::fabs(calculated[i]-expected[i]) > 1.0e-10)
+            BOOST_FAIL(io::ordinal(i) << " pillar after change in "
+                       "discount curve:\n"
+                       << std::setprecision(16)
+                       << "    incremental: " << calculated[i] << "\n"
+                       << "    full:        " << expected[i]);
+    }
+
+    // so must changes collapsed by a batch update...
+    {
+        ObservableBatchUpdate batch;
+        Real r = vars.rates[0]->value();
+        vars.rates[0]->setValue(r+0.0010);
+        vars.rates[0]->setValue(r);
+        discountRate->setValue(0.035);
+    }
+    calculated = exogenousCurve.data();
+    expected = curve_type(vars.settlement, helpers, Actual360()).data();
+    for (Size i=0; i<expected.size(); i++) {
+        if (std::fabs(calculated[i]-expected[i]) > 1.0e-10)
+            BOOST_FAIL(io::ordinal(i) << " pillar after batch update:\n"
+                       << std::setprecision(16)
+                       << "    incremental: " << calculated[i] << "\n"
+                       << "    full:        " << expected[i]);
+    }
+    if (exogenousCurve.bootstrappedPillars() != n)
+        BOOST_FAIL(exogenousCurve.bootstrappedPillars() << " pillars "
+                   "solved after batch update\n"
+                   "    expected: " << n);
+
+    // ...and changes in curve-level data such as jumps
+    boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(1.0));
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1, vars.settlement+180);
+    curve_type jumpCurve(vars.settlement, vars.instruments, Actual360(),
+                         jumps, jumpDates);
+    jumpCurve.nodes();
+
+    jump->setValue(0.99);
+    calculated = jumpCurve.data();
+    expected = curve_type(vars.settlement, vars.instruments, Actual360(),
+                          jumps, jumpDates).data();
+    for (Size i=0; i<expected.size(); i++) {
+        if (std::fabs(calculated[i]-expected[i]) > 1.0e-10)
+            BOOST_FAIL(io::ordinal(i) << " pillar after change in jump:\n"
+                       << std::setprecision(16)
+                       << "    incremental: " << calculated[i] << "\n"
+                       << "    full:        " << expected[i]);
+    }
+}
+
+
 void PiecewiseYieldCurveTest::testLiborFixing() {
 
     BOOST_MESSAGE(
@@ -947,6 +1076,8 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &PiecewiseYieldCurveTest::testIncrementalBootstrap));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testJpyLibor));
@@ -43,6 +43,7 @@ class PiecewiseYieldCurveTest {
     static void testLocalBootstrapConsistency();
 
     static void testObservability();
+    static void testIncrementalBootstrap();
     static void testLiborFixing();
 
     static void testJpyLibor();
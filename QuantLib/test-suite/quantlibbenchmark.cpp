@@ -70,15 +70,47 @@
 
   This benchmark is derived from quantlibtestsuite.cpp. Please see the
   copyrights therein.
+
+ Besides the test cases above, the suite times a number of kernels
+ (curve bootstrap, swap NPV, Black formula, analytic Heston, finite-
+ difference American option, LMM path generation, Sobol sequences)
+ defined in benchmarkkernels.cpp. Each kernel is run a few times to
+ warm up and then repeatedly timed; the mean, standard deviation,
+ minimum, median and maximum wall-clock time per run are reported,
+ together with the throughput in operations per second.
+
+ The following options are recognized (with recent Boost versions,
+ they must be given after a -- separator):
+
+  --json=file         writes the results to the given file in JSON
+                      format, one result per line;
+  --baseline=file     compares the median times with those stored in
+                      a file written by --json and reports an error
+                      for each regression of a kernel (the test
+                      cases, timed once each in processor time, are
+                      listed but not checked);
+  --tolerance=x       relative slowdown accepted before a regression
+                      is reported (default: 0.10);
+  --repetitions=n     number of timed runs per kernel (default: 10);
+  --warmup=n          number of untimed runs per kernel (default: 2);
+  --kernels-only      skips the test cases and only times the kernels.
 */
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/settings.hpp>
+#include <ql/time/date.hpp>
+#include <ql/math/statistics/generalstatistics.hpp>
+#include <ql/utilities/parallel.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
 #include <list>
+#include <map>
 #include <string>
 
 /* PAPI code
@@ -104,6 +136,7 @@
 #endif
 #include "utilities.hpp"
 
+#include "benchmarkkernels.hpp"
 #include "americanoption.hpp"
 #include "asianoptions.hpp"
 #include "barrieroption.hpp"
@@ -120,6 +153,7 @@
 #include "marketmodel_smm.hpp"
 #include "marketmodel_cms.hpp"
 #include "lowdiscrepancysequences.hpp"
+#include "matrices.hpp"
 #include "quantooption.hpp"
 #include "riskstats.hpp"
 #include "shortratemodels.hpp"
@@ -156,6 +190,27 @@ namespace {
     std::list<double> runTimes;
     std::list<Benchmark> bm;
 
+    struct Options {
+        Options()
+        : tolerance(0.10), repetitions(10), warmup(2), kernelsOnly(false) {}
+        std::string jsonFile, baselineFile;
+        double tolerance;
+        QuantLib::Size repetitions, warmup;
+        bool kernelsOnly;
+    };
+
+    Options options;
+
+    struct Measurement {
+        std::string name, kind;
+        QuantLib::Size runs;
+        double mean, standardDeviation, min, median, max;
+        double throughput;  // mflops for test cases, operations/sec
+                            // for kernels
+    };
+
+    std::list<Measurement> measurements;
+
     /* PAPI code
     float real_time, proc_time, mflops;
     long_long lflop, flop=0;
@@ -180,6 +235,198 @@ namespace {
         */
     }
 
+    void parseOptions(int argc, char** argv) {
+        for (int i=1; i<argc; ++i) {
+            std::string arg(argv[i]);
+            std::string::size_type eq = arg.find('=');
+            std::string key = arg.substr(0, eq);
+            std::string value =
+                (eq == std::string::npos) ? "" : arg.substr(eq+1);
+            if (key == "--json")
+                options.jsonFile = value;
+            else if (key == "--baseline")
+                options.baselineFile = value;
+            else if (key == "--tolerance")
+                options.tolerance = std::atof(value.c_str());
+            else if (key == "--repetitions")
+                options.repetitions = std::max(std::atoi(value.c_str()), 1);
+            else if (key == "--warmup")
+                options.warmup = std::max(std::atoi(value.c_str()), 0);
+            else if (key == "--kernels-only")
+                options.kernelsOnly = true;
+            // anything else is left to Boost.Test
+        }
+    }
+
+    void runKernels() {
+        using namespace QuantLib;
+
+        SavedSettings backup;
+        Settings::instance().evaluationDate() = Date(15, May, 2013);
+
+        std::vector<boost::shared_ptr<BenchmarkKernel> > kernels =
+            benchmarkKernels();
+
+        for (Size i=0; i<kernels.size(); ++i) {
+            BenchmarkKernel& kernel = *kernels[i];
+            for (Size j=0; j<options.warmup; ++j)
+                kernel.run();
+
+            // wall-clock time, since kernels might run in parallel
+            GeneralStatistics times;
+            for (Size j=0; j<options.repetitions; ++j) {
+                Real start = wallClockTime();
+                kernel.run();
+                times.add(wallClockTime() - start);
+            }
+
+            Measurement m;
+            m.name = kernel.name();
+            m.kind = "kernel";
+            m.runs = times.samples();
+            m.mean = times.mean();
+            m.standardDeviation =
+                m.runs > 1 ? times.standardDeviation() : 0.0;
+            m.min = times.min();
+            m.median = times.percentile(0.5);
+            m.max = times.max();
+            // a null median means the run was shorter than the
+            // timer resolution
+            m.throughput = m.median > 0.0 ?
+                kernel.operations()/m.median : 0.0;
+            measurements.push_back(m);
+        }
+    }
+
+    void collectTestCaseTimes() {
+        std::list<double>::const_iterator iterT = runTimes.begin();
+        std::list<Benchmark>::const_iterator iterBM = bm.begin();
+        for (; iterT != runTimes.end(); ++iterT, ++iterBM) {
+            Measurement m;
+            m.name = iterBM->getName();
+            m.kind = "test";
+            m.runs = 1;
+            m.mean = m.min = m.median = m.max = *iterT;
+            m.standardDeviation = 0.0;
+            m.throughput = *iterT > 0.0 ? iterBM->getMflop()/(*iterT) : 0.0;
+            measurements.push_back(m);
+        }
+    }
+
+    void printKernelResults() {
+        std::cout << std::endl
+                  << std::string(78,'-') << std::endl
+                  << "Kernel" << std::string(14,' ')
+                  << "  median[ms]    mean[ms]  stddev[ms]"
+                  << "     min[ms]       ops/sec" << std::endl
+                  << std::string(78,'-') << std::endl;
+        for (std::list<Measurement>::const_iterator m = measurements.begin();
+             m != measurements.end(); ++m) {
+            if (m->kind != "kernel")
+                continue;
+            std::cout << m->name
+                      << std::string(20-std::min<QuantLib::Size>(
+                                                 m->name.length(),20),' ')
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << 1000.0*m->median
+                      << std::setw(12) << 1000.0*m->mean
+                      << std::setw(12) << 1000.0*m->standardDeviation
+                      << std::setw(12) << 1000.0*m->min
+                      << std::setprecision(0)
+                      << std::setw(14) << m->throughput << std::endl;
+        }
+        std::cout << std::string(78,'-') << std::endl;
+    }
+
+    void writeJson() {
+        if (options.jsonFile.empty())
+            return;
+        std::ofstream out(options.jsonFile.c_str());
+        if (!out) {
+            BOOST_ERROR("cannot open " << options.jsonFile);
+            return;
+        }
+        out << "{" << std::endl
+            << "  \"suite\": \"QuantLib " << QL_VERSION << "\"," << std::endl
+            << "  \"results\": [" << std::endl;
+        out << std::setprecision(9);
+        for (std::list<Measurement>::const_iterator m = measurements.begin();
+             m != measurements.end(); ++m) {
+            if (m != measurements.begin())
+                out << "," << std::endl;
+            out << "    { \"name\": \"" << m->name << "\", "
+                << "\"kind\": \"" << m->kind << "\", "
+                << "\"runs\": " << m->runs << ", "
+                << "\"mean\": " << m->mean << ", "
+                << "\"stddev\": " << m->standardDeviation << ", "
+                << "\"min\": " << m->min << ", "
+                << "\"median\": " << m->median << ", "
+                << "\"max\": " << m->max << ", "
+                << "\"throughput\": " << m->throughput << " }";
+        }
+        out << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+    // reads the median times from a file written by writeJson()
+    std::map<std::string, double> readBaseline(const std::string& file) {
+        std::map<std::string, double> medians;
+        std::ifstream in(file.c_str());
+        if (!in) {
+            BOOST_ERROR("cannot open " << file);
+            return medians;
+        }
+        const std::string nameTag = "\"name\": \"";
+        const std::string medianTag = "\"median\": ";
+        std::string line;
+        while (std::getline(in, line)) {
+            std::string::size_type n = line.find(nameTag);
+            std::string::size_type m = line.find(medianTag);
+            if (n == std::string::npos || m == std::string::npos)
+                continue;
+            n += nameTag.length();
+            std::string name = line.substr(n, line.find('"', n)-n);
+            std::istringstream value(line.substr(m + medianTag.length()));
+            double median;
+            if (value >> median)
+                medians[name] = median;
+        }
+        return medians;
+    }
+
+    void compareWithBaseline() {
+        if (options.baselineFile.empty())
+            return;
+        std::map<std::string, double> baseline =
+            readBaseline(options.baselineFile);
+
+        std::cout << std::endl
+                  << "Comparison with " << options.baselineFile
+                  << " (tolerance " << std::fixed << std::setprecision(1)
+                  << 100.0*options.tolerance << "%)" << std::endl;
+        for (std::list<Measurement>::const_iterator m = measurements.begin();
+             m != measurements.end(); ++m) {
+            std::map<std::string, double>::const_iterator b =
+                baseline.find(m->name);
+            if (b == baseline.end() || b->second <= 0.0) {
+                std::cout << m->name << ": not in baseline" << std::endl;
+                continue;
+            }
+            double change = m->median/b->second - 1.0;
+            std::cout << m->name
+                      << std::string(42-std::min<QuantLib::Size>(
+                                                  m->name.length(),42),' ')
+                      << ":" << std::showpos << std::setw(7)
+                      << std::setprecision(1) << 100.0*change << "%"
+                      << std::noshowpos << std::endl;
+            // test cases are timed in a single run, which is too
+            // noisy to be checked against the tolerance
+            if (m->kind == "kernel" && change > options.tolerance)
+                BOOST_ERROR(m->name << " slower than baseline: "
+                            << std::setprecision(3) << 1000.0*m->median
+                            << " ms vs " << 1000.0*b->second << " ms");
+        }
+    }
+
     void printResults() {
         std::string header = "Benchmark Suite "
         #ifdef BOOST_MSVC
@@ -194,6 +441,12 @@ namespace {
         std::cout << std::string(56,'-')
                   << std::endl << std::endl;
 
+        collectTestCaseTimes();
+        printKernelResults();
+        if (runTimes.empty())
+            return;
+        std::cout << std::endl;
+
         double sum=0;
         std::list<double>::const_iterator iterT = runTimes.begin();
         std::list<Benchmark>::const_iterator iterBM = bm.begin();
@@ -226,6 +479,9 @@ namespace QuantLib {
 
 test_suite* init_unit_test_suite(int, char*[]) {
 
+    parseOptions(framework::master_test_suite().argc,
+                 framework::master_test_suite().argv);
+
     bm.push_back(Benchmark("AmericanOption::FdAmericanGreeks",
         &AmericanOptionTest::testFdAmericanGreeks, 518.31));
     bm.push_back(Benchmark("AmericanOption::FdShoutGreeks",
@@ -272,6 +528,14 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.push_back(Benchmark("MarketModelSmmTest::testMultiSmmSwaptions",
         &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions,
         11244.95));
+    // operation count of the native algorithms (builds without
+    // --enable-lapack): two Jacobi eigendecompositions of the 100x100
+    // matrix, each making 6243930 element-pair updates of 8 flops
+    // (counted), 99.90; two 130x70 SVDs at 14mn^2+8n^3, 23.32; matrix
+    // products and checks, 21.71; inverse (8/3 n^3) and two Cholesky
+    // decompositions (n^3/3), 3.33.
+    bm.push_back(Benchmark("Matrices::LargeMatrices",
+        &MatricesTest::testLargeMatrices, 148.26));
     bm.push_back(Benchmark("QuantoOption::ForwardGreeks",
         &QuantoOptionTest::testForwardGreeks, 90.98));
     bm.push_back(Benchmark("RandomNumber::MersenneTwisterDescrepancy",
@@ -283,6 +547,9 @@ test_suite* init_unit_test_suite(int, char*[]) {
 
     test_suite* test = BOOST_TEST_SUITE("QuantLib benchmark suite");
 
+    if (options.kernelsOnly)
+        bm.clear();
+
     for (std::list<Benchmark>::const_iterator iter = bm.begin();
          iter != bm.end(); ++iter) {
         test->add(QUANTLIB_TEST_CASE(startTimer));
@@ -290,7 +557,10 @@ test_suite* init_unit_test_suite(int, char*[]) {
         test->add(QUANTLIB_TEST_CASE(stopTimer));
     }
 
+    test->add(QUANTLIB_TEST_CASE(runKernels));
     test->add(QUANTLIB_TEST_CASE(printResults));
+    test->add(QUANTLIB_TEST_CASE(writeJson));
+    test->add(QUANTLIB_TEST_CASE(compareWithBaseline));
 
     return test;
 }
@@ -43,6 +43,15 @@ namespace {
     Real mul(Real x, Real y) { return x*y; }
     Real sub(Real x, Real y) { return x-y; }
 
+    class Counter : public Observer {
+      public:
+        Counter() : n_(0) {}
+        void update() { ++n_; }
+        Size count() const { return n_; }
+      private:
+        Size n_;
+    };
+
 }
 
 
@@ -81,6 +90,71 @@ void QuoteTest::testObservableHandle() {
 
 }
 
+void QuoteTest::testDeferredNotification() {
+
+    BOOST_MESSAGE("Testing deferred notification of quote changes...");
+
+    const Size n = 500;
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes(n);
+    std::vector<Handle<Quote> > handles(n);
+    Counter direct, indirect;
+    for (Size i=0; i<n; ++i) {
+        quotes[i] = boost::shared_ptr<SimpleQuote>(new SimpleQuote(1.0));
+        handles[i] = Handle<Quote>(quotes[i]);
+        direct.registerWith(quotes[i]);
+        indirect.registerWith(handles[i]);
+    }
+
+    {
+        ObservableBatchUpdate batch;
+        for (Size i=0; i<n; ++i)
+            quotes[i]->setValue(2.0);
+        if (direct.count() != 0 || indirect.count() != 0)
+            BOOST_FAIL("observers notified while updates were deferred");
+        if (ObservableSettings::instance().deferredObservers() == 0)
+            BOOST_FAIL("no deferred observers collected");
+
+        {
+            // nested batches do not flush
+            ObservableBatchUpdate inner;
+            quotes[0]->setValue(3.0);
+        }
+        if (direct.count() != 0)
+            BOOST_FAIL("notifications flushed by nested batch");
+        batch.commit();
+    }
+
+    if (direct.count() != 1)
+        BOOST_FAIL("direct observer notified " << direct.count()
+                   << " times\n    expected once");
+    if (indirect.count() != 1)
+        BOOST_FAIL("indirect observer notified " << indirect.count()
+                   << " times\n    expected once");
+    if (!ObservableSettings::instance().updatesEnabled())
+        BOOST_FAIL("updates not re-enabled after batch");
+
+    // observers going out of scope are no longer notified
+    {
+        ObservableBatchUpdate batch;
+        {
+            Counter transient;
+            transient.registerWith(quotes[0]);
+            quotes[0]->setValue(4.0);
+        }
+        quotes[1]->setValue(4.0);
+    }
+    if (direct.count() != 2)
+        BOOST_FAIL("direct observer notified " << direct.count()
+                   << " times\n    expected twice");
+
+    // disabled updates are dropped
+    ObservableSettings::instance().disableUpdates();
+    quotes[0]->setValue(5.0);
+    ObservableSettings::instance().enableUpdates();
+    if (direct.count() != 2)
+        BOOST_FAIL("observer notified while updates were disabled");
+}
+
 void QuoteTest::testDerived() {
 
     BOOST_MESSAGE("Testing derived quotes...");
@@ -200,6 +274,7 @@ test_suite* QuoteTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Quote tests");
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservable));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservableHandle));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testDeferredNotification));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testDerived));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testComposite));
     suite->add(QUANTLIB_TEST_CASE(
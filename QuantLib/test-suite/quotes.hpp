@@ -29,6 +29,7 @@ class QuoteTest {
   public:
     static void testObservable();
     static void testObservableHandle();
+    static void testDeferredNotification();
     static void testDerived();
     static void testComposite();
     static void testForwardValueQuoteAndImpliedStdevQuote();
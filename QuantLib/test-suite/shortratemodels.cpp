@@ -239,6 +239,110 @@ void ShortRateModelTest::testSwaps() {
     }
 }
 
+void ShortRateModelTest::testParallelCalibration() {
+    BOOST_MESSAGE("Testing parallel Hull-White calibration...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        swaptions.push_back(boost::shared_ptr<CalibrationHelper>(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure)));
+    }
+
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+    Real tolerance = 1.0e-6;
+
+    // serial calibration
+    boost::shared_ptr<HullWhite> serialModel(new HullWhite(termStructure));
+    boost::shared_ptr<PricingEngine> engine(
+                                   new JamshidianSwaptionEngine(serialModel));
+    for (Size i=0; i<swaptions.size(); i++)
+        swaptions[i]->setPricingEngine(engine);
+    LevenbergMarquardt serialMethod;
+    serialModel->calibrate(swaptions, serialMethod, endCriteria);
+    Array expected = serialModel->params();
+
+    if (serialModel->functionEvaluation() <= 0)
+        BOOST_ERROR("no cost function evaluations reported");
+    if (serialModel->calibrationTime() < 0.0)
+        BOOST_ERROR("negative calibration time reported: "
+                    << serialModel->calibrationTime());
+
+    // parallel calibration with one engine per helper
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+    model->enableParallelCalibration();
+    for (Size i=0; i<swaptions.size(); i++)
+        swaptions[i]->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                        new JamshidianSwaptionEngine(model)));
+    LevenbergMarquardt method;
+    model->calibrate(swaptions, method, endCriteria);
+    Array calculated = model->params();
+
+    if (std::fabs(calculated[0]-expected[0]) > tolerance
+        || std::fabs(calculated[1]-expected[1]) > tolerance)
+        BOOST_ERROR("Failed to reproduce serial calibration results:\n"
+                    << "    serial:   a = " << expected[0] << ", "
+                    << "sigma = " << expected[1] << "\n"
+                    << "    parallel: a = " << calculated[0] << ", "
+                    << "sigma = " << calculated[1]);
+    if (model->functionEvaluation() != serialModel->functionEvaluation())
+        BOOST_ERROR("mismatch in the number of cost function evaluations:\n"
+                    << "    serial:   "
+                    << serialModel->functionEvaluation() << "\n"
+                    << "    parallel: " << model->functionEvaluation());
+
+    // calibration using the jacobian of the cost function
+    model->disableParallelCalibration();
+    model->setParams(serialModel->params()*1.5);
+    LevenbergMarquardt jacobianMethod(1.0e-8, 1.0e-8, 1.0e-8, true);
+    model->calibrate(swaptions, jacobianMethod, endCriteria);
+    calculated = model->params();
+
+    if (std::fabs(calculated[0]-expected[0]) > tolerance
+        || std::fabs(calculated[1]-expected[1]) > tolerance)
+        BOOST_ERROR("Failed to reproduce serial calibration results "
+                    "with the cost function jacobian:\n"
+                    << "    expected:   a = " << expected[0] << ", "
+                    << "sigma = " << expected[1] << "\n"
+                    << "    calculated: a = " << calculated[0] << ", "
+                    << "sigma = " << calculated[1]);
+    if (model->gradientEvaluation() <= 0)
+        BOOST_ERROR("no jacobian evaluations reported");
+
+    // a parallel calibration can't share engines between helpers
+    for (Size i=0; i<swaptions.size(); i++)
+        swaptions[i]->setPricingEngine(engine);
+    serialModel->enableParallelCalibration();
+    bool failed = false;
+    try {
+        serialModel->calibrate(swaptions, method, endCriteria);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_ERROR("parallel calibration with shared engines not rejected");
+}
+
 void ShortRateModelTest::testFuturesConvexityBias() {
     BOOST_MESSAGE("Testing Hull-White futures convexity bias...");
 
@@ -272,6 +376,8 @@ test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &ShortRateModelTest::testParallelCalibration));
     suite->add(QUANTLIB_TEST_CASE(
                               &ShortRateModelTest::testFuturesConvexityBias));
     return suite;
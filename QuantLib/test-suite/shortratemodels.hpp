@@ -30,6 +30,7 @@ class ShortRateModelTest {
     static void testFuturesConvexityBias();
     static void testCachedHullWhite();
     static void testSwaps();
+    static void testParallelCalibration();
     static boost::unit_test_framework::test_suite* suite();
 };
 
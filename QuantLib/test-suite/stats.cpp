@@ -26,6 +26,9 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -119,6 +122,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingStatistics>(std::string("StreamingStatistics"));
 }
 
 
@@ -322,12 +326,104 @@ void StatisticsTest::testConvergenceStatistics() {
 }
 
 
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_MESSAGE("Testing streaming statistics...");
+
+    const Size N = 100000, parts = 4, compression = 200;
+    InverseCumulativeNormal inverseCum(1.0, 2.0);
+    SobolRsg rng(1);
+
+    std::vector<Real> data(N);
+    Statistics exact;
+    StreamingStatistics streaming(compression);
+    std::vector<StreamingStatistics> partial(parts,
+                                             StreamingStatistics(compression));
+    for (Size i=0; i<N; ++i) {
+        data[i] = inverseCum(rng.nextSequence().value[0]);
+        exact.add(data[i]);
+        streaming.add(data[i]);
+        partial[i % parts].add(data[i]);
+    }
+    StreamingStatistics merged(compression);
+    for (Size j=0; j<parts; ++j)
+        merged.merge(partial[j]);
+    std::sort(data.begin(), data.end());
+
+    const StreamingStatistics* stats[] = { &streaming, &merged };
+    std::string names[] = { "streaming", "merged" };
+    for (Size k=0; k<LENGTH(stats); ++k) {
+        const StreamingStatistics& s = *stats[k];
+
+        if (s.samples() != N)
+            BOOST_ERROR(names[k] << ": wrong number of samples"
+                        << "\n    calculated: " << s.samples()
+                        << "\n    expected:   " << N);
+
+        // moments are exact
+        Real tolerance = 1.0e-9;
+        Real calculated[] = { s.mean(), s.variance(),
+                              s.skewness(), s.kurtosis() };
+        Real expected[] = { exact.mean(), exact.variance(),
+                            exact.skewness(), exact.kurtosis() };
+        std::string moments[] = { "mean", "variance",
+                                  "skewness", "kurtosis" };
+        for (Size i=0; i<LENGTH(moments); ++i) {
+            if (std::fabs(calculated[i]-expected[i]) > tolerance)
+                BOOST_ERROR(names[k] << ": wrong " << moments[i]
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]);
+        }
+
+        // memory is bounded
+        if (s.centroids() > compression)
+            BOOST_ERROR(names[k] << ": too many centroids"
+                        << "\n    calculated: " << s.centroids()
+                        << "\n    compression: " << compression);
+
+        // percentiles are within the documented bounds
+        Real percentiles[] = { 0.001, 0.01, 0.05, 0.25, 0.5,
+                               0.75, 0.95, 0.99, 0.999 };
+        for (Size i=0; i<LENGTH(percentiles); ++i) {
+            Real y = percentiles[i];
+            Real x = s.percentile(y);
+            Real rank = Real(std::lower_bound(data.begin(), data.end(), x)
+                             - data.begin())/N;
+            Real bound = M_PI*std::sqrt(y*(1.0-y))/compression;
+            if (std::fabs(rank-y) > bound)
+                BOOST_ERROR(names[k] << ": percentile out of bounds"
+                            << "\n    percentile:    " << y
+                            << "\n    value:         " << x
+                            << "\n    rank of value: " << rank
+                            << "\n    bound:         " << bound);
+        }
+    }
+
+    // risk measures
+    StreamingRiskStatistics risk;
+    for (Size i=0; i<N; ++i)
+        risk.add(data[N-i-1]);
+    Real calculated = risk.valueAtRisk(0.99),
+         expected = exact.valueAtRisk(0.99);
+    if (std::fabs(calculated-expected) > 1.0e-2*expected)
+        BOOST_ERROR("wrong value at risk"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    calculated = risk.expectedShortfall(0.99);
+    expected = exact.expectedShortfall(0.99);
+    if (std::fabs(calculated-expected) > 1.0e-2*expected)
+        BOOST_ERROR("wrong expected shortfall"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
     return suite;
 }
 
@@ -440,6 +440,108 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testSabrCalibrationReuse() {
+
+    BOOST_MESSAGE("Testing parallel, incremental and warm-started "
+                  "sabr calibration...");
+
+    CommonVars vars;
+
+    Size nodes = vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size();
+    std::vector<std::vector<Handle<Quote> > > parametersGuess(nodes);
+    for (Size i=0; i<nodes; i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    boost::shared_ptr<SwaptionVolCube1> cubes[3];
+    for (Size i=0; i<3; i++)
+        cubes[i] = boost::shared_ptr<SwaptionVolCube1>(new
+            SwaptionVolCube1(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             false));
+    boost::shared_ptr<SwaptionVolCube1> serial = cubes[0],
+                                        parallel = cubes[1],
+                                        warm = cubes[2];
+    parallel->enableParallelCalibration(2);
+    warm->enableWarmStart();
+
+    // the first spread of the first node moves by a fifth of a vol point
+    boost::shared_ptr<SimpleQuote> spread =
+        boost::dynamic_pointer_cast<SimpleQuote>(
+                               vars.cube.volSpreadsHandle[0][0].currentLink());
+    Real spreads[] = { spread->value(), spread->value() + 0.002 };
+
+    for (Size n=0; n<LENGTH(spreads); n++) {
+        spread->setValue(spreads[n]);
+
+        Matrix serialParameters = serial->sparseSabrParameters();
+        Matrix parallelParameters = parallel->sparseSabrParameters();
+        for (Size i=0; i<serialParameters.rows(); i++) {
+            for (Size j=0; j<serialParameters.columns(); j++) {
+                if (serialParameters[i][j] != parallelParameters[i][j])
+                    BOOST_ERROR("parallel calibration differs from "
+                                "serial one:"
+                                << "\n    entry:    (" << i << ", "
+                                << j << ")"
+                                << "\n    serial:   " << serialParameters[i][j]
+                                << "\n    parallel: "
+                                << parallelParameters[i][j]);
+            }
+        }
+
+        Size calibrated = (n == 0 ? nodes : 1);
+        Size warmStarted = (n == 0 ? 0 : 1);
+        for (Size i=0; i<3; i++) {
+            const SwaptionVolCube1::CalibrationDiagnostics& diagnostics =
+                cubes[i]->sparseCalibrationDiagnostics();
+            Size expectedWarmStarts = (cubes[i] == warm ? warmStarted : 0);
+            if (diagnostics.calibratedNodes != calibrated ||
+                diagnostics.skippedNodes != nodes-calibrated ||
+                diagnostics.warmStartedNodes != expectedWarmStarts)
+                BOOST_ERROR("unexpected calibration diagnostics for cube "
+                            << i << " after " << io::ordinal(n+1)
+                            << " calibration:"
+                            << "\n    calibrated nodes:    "
+                            << diagnostics.calibratedNodes
+                            << " (" << calibrated << " expected)"
+                            << "\n    skipped nodes:       "
+                            << diagnostics.skippedNodes
+                            << " (" << nodes-calibrated << " expected)"
+                            << "\n    warm-started nodes:  "
+                            << diagnostics.warmStartedNodes
+                            << " (" << expectedWarmStarts << " expected)");
+        }
+
+        // a warm start must reach an equivalent fit
+        Real coldError = serial->sparseCalibrationDiagnostics().maxRmsError;
+        Real warmError = warm->sparseCalibrationDiagnostics().maxRmsError;
+        Real tolerance = 1.0e-4;
+        if (std::fabs(warmError-coldError) > tolerance)
+            BOOST_ERROR("warm-started calibration fails to reproduce "
+                        "cold one:"
+                        << "\n    cold rms error: " << io::rate(coldError)
+                        << "\n    warm rms error: " << io::rate(warmError)
+                        << "\n    tolerance:      " << io::rate(tolerance));
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -456,6 +558,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                      &SwaptionVolatilityCubeTest::testSabrCalibrationReuse));
 
     return suite;
 }
@@ -25,14 +25,18 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/quotes/simplequote.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/currency.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/parallel.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -114,6 +118,64 @@ namespace {
         }
     };
 
+    void checkBulkQueries(const YieldTermStructure& curve,
+                          const std::string& tag) {
+        // unsorted times, including the reference time and times
+        // past the end of the curve
+        Time maxTime = curve.maxTime();
+        std::vector<Time> t1, t2;
+        for (Size i=0; i<=40; i++) {
+            t1.push_back(((i*7)%41)*1.2*maxTime/40);
+            t2.push_back(t1.back() + (i%5)*0.25);
+        }
+        Size n = t1.size();
+        std::vector<Real> calculated(n);
+
+        curve.discounts(&t1[0], &calculated[0], n, true);
+        for (Size i=0; i<n; i++) {
+            DiscountFactor expected = curve.discount(t1[i], true);
+            if (calculated[i] != expected)
+                BOOST_FAIL(tag << ": discount mismatch at t = " << t1[i]
+                           << std::setprecision(16)
+                           << "\n    bulk:   " << calculated[i]
+                           << "\n    single: " << expected);
+        }
+
+        curve.zeroRates(&t1[0], &calculated[0], n,
+                        Compounded, Semiannual, true);
+        for (Size i=0; i<n; i++) {
+            Rate expected = curve.zeroRate(t1[i], Compounded,
+                                           Semiannual, true);
+            if (calculated[i] != expected)
+                BOOST_FAIL(tag << ": zero rate mismatch at t = " << t1[i]
+                           << std::setprecision(16)
+                           << "\n    bulk:   " << calculated[i]
+                           << "\n    single: " << expected);
+        }
+
+        curve.forwardRates(&t1[0], &t2[0], &calculated[0], n,
+                           Continuous, NoFrequency, true);
+        for (Size i=0; i<n; i++) {
+            Rate expected = curve.forwardRate(t1[i], t2[i], Continuous,
+                                              NoFrequency, true);
+            if (calculated[i] != expected)
+                BOOST_FAIL(tag << ": forward rate mismatch between t = "
+                           << t1[i] << " and t = " << t2[i]
+                           << std::setprecision(16)
+                           << "\n    bulk:   " << calculated[i]
+                           << "\n    single: " << expected);
+        }
+
+        // without extrapolation, the range is checked
+        try {
+            curve.discounts(&t1[0], &calculated[0], n);
+        } catch (Error&) {
+            return;
+        }
+        BOOST_FAIL(tag << ": no error raised for times past the end "
+                   "of the curve");
+    }
+
 }
 
 
@@ -299,6 +361,156 @@ void TermStructureTest::testZSpreadedObs() {
 }
 
 
+void TermStructureTest::testBulkQueries() {
+
+    BOOST_MESSAGE("Testing bulk queries on term structures...");
+
+    CommonVars vars;
+
+    checkBulkQueries(*vars.termStructure, "piecewise discount curve");
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<Quote> rate(boost::shared_ptr<Quote>(new SimpleQuote(0.04)));
+    FlatForward flat(today, rate, Actual360(), Compounded, Quarterly);
+    // a flat curve has no end
+    Time t1[] = { 0.0, 3.0, 1.0, 0.5, 30.0 };
+    Time t2[] = { 0.5, 3.0, 2.0, 0.5, 31.0 };
+    Real calculated[LENGTH(t1)];
+    flat.discounts(t1, calculated, LENGTH(t1));
+    for (Size i=0; i<LENGTH(t1); i++) {
+        if (calculated[i] != flat.discount(t1[i]))
+            BOOST_FAIL("flat forward: discount mismatch at t = " << t1[i]);
+    }
+    flat.forwardRates(t1, t2, calculated, LENGTH(t1), Continuous);
+    for (Size i=0; i<LENGTH(t1); i++) {
+        if (calculated[i] != flat.forwardRate(t1[i], t2[i], Continuous))
+            BOOST_FAIL("flat forward: forward-rate mismatch at t = "
+                       << t1[i]);
+    }
+
+    std::vector<Date> dates;
+    std::vector<Rate> rates;
+    std::vector<DiscountFactor> discounts;
+    for (Size i=0; i<10; i++) {
+        dates.push_back(today + Period(i*3, Years));
+        rates.push_back(0.02 + 0.003*i);
+        discounts.push_back(std::exp(-0.03*i*3));
+    }
+    checkBulkQueries(ZeroCurve(dates, rates, Actual360()), "zero curve");
+    checkBulkQueries(DiscountCurve(dates, discounts, Actual360()),
+                     "discount curve");
+
+    Handle<YieldTermStructure> base(vars.termStructure);
+    Handle<Quote> spread(boost::shared_ptr<Quote>(new SimpleQuote(0.01)));
+    checkBulkQueries(ZeroSpreadedTermStructure(base, spread),
+                     "zero-spreaded curve");
+}
+
+
+void TermStructureTest::testThreadSessions() {
+
+    BOOST_MESSAGE("Testing term structures in different thread sessions...");
+
+    #if defined(QL_ENABLE_THREAD_SESSIONS)
+
+    SavedSettings backup;
+
+    Date today = Date(15, May, 2013);
+    Settings::instance().evaluationDate() = today;
+
+    Calendar calendar = TARGET();
+    Date date1 = today + 1*Weeks, date2 = today + 2*Weeks;
+
+    boost::shared_ptr<YieldTermStructure> curve1, curve2;
+    Flag flag1, flag2;
+    {
+        ThreadSession session(1);
+        Settings::instance().evaluationDate() = date1;
+        curve1 = boost::shared_ptr<YieldTermStructure>(
+                      new FlatForward(0, calendar, 0.03, Actual360()));
+        flag1.registerWith(curve1);
+    }
+    {
+        ThreadSession session(2);
+        Settings::instance().evaluationDate() = date2;
+        curve2 = boost::shared_ptr<YieldTermStructure>(
+                      new FlatForward(0, calendar, 0.03, Actual360()));
+        flag2.registerWith(curve2);
+    }
+
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_FAIL("evaluation date modified by other sessions:"
+                   << "\n    expected:   " << today
+                   << "\n    calculated: "
+                   << Settings::instance().evaluationDate());
+    if (curve1->referenceDate() != date1 ||
+        curve2->referenceDate() != date2)
+        BOOST_FAIL("reference dates not set in their own sessions:"
+                   << "\n    first:  " << curve1->referenceDate()
+                   << " instead of " << date1
+                   << "\n    second: " << curve2->referenceDate()
+                   << " instead of " << date2);
+
+    Settings::instance().evaluationDate() = today + 3*Weeks;
+    if (flag1.isUp() || flag2.isUp())
+        BOOST_FAIL("observers notified by another session");
+    {
+        ThreadSession session(2);
+        Settings::instance().evaluationDate() = date1;
+    }
+    if (flag1.isUp())
+        BOOST_ERROR("observer notified by another session");
+    if (!flag2.isUp())
+        BOOST_ERROR("observer not notified by its own session");
+    if (curve2->referenceDate() != date1)
+        BOOST_ERROR("reference date not updated:"
+                    << "\n    expected:   " << date1
+                    << "\n    calculated: " << curve2->referenceDate());
+
+    // a revaluation over a number of dates, run in parallel
+    Size n = 50;
+    std::vector<Real> expected(n), calculated(n);
+    Date maturity = today + 10*Years;
+    for (Size i=0; i<n; ++i) {
+        Settings::instance().evaluationDate() = today + Integer(i)*Days;
+        FlatForward curve(2, calendar, 0.03, Actual360());
+        expected[i] = curve.discount(maturity);
+    }
+
+    ParallelErrors errors;
+    long m = n;
+    #if defined(_OPENMP)
+    #pragma omp parallel for
+    #endif
+    for (long i=0; i<m; ++i) {
+        try {
+            #if defined(_OPENMP)
+            ThreadSession session(100 + omp_get_thread_num());
+            #else
+            ThreadSession session(100);
+            #endif
+            Settings::instance().evaluationDate() = today + Integer(i)*Days;
+            FlatForward curve(2, calendar, 0.03, Actual360());
+            calculated[i] = curve.discount(maturity);
+        } catch (std::exception& e) {
+            errors.record(e.what());
+        }
+    }
+    errors.rethrow();
+
+    for (Size i=0; i<n; ++i) {
+        if (calculated[i] != expected[i])
+            BOOST_ERROR("failed to reproduce discount at "
+                        << io::ordinal(i+1) << " evaluation date:"
+                        << std::setprecision(12)
+                        << "\n    session:  " << calculated[i]
+                        << "\n    expected: " << expected[i]);
+    }
+
+    #endif
+}
+
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -308,6 +520,10 @@ test_suite* TermStructureTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testFSpreadedObs));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreaded));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreadedObs));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBulkQueries));
+    #if defined(QL_ENABLE_THREAD_SESSIONS)
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testThreadSessions));
+    #endif
     return suite;
 }
 
@@ -34,6 +34,8 @@ class TermStructureTest {
     static void testFSpreadedObs();
     static void testZSpreaded();
     static void testZSpreadedObs();
+    static void testBulkQueries();
+    static void testThreadSessions();
     static boost::unit_test_framework::test_suite* suite();
 };
 